@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <limits.h>
 #include "bellman_ford.h"
+#include "memory_stats.h"
 
 /**
  * @brief Initializes the distance and predecessor arrays.
@@ -49,11 +50,12 @@ void relax(int u, int v, int weight, int* dist, int* pred) {
  * @param graph Pointer to the graph
  * @param src The source node
  * @param dest The destination node
+ * @return The distance from src to dest, or the negative cycle flag
  */
-void bellmanFord(Graph* graph, int src, int dest) {
+ShortestPathResult bellmanFord(Graph* graph, int src, int dest) {
     int numNodes = graph->numNodes;
-    int* dist = (int*) malloc(numNodes * sizeof(int));
-    int* pred = (int*) malloc(numNodes * sizeof(int));
+    int* dist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* pred = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
 
     initializeSingleSource(graph, src, dist, pred);
 
@@ -69,28 +71,20 @@ void bellmanFord(Graph* graph, int src, int dest) {
     }
 
     // Check for negative weight cycles
-    for (int u = 0; u < numNodes; u++) {
+    ShortestPathResult result = { src, dest, dist[dest], 0 };
+    for (int u = 0; u < numNodes && !result.negativeCycle; u++) {
         AdjNode* node = graph->adjLists[u];
         while (node) {
             if (dist[u] != INT_MAX && dist[u] + node->weight < dist[node->dest]) {
-                printf("Graph contains a negative weight cycle\n");
-                free(dist);
-                free(pred);
-                return;
+                result.negativeCycle = 1;
+                result.distance = INT_MAX;
+                break;
             }
             node = node->next;
         }
     }
 
-    // Print the shortest distance between the source and destination nodes
-    printf("Shortest distance from node %d to node %d: ", src, dest);
-    if (dist[dest] == INT_MAX) {
-        printf("Infinity (no path)\n");
-    } else {
-        printf("%d\n", dist[dest]);
-        printf("\n");
-    }
-
-    free(dist);
-    free(pred);
+    trackedFree(MEM_BUFFERS, dist);
+    trackedFree(MEM_BUFFERS, pred);
+    return result;
 }
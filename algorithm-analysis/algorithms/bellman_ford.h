@@ -10,6 +10,7 @@
 
 #include <stdio.h>
 #include "graph.h"
+#include "sssp_result.h"
 
 /**
  * @brief Executes the Bellman-Ford algorithm to find the shortest path
@@ -18,7 +19,8 @@
  * @param graph Pointer to the graph
  * @param src The source node
  * @param dest The destination node
+ * @return The distance from src to dest, or the negative cycle flag
  */
-void bellmanFord(Graph* graph, int src, int dest);
+ShortestPathResult bellmanFord(Graph* graph, int src, int dest);
 
 #endif /* bellman_ford_h */
@@ -9,6 +9,8 @@
 #include <stdlib.h>
 #include <limits.h>
 #include "bellman_ford_improved.h"
+#include "memory_stats.h"
+#include "operation_stats.h"
 
 /**
  * @brief Initializes the distance array.
@@ -34,65 +36,90 @@ void improvedInitializeSingleSource(Graph* graph, int src, int* dist) {
  * @param newDist Array to temporarily store the updated shortest distances
  */
 void improvedRelax(int u, int v, int weight, int* dist, int* newDist) {
+    COUNT_OPERATION(OP_RELAXATIONS);
     if (dist[u] != INT_MAX && dist[u] + weight < newDist[v]) {
+        COUNT_IMPROVEMENT(newDist[v]);
         newDist[v] = dist[u] + weight;
     }
 }
 
 /**
- * @brief Implements the Bellman-Ford algorithm to find the shortest path
- * from a source node to a destination node in a given graph.
+ * @brief Computes the shortest distances from a source node to every node
+ * with the Bellman-Ford algorithm.
  *
  * @param graph Pointer to the graph
  * @param src The source node
- * @param dest The destination node
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable)
+ * @return 1 if the graph contains a negative weight cycle reachable from src, 0 otherwise
  */
-void bellmanFordImproved(Graph* graph, int src, int dest) {
+int bellmanFordImprovedDistances(Graph* graph, int src, int* dist) {
     int numNodes = graph->numNodes;
-    int* dist = (int*) malloc(numNodes * sizeof(int));
-    int* newDist = (int*) malloc(numNodes * sizeof(int));
+    int* buffer = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* current = dist;
+    int* newDist = buffer;
 
-    improvedInitializeSingleSource(graph, src, dist);
+    improvedInitializeSingleSource(graph, src, current);
 
     // Relax all edges numNodes - 1 times
     for (int i = 1; i < numNodes; i++) {
         for (int j = 0; j < numNodes; j++) {
-            newDist[j] = dist[j];
+            newDist[j] = current[j];
         }
         for (int u = 0; u < numNodes; u++) {
             AdjNode* node = graph->adjLists[u];
             while (node) {
-                improvedRelax(u, node->dest, node->weight, dist, newDist);
+                improvedRelax(u, node->dest, node->weight, current, newDist);
                 node = node->next;
             }
         }
-        int* temp = dist;
-        dist = newDist;
+        END_ROUND(countChangedDistances(current, newDist, numNodes));
+        int* temp = current;
+        current = newDist;
         newDist = temp;
     }
 
     // Check for negative weight cycles
-    for (int u = 0; u < numNodes; u++) {
+    int negativeCycle = 0;
+    for (int u = 0; u < numNodes && !negativeCycle; u++) {
         AdjNode* node = graph->adjLists[u];
         while (node) {
-            if (dist[u] != INT_MAX && dist[u] + node->weight < dist[node->dest]) {
-                printf("Graph contains a negative weight cycle\n");
-                free(dist);
-                free(newDist);
-                return;
+            if (current[u] != INT_MAX && current[u] + node->weight < current[node->dest]) {
+                negativeCycle = 1;
+                break;
             }
             node = node->next;
         }
     }
 
-    // Print the shortest distance between the source and destination nodes
-    printf("Shortest distance from node %d to node %d: ", src, dest);
-    if (dist[dest] == INT_MAX) {
-        printf("Infinity (no path)\n");
-    } else {
-        printf("%d\n", dist[dest]);
+    // The final distances may have ended in the scratch buffer
+    if (current != dist) {
+        for (int j = 0; j < numNodes; j++) {
+            dist[j] = current[j];
+        }
+    }
+
+    trackedFree(MEM_BUFFERS, buffer);
+    return negativeCycle;
+}
+
+/**
+ * @brief Implements the Bellman-Ford algorithm to find the shortest path
+ * from a source node to a destination node in a given graph.
+ *
+ * @param graph Pointer to the graph
+ * @param src The source node
+ * @param dest The destination node
+ * @return The distance from src to dest, or the negative cycle flag
+ */
+ShortestPathResult bellmanFordImproved(Graph* graph, int src, int dest) {
+    int* dist = (int*) trackedMalloc(MEM_BUFFERS, graph->numNodes * sizeof(int));
+    ShortestPathResult result = { src, dest, INT_MAX, 0 };
+
+    result.negativeCycle = bellmanFordImprovedDistances(graph, src, dist);
+    if (!result.negativeCycle) {
+        result.distance = dist[dest];
     }
 
-    free(dist);
-    free(newDist);
+    trackedFree(MEM_BUFFERS, dist);
+    return result;
 }
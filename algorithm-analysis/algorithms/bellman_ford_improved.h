@@ -10,6 +10,7 @@
 
 #include <stdio.h>
 #include "graph.h"
+#include "sssp_result.h"
 
 /**
  * @brief Executes the Bellman-Ford algorithm to find the shortest path
@@ -19,7 +20,18 @@
  * @param graph Pointer to the graph
  * @param src The source node
  * @param dest The destination node
+ * @return The distance from src to dest, or the negative cycle flag
  */
-void bellmanFordImproved(Graph* graph, int src, int dest);
+ShortestPathResult bellmanFordImproved(Graph* graph, int src, int dest);
+
+/**
+ * @brief Computes the shortest distances from a source node to every node.
+ *
+ * @param graph Pointer to the graph
+ * @param src The source node
+ * @param dist Array of numNodes entries that receives the distances
+ * @return 1 if a negative weight cycle was found, 0 otherwise
+ */
+int bellmanFordImprovedDistances(Graph* graph, int src, int* dist);
 
 #endif /* bellman_ford_improved_h */
@@ -0,0 +1,121 @@
+//
+//  bellman_ford_sorted.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "bellman_ford_sorted.h"
+#include "memory_stats.h"
+#include "operation_stats.h"
+
+/**
+ * @brief Arcs grouped by destination: the arcs entering v are
+ * source[firstIn[v]] .. source[firstIn[v + 1] - 1], with their weights.
+ */
+typedef struct {
+    int* firstIn;
+    int* source;
+    int* weight;
+} IncomingArcs;
+
+static IncomingArcs incomingArcs(Graph* graph) {
+    int numNodes = graph->numNodes;
+    IncomingArcs arcs;
+    int numArcs = 0;
+    arcs.firstIn = (int*) trackedCalloc(MEM_BUFFERS, (size_t)numNodes + 1, sizeof(int));
+
+    for (int u = 0; u < numNodes; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            arcs.firstIn[node->dest + 1]++;
+            numArcs++;
+        }
+    }
+    for (int v = 0; v < numNodes; v++) {
+        arcs.firstIn[v + 1] += arcs.firstIn[v];
+    }
+
+    arcs.source = (int*) trackedMalloc(MEM_BUFFERS, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+    arcs.weight = (int*) trackedMalloc(MEM_BUFFERS, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+    int* fill = (int*) trackedMalloc(MEM_BUFFERS, (numNodes > 0 ? numNodes : 1) * sizeof(int));
+    memcpy(fill, arcs.firstIn, numNodes * sizeof(int));
+
+    // Sources come out in increasing order within each destination
+    for (int u = 0; u < numNodes; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int i = fill[node->dest]++;
+            arcs.source[i] = u;
+            arcs.weight[i] = node->weight;
+        }
+    }
+
+    trackedFree(MEM_BUFFERS, fill);
+    return arcs;
+}
+
+/**
+ * @brief Computes the best distance of v over its incoming arcs.
+ */
+static inline int relaxIncoming(const IncomingArcs* arcs, int v, const int* current) {
+    int best = current[v];
+    COUNT_OPERATIONS(OP_RELAXATIONS, arcs->firstIn[v + 1] - arcs->firstIn[v]);
+    for (int i = arcs->firstIn[v]; i < arcs->firstIn[v + 1]; i++) {
+        int du = current[arcs->source[i]];
+        if (du != INT_MAX && du + arcs->weight[i] < best) {
+            COUNT_IMPROVEMENT(best);
+            best = du + arcs->weight[i];
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Bellman-Ford with the arcs sorted by destination. It does the same
+ * numNodes - 1 rounds as bellmanFordImprovedDistances, but each round walks the
+ * arcs in destination order: every entry of newDist is written once, in
+ * sequence, and the arc arrays are read in sequence, leaving the reads of the
+ * source distances as the only random accesses.
+ */
+int bellmanFordSortedDistances(Graph* graph, int src, int* dist) {
+    int numNodes = graph->numNodes;
+    IncomingArcs arcs = incomingArcs(graph);
+    int* buffer = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* current = dist;
+    int* newDist = buffer;
+
+    for (int i = 0; i < numNodes; i++) {
+        current[i] = INT_MAX;
+    }
+    current[src] = 0;
+
+    for (int i = 1; i < numNodes; i++) {
+        for (int v = 0; v < numNodes; v++) {
+            newDist[v] = relaxIncoming(&arcs, v, current);
+        }
+        END_ROUND(countChangedDistances(current, newDist, numNodes));
+        int* temp = current;
+        current = newDist;
+        newDist = temp;
+    }
+
+    // Check for negative weight cycles
+    int negativeCycle = 0;
+    for (int v = 0; v < numNodes && !negativeCycle; v++) {
+        negativeCycle = relaxIncoming(&arcs, v, current) < current[v];
+    }
+
+    // The final distances may have ended in the scratch buffer
+    if (current != dist) {
+        memcpy(dist, current, numNodes * sizeof(int));
+    }
+
+    trackedFree(MEM_BUFFERS, buffer);
+    trackedFree(MEM_BUFFERS, arcs.firstIn);
+    trackedFree(MEM_BUFFERS, arcs.source);
+    trackedFree(MEM_BUFFERS, arcs.weight);
+    return negativeCycle;
+}
@@ -0,0 +1,25 @@
+//
+//  bellman_ford_sorted.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef bellman_ford_sorted_h
+#define bellman_ford_sorted_h
+
+#include <stdio.h>
+#include "graph.h"
+
+/**
+ * @brief Computes the shortest distances from a source node to every node
+ * with the Bellman-Ford algorithm, relaxing the arcs grouped by destination.
+ *
+ * @param graph Pointer to the graph
+ * @param src The source node
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable)
+ * @return 1 if the graph contains a negative weight cycle reachable from src, 0 otherwise
+ */
+int bellmanFordSortedDistances(Graph* graph, int src, int* dist);
+
+#endif /* bellman_ford_sorted_h */
@@ -0,0 +1,153 @@
+//
+//  certificate.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "certificate.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+
+/**
+ * @brief Checks in O(n + m) that a distance vector holds the shortest distances
+ * from src, without running a reference algorithm.
+ *
+ * The vector is correct if and only if dist[src] is 0, no edge can still be
+ * relaxed (triangle inequality) and every vertex with a finite distance is
+ * reached from src through tight edges (dist[u] + w == dist[v]). The last
+ * condition is checked with a search on the tight edges, instead of only
+ * asking for one tight incoming edge per vertex, so that a cycle of zero
+ * weight edges cannot support wrong distances.
+ *
+ * @param graph Pointer to the graph.
+ * @param src The source node.
+ * @param dist Distance vector to be checked (INT_MAX for unreachable vertices).
+ * @return A report with the problems found.
+ */
+CertificateReport checkShortestPathCertificate(Graph* graph, int src, const int* dist) {
+    int numNodes = graph->numNodes;
+    CertificateReport report = { 1, 0, 0, 0, -1 };
+
+    if (numNodes <= 0) {
+        return report;
+    }
+
+    if (dist[src] != 0) {
+        report.sourceError = 1;
+        report.firstBadVertex = src;
+    }
+
+    // Triangle inequality on every edge
+    for (int u = 0; u < numNodes; u++) {
+        if (dist[u] == INT_MAX) {
+            continue;
+        }
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            if ((long long)dist[u] + node->weight < dist[node->dest]) {
+                report.triangleViolations++;
+                if (report.firstBadVertex < 0) {
+                    report.firstBadVertex = node->dest;
+                }
+            }
+        }
+    }
+
+    // Search from src following tight edges only
+    bool* reached = (bool*) calloc(numNodes, sizeof(bool));
+    int* queue = (int*) malloc(numNodes * sizeof(int));
+    int head = 0, tail = 0;
+
+    if (dist[src] == 0) {
+        reached[src] = true;
+        queue[tail++] = src;
+    }
+    while (head < tail) {
+        int u = queue[head++];
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            if (!reached[v] && (long long)dist[u] + node->weight == dist[v]) {
+                reached[v] = true;
+                queue[tail++] = v;
+            }
+        }
+    }
+
+    for (int v = 0; v < numNodes; v++) {
+        if (dist[v] != INT_MAX && !reached[v]) {
+            report.unsupportedVertices++;
+            if (report.firstBadVertex < 0) {
+                report.firstBadVertex = v;
+            }
+        }
+    }
+
+    free(reached);
+    free(queue);
+
+    report.valid = !report.sourceError && report.triangleViolations == 0 && report.unsupportedVertices == 0;
+    return report;
+}
+
+/**
+ * @brief Compares two distance vectors.
+ *
+ * @param expected First distance vector.
+ * @param actual Second distance vector.
+ * @param numNodes Number of entries of the vectors.
+ * @param firstMismatch Output parameter with the first differing vertex (-1 if none).
+ * @return Number of vertices whose distances differ.
+ */
+int compareDistances(const int* expected, const int* actual, int numNodes, int* firstMismatch) {
+    int mismatches = 0;
+    *firstMismatch = -1;
+
+    for (int v = 0; v < numNodes; v++) {
+        if (expected[v] != actual[v]) {
+            if (mismatches == 0) {
+                *firstMismatch = v;
+            }
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Checks that a cycle is a negative cycle of the graph: every vertex is
+ * valid, consecutive vertices (and the last and the first) are joined by an
+ * arc, and the lightest such arcs add up to a negative weight.
+ *
+ * @param graph Pointer to the graph.
+ * @param cycle The cycle to be checked.
+ * @return 1 if the cycle is a negative cycle of the graph, 0 otherwise.
+ */
+int checkNegativeCycle(Graph* graph, const NegativeCycle* cycle) {
+    if (cycle->length < 1) {
+        return 0;
+    }
+
+    long long weight = 0;
+    for (int i = 0; i < cycle->length; i++) {
+        int u = cycle->vertices[i];
+        int v = cycle->vertices[(i + 1) % cycle->length];
+        if (u < 0 || u >= graph->numNodes || v < 0 || v >= graph->numNodes) {
+            return 0;
+        }
+
+        bool found = false;
+        int lightest = 0;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            if (node->dest == v && (!found || node->weight < lightest)) {
+                lightest = node->weight;
+                found = true;
+            }
+        }
+        if (!found) {
+            return 0;
+        }
+        weight += lightest;
+    }
+    return weight < 0;
+}
@@ -0,0 +1,30 @@
+//
+//  certificate.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef certificate_h
+#define certificate_h
+
+#include <stdio.h>
+#include "graph.h"
+#include "negative_cycle.h"
+
+/**
+ * @brief Outcome of checking a distance vector against the graph.
+ */
+typedef struct {
+    int valid;                  // 1 if the vector is a correct shortest distance vector
+    int sourceError;            // 1 if dist[src] is not 0
+    int triangleViolations;     // Edges (u, v) with dist[u] + w < dist[v]
+    int unsupportedVertices;    // Finite vertices not reached from src through tight edges
+    int firstBadVertex;         // A vertex where a problem was found (-1 if none)
+} CertificateReport;
+
+CertificateReport checkShortestPathCertificate(Graph* graph, int src, const int* dist);
+int compareDistances(const int* expected, const int* actual, int numNodes, int* firstMismatch);
+int checkNegativeCycle(Graph* graph, const NegativeCycle* cycle);
+
+#endif /* certificate_h */
@@ -0,0 +1,126 @@
+//
+//  compressed_sssp.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "compressed_sssp.h"
+#include <stdlib.h>
+#include <limits.h>
+#include "memory_stats.h"
+#include "priority_queue.h"
+#include "operation_stats.h"
+
+/**
+ * @brief Bellman-Ford over the compressed adjacency. The rounds are the same
+ * as in bellmanFordImprovedDistances, so both can be compared directly; only
+ * the way the arcs are read changes.
+ *
+ * @param graph Pointer to the compressed graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ * @return 1 if the graph contains a negative weight cycle reachable from src, 0 otherwise.
+ */
+int bellmanFordCompressedDistances(CompressedGraph* graph, int src, int* dist) {
+    int numNodes = graph->numNodes;
+    int* buffer = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* current = dist;
+    int* newDist = buffer;
+    ArcCursor cursor;
+    int v, weight;
+
+    for (int i = 0; i < numNodes; i++) {
+        current[i] = INT_MAX;
+    }
+    current[src] = 0;
+
+    // Relax all edges numNodes - 1 times
+    for (int i = 1; i < numNodes; i++) {
+        for (int j = 0; j < numNodes; j++) {
+            newDist[j] = current[j];
+        }
+        for (int u = 0; u < numNodes; u++) {
+            if (current[u] == INT_MAX)
+                continue;
+            openArcs(graph, u, &cursor);
+            while (nextArc(&cursor, &v, &weight)) {
+                COUNT_OPERATION(OP_RELAXATIONS);
+                if (current[u] + weight < newDist[v]) {
+                    COUNT_IMPROVEMENT(newDist[v]);
+                    newDist[v] = current[u] + weight;
+                }
+            }
+        }
+        END_ROUND(countChangedDistances(current, newDist, numNodes));
+        int* temp = current;
+        current = newDist;
+        newDist = temp;
+    }
+
+    // Check for negative weight cycles
+    int negativeCycle = 0;
+    for (int u = 0; u < numNodes && !negativeCycle; u++) {
+        if (current[u] == INT_MAX)
+            continue;
+        openArcs(graph, u, &cursor);
+        while (nextArc(&cursor, &v, &weight)) {
+            if (current[u] + weight < current[v]) {
+                negativeCycle = 1;
+                break;
+            }
+        }
+    }
+
+    // The final distances may have ended in the scratch buffer
+    if (current != dist) {
+        for (int j = 0; j < numNodes; j++) {
+            dist[j] = current[j];
+        }
+    }
+
+    trackedFree(MEM_BUFFERS, buffer);
+    return negativeCycle;
+}
+
+/**
+ * @brief Dijkstra's algorithm over the compressed adjacency, with the lazy
+ * binary heap. Edge weights must be non-negative.
+ *
+ * @param graph Pointer to the compressed graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ */
+void dijkstraCompressedDistances(CompressedGraph* graph, int src, int* dist) {
+    LazyQueue queue;
+    ArcCursor cursor;
+    int v, weight;
+
+    for (int i = 0; i < graph->numNodes; i++) {
+        dist[i] = INT_MAX;
+    }
+    dist[src] = 0;
+
+    initLazyQueue(&queue);
+    lazyQueuePush(&queue, src, 0);
+
+    while (!lazyQueueIsEmpty(&queue)) {
+        QueueEntry entry = lazyQueuePop(&queue);
+        int u = entry.vertex;
+        if (entry.key != dist[u])
+            continue;
+
+        openArcs(graph, u, &cursor);
+        while (nextArc(&cursor, &v, &weight)) {
+            COUNT_OPERATION(OP_RELAXATIONS);
+            if (dist[u] + weight < dist[v]) {
+                COUNT_IMPROVEMENT(dist[v]);
+                dist[v] = dist[u] + weight;
+                lazyQueuePush(&queue, v, dist[v]);
+            }
+        }
+        END_SETTLE();
+    }
+
+    freeLazyQueue(&queue);
+}
@@ -0,0 +1,17 @@
+//
+//  compressed_sssp.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef compressed_sssp_h
+#define compressed_sssp_h
+
+#include <stdio.h>
+#include "compressed_graph.h"
+
+int bellmanFordCompressedDistances(CompressedGraph* graph, int src, int* dist);
+void dijkstraCompressedDistances(CompressedGraph* graph, int src, int* dist);
+
+#endif /* compressed_sssp_h */
@@ -0,0 +1,271 @@
+//
+//  dense_sssp.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "dense_sssp.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "memory_stats.h"
+#include "operation_stats.h"
+
+// Rows are processed DENSE_LANES cells at a time with the GCC/Clang vector
+// extensions. 16-byte vectors are the width every x86-64 (SSE2) and arm64
+// (NEON) processor has, so no target flags are needed. Other compilers only
+// use the scalar loops.
+#if defined(__GNUC__) || defined(__clang__)
+#define DENSE_VECTORS
+#define DENSE_LANES 4
+
+typedef int IntLanes __attribute__((vector_size(DENSE_LANES * sizeof(int))));
+typedef unsigned int UintLanes __attribute__((vector_size(DENSE_LANES * sizeof(int))));
+
+static inline IntLanes loadLanes(const int* p) {
+    IntLanes lanes;
+    memcpy(&lanes, p, sizeof(lanes));
+    return lanes;
+}
+
+static inline void storeLanes(int* p, IntLanes lanes) {
+    memcpy(p, &lanes, sizeof(lanes));
+}
+
+static inline IntLanes broadcastLanes(int value) {
+    IntLanes lanes = { 0 };
+    return lanes + value;
+}
+
+static inline IntLanes selectLanes(IntLanes mask, IntLanes a, IntLanes b) {
+    return (a & mask) | (b & ~mask);
+}
+
+/**
+ * @brief du + w for a block of cells, or INT_MAX where w is DENSE_NO_ARC or
+ * the sum would overflow (see overflowLimit).
+ */
+static inline IntLanes candidateLanes(IntLanes weights, int du, int limit) {
+    IntLanes over = weights > limit;
+    IntLanes sum = (IntLanes)((UintLanes)weights + (unsigned)du);
+    return selectLanes(over, broadcastLanes(INT_MAX), sum);
+}
+
+#if OPERATION_COUNTERS_ENABLED
+// The lanes that improved count as the improvements of the list versions
+static inline void countImprovedLanes(IntLanes better, IntLanes current) {
+    for (int i = 0; i < DENSE_LANES; i++) {
+        if (better[i])
+            COUNT_IMPROVEMENT(current[i]);
+    }
+}
+#define COUNT_IMPROVED_LANES(better, current) countImprovedLanes(better, current)
+#else
+#define COUNT_IMPROVED_LANES(better, current) ((void)0)
+#endif
+#endif
+
+/**
+ * @brief Largest weight w for which du + w is computed; heavier cells, which
+ * include DENSE_NO_ARC, give INT_MAX. For du = 0, DENSE_NO_ARC itself is
+ * allowed, since 0 + INT_MAX is INT_MAX.
+ */
+static inline int overflowLimit(int du) {
+    return du >= 0 ? INT_MAX - du : INT_MAX - 1;
+}
+
+static inline int candidate(int weight, int du, int limit) {
+    return weight > limit ? INT_MAX : (int)((unsigned)weight + (unsigned)du);
+}
+
+#if OPERATION_COUNTERS_ENABLED
+/**
+ * @brief Number of arcs in a row, which are the relaxations of the row in the
+ * list versions. Only used by builds with operation counters.
+ */
+static int rowArcs(const int* row, int numNodes) {
+    int arcs = 0;
+    for (int v = 0; v < numNodes; v++) {
+        arcs += row[v] != DENSE_NO_ARC;
+    }
+    return arcs;
+}
+#endif
+
+/**
+ * @brief Returns the open node with the smallest distance, or -1 if every
+ * open node is unreachable. A vectorized minimum over the row of distances
+ * is followed by a scan for its first position.
+ *
+ * @param open -1 for open nodes, 0 for settled ones.
+ */
+static int closestOpenNode(const int* dist, const int* open, int numNodes) {
+    int best = INT_MAX;
+    int v = 0;
+
+#ifdef DENSE_VECTORS
+    IntLanes infinity = broadcastLanes(INT_MAX);
+    IntLanes lanes = infinity;
+    for (; v + DENSE_LANES <= numNodes; v += DENSE_LANES) {
+        IntLanes keys = selectLanes(loadLanes(open + v), loadLanes(dist + v), infinity);
+        lanes = selectLanes(keys < lanes, keys, lanes);
+    }
+    for (int i = 0; i < DENSE_LANES; i++) {
+        best = lanes[i] < best ? lanes[i] : best;
+    }
+#endif
+    for (; v < numNodes; v++) {
+        if (open[v] && dist[v] < best)
+            best = dist[v];
+    }
+
+    if (best == INT_MAX)
+        return -1;
+    for (v = 0; v < numNodes; v++) {
+        if (open[v] && dist[v] == best)
+            return v;
+    }
+    return -1;
+}
+
+/**
+ * @brief Dijkstra's algorithm (v1) on the weight matrix: an O(n^2) selection
+ * of the closest open node, then one pass over its row that lowers the
+ * distance of every open node in the same vector operations.
+ *
+ * @param graph Pointer to the dense graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ */
+void dijkstraDenseDistances(DenseGraph* graph, int src, int* dist) {
+    int numNodes = graph->numNodes;
+    int* open = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+
+    for (int v = 0; v < numNodes; v++) {
+        dist[v] = INT_MAX;
+        open[v] = -1;
+    }
+    dist[src] = 0;
+
+    // The last open node relaxes nothing, so it is not selected (as in dijkstraV1)
+    for (int count = 0; count < numNodes - 1; count++) {
+        int u = closestOpenNode(dist, open, numNodes);
+        COUNT_OPERATION(OP_EXTRACT_MINS);
+        if (u < 0)
+            break;
+        open[u] = 0;
+
+        const int* row = graph->weights + (size_t)u * numNodes;
+#if OPERATION_COUNTERS_ENABLED
+        COUNT_OPERATIONS(OP_RELAXATIONS, rowArcs(row, numNodes));
+#endif
+        int du = dist[u], limit = overflowLimit(du);
+        int v = 0;
+#ifdef DENSE_VECTORS
+        for (; v + DENSE_LANES <= numNodes; v += DENSE_LANES) {
+            IntLanes current = loadLanes(dist + v);
+            IntLanes candidates = candidateLanes(loadLanes(row + v), du, limit);
+            IntLanes better = (candidates < current) & loadLanes(open + v);
+            COUNT_IMPROVED_LANES(better, current);
+            storeLanes(dist + v, selectLanes(better, candidates, current));
+        }
+#endif
+        for (; v < numNodes; v++) {
+            int c = candidate(row[v], du, limit);
+            if (open[v] && c < dist[v]) {
+                COUNT_IMPROVEMENT(dist[v]);
+                dist[v] = c;
+            }
+        }
+        END_SETTLE();
+    }
+
+    trackedFree(MEM_BUFFERS, open);
+}
+
+/**
+ * @brief Relaxes the row of node u into next: next[v] = min(next[v], du + w(u, v)).
+ *
+ * @return 1 if some distance was lowered, 0 otherwise.
+ */
+static int relaxRow(const int* row, int du, int* next, int numNodes) {
+    int limit = overflowLimit(du);
+    int changed = 0;
+    int v = 0;
+
+#ifdef DENSE_VECTORS
+    IntLanes changedLanes = broadcastLanes(0);
+    for (; v + DENSE_LANES <= numNodes; v += DENSE_LANES) {
+        IntLanes current = loadLanes(next + v);
+        IntLanes candidates = candidateLanes(loadLanes(row + v), du, limit);
+        IntLanes better = candidates < current;
+        COUNT_IMPROVED_LANES(better, current);
+        storeLanes(next + v, selectLanes(better, candidates, current));
+        changedLanes |= better;
+    }
+    for (int i = 0; i < DENSE_LANES; i++) {
+        changed |= changedLanes[i] != 0;
+    }
+#endif
+    for (; v < numNodes; v++) {
+        int c = candidate(row[v], du, limit);
+        if (c < next[v]) {
+            COUNT_IMPROVEMENT(next[v]);
+            next[v] = c;
+            changed = 1;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief Bellman-Ford on the weight matrix. Every round is a min-plus product
+ * of the distance vector with the matrix, computed row by row from the
+ * distances of the previous round, as bellmanFordImprovedDistances does on the
+ * lists. Like it, the run always does n - 1 rounds and then a check round, so
+ * that bf does the same work on either representation.
+ *
+ * @param graph Pointer to the dense graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ * @return 1 if the graph contains a negative weight cycle reachable from src, 0 otherwise.
+ */
+int bellmanFordDenseDistances(DenseGraph* graph, int src, int* dist) {
+    int numNodes = graph->numNodes;
+    int* buffer = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* current = dist;
+    int* next = buffer;
+
+    for (int v = 0; v < numNodes; v++) {
+        dist[v] = INT_MAX;
+    }
+    dist[src] = 0;
+
+    for (int i = 1; i < numNodes; i++) {
+        memcpy(next, current, numNodes * sizeof(int));
+        // Every arc is examined once per round, as on the lists
+        COUNT_OPERATIONS(OP_RELAXATIONS, graph->numEdges);
+        for (int u = 0; u < numNodes; u++) {
+            if (current[u] != INT_MAX)
+                relaxRow(graph->weights + (size_t)u * numNodes, current[u], next, numNodes);
+        }
+        END_ROUND(countChangedDistances(current, next, numNodes));
+        int* temp = current;
+        current = next;
+        next = temp;
+    }
+
+    // Check for negative weight cycles: a further round would still lower a distance
+    int negativeCycle = 0;
+    memcpy(next, current, numNodes * sizeof(int));
+    for (int u = 0; u < numNodes && !negativeCycle; u++) {
+        if (current[u] != INT_MAX)
+            negativeCycle = relaxRow(graph->weights + (size_t)u * numNodes, current[u], next, numNodes);
+    }
+
+    if (current != dist)
+        memcpy(dist, current, numNodes * sizeof(int));
+    trackedFree(MEM_BUFFERS, buffer);
+    return negativeCycle;
+}
@@ -0,0 +1,17 @@
+//
+//  dense_sssp.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef dense_sssp_h
+#define dense_sssp_h
+
+#include <stdio.h>
+#include "dense_graph.h"
+
+int bellmanFordDenseDistances(DenseGraph* graph, int src, int* dist);
+void dijkstraDenseDistances(DenseGraph* graph, int src, int* dist);
+
+#endif /* dense_sssp_h */
@@ -9,6 +9,8 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <limits.h>
+#include "memory_stats.h"
+#include "operation_stats.h"
 
 /**
  * @brief Find the vertex with the minimum distance value, from the set of vertices
@@ -34,16 +36,16 @@ int minDistance(int dist[], bool shortestPathTreeSet[], int numNodes) {
 }
 
 /**
- * @brief Implements Dijkstra's algorithm (v1) to find shortest paths from a source vertex src to all
- * other vertices in the graph represented by 'graph'.
+ * @brief Computes the shortest distances from a source vertex to all other vertices
+ * with Dijkstra's algorithm (v1).
  *
  * @param graph Pointer to the graph structure.
  * @param src Source vertex from which shortest paths are to be calculated.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
  */
-void dijkstraV1(Graph* graph, int src) {
+void dijkstraV1Distances(Graph* graph, int src, int* dist) {
     int numNodes = graph->numNodes;
-    int dist[numNodes];
-    bool shortestPathTreeSet[numNodes];
+    bool* shortestPathTreeSet = (bool*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(bool));
 
     // Initialize all distances as INFINITE and shortestPathTreeSet[] as false
     for (int i = 0; i < numNodes; i++) {
@@ -58,6 +60,7 @@ void dijkstraV1(Graph* graph, int src) {
     for (int count = 0; count < numNodes - 1; count++) {
         // Pick the minimum distance vertex from the set of vertices not yet processed
         int u = minDistance(dist, shortestPathTreeSet, numNodes);
+        COUNT_OPERATION(OP_EXTRACT_MINS);
 
         // Mark the picked vertex as processed
         shortestPathTreeSet[u] = true;
@@ -66,22 +69,44 @@ void dijkstraV1(Graph* graph, int src) {
         AdjNode* adjNode = graph->adjLists[u];
         while (adjNode != NULL) {
             int v = adjNode->dest;
+            AdjNode* next = adjNode->next;
+            if (next != NULL) {
+                PREFETCH(next->next);
+                PREFETCH(&dist[next->dest]);
+            }
 
             // Update dist[v] only if it's not in shortestPathTreeSet, there is an edge
             // from u to v, and total weight of path from src to v through u is smaller
+            COUNT_OPERATION(OP_RELAXATIONS);
             if (!shortestPathTreeSet[v] && dist[u] != INT_MAX && dist[u] + adjNode->weight < dist[v]) {
+                COUNT_IMPROVEMENT(dist[v]);
                 dist[v] = dist[u] + adjNode->weight;
             }
-            adjNode = adjNode->next;
+            adjNode = next;
         }
+        END_SETTLE();
     }
-    
-    // Print the result: distance from the source node (0) to the last node
-    int last_node_index = numNodes - 1;
-    printf("Distance from the source node 0 to the last node %d: ", last_node_index);
-    if (dist[last_node_index] == INT_MAX) {
-        printf("INFINITE\n");
-    } else {
-        printf("%d\n", dist[last_node_index]);
-    }
+
+    trackedFree(MEM_BUFFERS, shortestPathTreeSet);
+}
+
+/**
+ * @brief Implements Dijkstra's algorithm (v1) to find shortest paths from a source vertex src to all
+ * other vertices in the graph represented by 'graph'.
+ *
+ * @param graph Pointer to the graph structure.
+ * @param src Source vertex from which shortest paths are to be calculated.
+ * @return The distance from src to the last node.
+ */
+ShortestPathResult dijkstraV1(Graph* graph, int src) {
+    int numNodes = graph->numNodes;
+    int* dist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+
+    dijkstraV1Distances(graph, src, dist);
+
+    // Result: distance from the source node to the last node
+    ShortestPathResult result = { src, numNodes - 1, dist[numNodes - 1], 0 };
+
+    trackedFree(MEM_BUFFERS, dist);
+    return result;
 }
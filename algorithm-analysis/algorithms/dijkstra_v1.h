@@ -10,7 +10,9 @@
 
 #include <stdio.h>
 #include "graph.h"
+#include "sssp_result.h"
 
-void dijkstraV1(Graph* graph, int src);
+ShortestPathResult dijkstraV1(Graph* graph, int src);
+void dijkstraV1Distances(Graph* graph, int src, int* dist);
 
 #endif /* dijkstra_v1_h */
@@ -9,6 +9,8 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <limits.h>
+#include "memory_stats.h"
+#include "operation_stats.h"
 
 /**
  * @brief Structure to represent a node in the priority queue (min-heap).
@@ -46,11 +48,11 @@ void freeMinHeap(MinHeap* minHeap);
  * @return Pointer to the created MinHeap structure.
  */
 MinHeap* createMinHeap(int capacity) {
-    MinHeap* minHeap = (MinHeap*) malloc(sizeof(MinHeap));
-    minHeap->pos = (int*) malloc(capacity * sizeof(int));
+    MinHeap* minHeap = (MinHeap*) trackedMalloc(MEM_HEAP, sizeof(MinHeap));
+    minHeap->pos = (int*) trackedMalloc(MEM_HEAP, capacity * sizeof(int));
     minHeap->size = 0;
     minHeap->capacity = capacity;
-    minHeap->array = (HeapNode**) malloc(capacity * sizeof(HeapNode*));
+    minHeap->array = (HeapNode**) trackedMalloc(MEM_HEAP, capacity * sizeof(HeapNode*));
     return minHeap;
 }
 
@@ -62,7 +64,7 @@ MinHeap* createMinHeap(int capacity) {
  * @return Pointer to the created HeapNode structure.
  */
 HeapNode* createHeapNode(int vertex, int key) {
-    HeapNode* heapNode = (HeapNode*) malloc(sizeof(HeapNode));
+    HeapNode* heapNode = (HeapNode*) trackedMalloc(MEM_HEAP, sizeof(HeapNode));
     heapNode->vertex = vertex;
     heapNode->key = key;
     return heapNode;
@@ -100,6 +102,8 @@ void minHeapify(MinHeap* minHeap, int idx) {
         smallest = right;
 
     if (smallest != idx) {
+        COUNT_OPERATION(OP_SIFT_STEPS);
+
         // Swap nodes in the heap
         HeapNode* smallestNode = minHeap->array[smallest];
         HeapNode* idxNode = minHeap->array[idx];
@@ -124,6 +128,7 @@ void minHeapify(MinHeap* minHeap, int idx) {
 HeapNode* extractMin(MinHeap* minHeap) {
     if (isEmpty(minHeap))
         return NULL;
+    COUNT_OPERATION(OP_EXTRACT_MINS);
 
     // Store the root node and remove it from the heap
     HeapNode* root = minHeap->array[0];
@@ -151,6 +156,7 @@ HeapNode* extractMin(MinHeap* minHeap) {
 void decreaseKey(MinHeap* minHeap, int v, int key) {
     // Get the index of v in the heap array
     int idx = minHeap->pos[v];
+    COUNT_OPERATION(OP_DECREASE_KEYS);
 
     // Get the node and update its key
     minHeap->array[idx]->key = key;
@@ -158,6 +164,7 @@ void decreaseKey(MinHeap* minHeap, int v, int key) {
     // Adjust the heap as necessary
     while (idx && minHeap->array[idx]->key < minHeap->array[(idx - 1) / 2]->key) {
         // Swap with the parent
+        COUNT_OPERATION(OP_SIFT_STEPS);
         minHeap->pos[minHeap->array[idx]->vertex] = (idx - 1) / 2;
         minHeap->pos[minHeap->array[(idx - 1) / 2]->vertex] = idx;
         swapHeapNodes(&minHeap->array[idx], &minHeap->array[(idx - 1) / 2]);
@@ -197,23 +204,24 @@ bool isEmpty(MinHeap* minHeap) {
  */
 void freeMinHeap(MinHeap* minHeap) {
     for (int i = 0; i < minHeap->size; ++i) { // Using minHeap->size instead of minHeap->capacity
-        free(minHeap->array[i]);
+        trackedFree(MEM_HEAP, minHeap->array[i]);
     }
-    free(minHeap->array);
-    free(minHeap->pos);
-    free(minHeap);
+    trackedFree(MEM_HEAP, minHeap->array);
+    trackedFree(MEM_HEAP, minHeap->pos);
+    trackedFree(MEM_HEAP, minHeap);
 }
 
 /**
- * @brief Implements Dijkstra's algorithm v2 for finding shortest paths from a source vertex.
+ * @brief Computes the shortest distances from a source vertex to all other vertices
+ * with Dijkstra's algorithm v2 (binary heap).
  *
  * @param graph Pointer to the graph structure representing the graph.
  * @param src Source vertex from which shortest paths are computed.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
  */
-void dijkstraV2(Graph* graph, int src) {
+void dijkstraV2Distances(Graph* graph, int src, int* dist) {
     int numNodes = graph->numNodes;
-    int dist[numNodes];
-    bool shortestPathTreeSet[numNodes];
+    bool* shortestPathTreeSet = (bool*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(bool));
 
     // Initialize distances as INFINITE and shortestPathTreeSet[] as false
     for (int i = 0; i < numNodes; i++) {
@@ -231,37 +239,63 @@ void dijkstraV2(Graph* graph, int src) {
         minHeap->pos[v] = v;
     }
     minHeap->size = numNodes;
+    COUNT_OPERATIONS(OP_HEAP_INSERTS, numNodes);
+
+    // Move the source to the top of the heap
+    decreaseKey(minHeap, src, dist[src]);
 
     // Process Dijkstra's algorithm
     while (!isEmpty(minHeap)) {
         HeapNode* heapNode = extractMin(minHeap);
         int u = heapNode->vertex;
+        trackedFree(MEM_HEAP, heapNode);
 
         shortestPathTreeSet[u] = true;
 
         AdjNode* adjNode = graph->adjLists[u];
         while (adjNode != NULL) {
             int v = adjNode->dest;
+            AdjNode* next = adjNode->next;
+            if (next != NULL) {
+                PREFETCH(next->next);
+                PREFETCH(&dist[next->dest]);
+                PREFETCH(&minHeap->pos[next->dest]);
+            }
 
+            COUNT_OPERATION(OP_RELAXATIONS);
             if (!shortestPathTreeSet[v] && dist[u] != INT_MAX &&
                 dist[u] + adjNode->weight < dist[v]) {
+                COUNT_IMPROVEMENT(dist[v]);
                 dist[v] = dist[u] + adjNode->weight;
 
                 // Update the key in the heap
                 decreaseKey(minHeap, v, dist[v]);
             }
-            adjNode = adjNode->next;
+            adjNode = next;
         }
-    }
-    
-    // Print the result: distance from source node (0) to last node
-    int last_node_index = numNodes - 1;
-    printf("Distance from source node 0 to last node %d: ", last_node_index);
-    if (dist[last_node_index] == INT_MAX) {
-        printf("INFINITE\n");
-    } else {
-        printf("%d\n", dist[last_node_index]);
+        END_SETTLE();
     }
 
     freeMinHeap(minHeap);
+    trackedFree(MEM_BUFFERS, shortestPathTreeSet);
+}
+
+/**
+ * @brief Implements Dijkstra's algorithm v2 for finding shortest paths from a source vertex.
+ *
+ * @param graph Pointer to the graph structure representing the graph.
+ * @param src Source vertex from which shortest paths are computed.
+ * @return The distance from src to the last node.
+ */
+ShortestPathResult dijkstraV2(Graph* graph, int src) {
+    int numNodes = graph->numNodes;
+    int* dist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+
+    dijkstraV2Distances(graph, src, dist);
+
+    // Result: distance from the source node to the last node
+    ShortestPathResult result = { src, numNodes - 1, dist[numNodes - 1], 0 };
+
+    trackedFree(MEM_BUFFERS, dist);
+    return result;
 }
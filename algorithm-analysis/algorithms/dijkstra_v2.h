@@ -10,7 +10,9 @@
 
 #include <stdio.h>
 #include "graph.h"
+#include "sssp_result.h"
 
-void dijkstraV2(Graph* graph, int src);
+ShortestPathResult dijkstraV2(Graph* graph, int src);
+void dijkstraV2Distances(Graph* graph, int src, int* dist);
 
 #endif /* dijkstra_v2_h */
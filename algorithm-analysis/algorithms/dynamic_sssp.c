@@ -0,0 +1,298 @@
+//
+//  dynamic_sssp.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "dynamic_sssp.h"
+#include <stdlib.h>
+#include <limits.h>
+#include "memory_stats.h"
+#include "priority_queue.h"
+
+#define UNTOUCHED 0
+#define CANDIDATE 1
+#define AFFECTED 2
+
+/**
+ * @brief Computes the initial shortest path tree with Dijkstra's algorithm.
+ *
+ * @param dsssp Pointer to the dynamic structure with dist and pred allocated.
+ * @param queue Queue used for the computation (left empty).
+ */
+static void computeFromScratch(DynamicSSSP* dsssp, LazyQueue* queue) {
+    Graph* graph = dsssp->graph;
+
+    for (int i = 0; i < graph->numNodes; i++) {
+        dsssp->dist[i] = INT_MAX;
+        dsssp->pred[i] = -1;
+    }
+    dsssp->dist[dsssp->src] = 0;
+    lazyQueuePush(queue, dsssp->src, 0);
+
+    while (!lazyQueueIsEmpty(queue)) {
+        QueueEntry entry = lazyQueuePop(queue);
+        int u = entry.vertex;
+        if (entry.key != dsssp->dist[u])
+            continue;
+
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            if (dsssp->dist[u] + node->weight < dsssp->dist[node->dest]) {
+                dsssp->dist[node->dest] = dsssp->dist[u] + node->weight;
+                dsssp->pred[node->dest] = u;
+                lazyQueuePush(queue, node->dest, dsssp->dist[node->dest]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Creates the dynamic structure and computes the shortest paths from src.
+ *
+ * @param graph Pointer to the graph. It is modified by applyEdgeUpdates.
+ * @param src The source node.
+ * @return Pointer to the created DynamicSSSP structure.
+ */
+DynamicSSSP* createDynamicSSSP(Graph* graph, int src) {
+    int numNodes = graph->numNodes;
+    DynamicSSSP* dsssp = (DynamicSSSP*) trackedMalloc(MEM_BUFFERS, sizeof(DynamicSSSP));
+    dsssp->graph = graph;
+    dsssp->src = src;
+    dsssp->dist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    dsssp->pred = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    dsssp->state = (int*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(int));
+    dsssp->inLists = (AdjNode**) trackedCalloc(MEM_GRAPH, numNodes, sizeof(AdjNode*));
+
+    // Build the reverse adjacency lists, needed to find alternative parents
+    for (int u = 0; u < numNodes; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            AdjNode* reverse = createNode(u, node->weight);
+            reverse->next = dsssp->inLists[node->dest];
+            dsssp->inLists[node->dest] = reverse;
+        }
+    }
+
+    LazyQueue queue;
+    initLazyQueue(&queue);
+    computeFromScratch(dsssp, &queue);
+    freeLazyQueue(&queue);
+
+    return dsssp;
+}
+
+/**
+ * @brief Finds the reverse entry of the edge src -> dest with the given weight.
+ *
+ * @param dsssp Pointer to the dynamic structure.
+ * @param src The source node of the edge.
+ * @param dest The destination node of the edge.
+ * @param weight The weight of the edge, to tell parallel edges apart.
+ * @return Pointer to the link that holds the reverse entry, or NULL if there is none.
+ */
+static AdjNode** findInLink(DynamicSSSP* dsssp, int src, int dest, int weight) {
+    AdjNode** link = &dsssp->inLists[dest];
+    while (*link != NULL && ((*link)->dest != src || (*link)->weight != weight)) {
+        link = &(*link)->next;
+    }
+    return *link != NULL ? link : NULL;
+}
+
+/**
+ * @brief Applies a batch of edge updates and repairs the shortest paths.
+ *
+ * The repair follows Ramalingam and Reps: the first phase finds the vertices
+ * whose shortest path got longer (those that lost every tight incoming edge),
+ * in increasing order of their old distance. The second phase runs Dijkstra's
+ * algorithm seeded only with those vertices and with the heads of edges that
+ * got cheaper, so vertices that are not affected are never touched.
+ *
+ * @param dsssp Pointer to the dynamic structure.
+ * @param updates Array of edge updates.
+ * @param numUpdates Number of updates in the array.
+ * @return Number of vertices settled again during the repair.
+ */
+int applyEdgeUpdates(DynamicSSSP* dsssp, const EdgeUpdate* updates, int numUpdates) {
+    Graph* graph = dsssp->graph;
+    int* dist = dsssp->dist;
+    int* pred = dsssp->pred;
+    int* state = dsssp->state;
+    LazyQueue queue;
+    initLazyQueue(&queue);
+
+    int affectedCapacity = 64, numAffected = 0;
+    int* affected = (int*) trackedMalloc(MEM_BUFFERS, affectedCapacity * sizeof(int));
+
+    // Apply the updates to the graph and queue the heads of broken tree edges
+    for (int i = 0; i < numUpdates; i++) {
+        const EdgeUpdate* update = &updates[i];
+        int u = update->src, v = update->dest;
+        int gotWorse = 0;
+
+        if (update->type == EDGE_INSERT) {
+            addEdge(graph, u, v, update->weight);
+            AdjNode* reverse = createNode(u, update->weight);
+            reverse->next = dsssp->inLists[v];
+            dsssp->inLists[v] = reverse;
+        } else if (update->type == EDGE_DELETE) {
+            AdjNode* node = findEdge(graph, u, v);
+            if (node == NULL)
+                continue;
+            AdjNode** link = findInLink(dsssp, u, v, node->weight);
+            removeEdge(graph, u, v);
+            AdjNode* removed = *link;
+            *link = removed->next;
+            trackedFree(MEM_GRAPH, removed);
+            gotWorse = 1;
+        } else {
+            AdjNode* node = findEdge(graph, u, v);
+            if (node == NULL)
+                continue;
+            AdjNode** link = findInLink(dsssp, u, v, node->weight);
+            gotWorse = update->weight > node->weight;
+            node->weight = update->weight;
+            (*link)->weight = update->weight;
+        }
+
+        if (gotWorse && pred[v] == u && state[v] == UNTOUCHED) {
+            state[v] = CANDIDATE;
+            lazyQueuePush(&queue, v, dist[v]);
+        }
+    }
+
+    // Phase 1: find affected vertices, in increasing order of old distance
+    while (!lazyQueueIsEmpty(&queue)) {
+        int v = lazyQueuePop(&queue).vertex;
+        if (state[v] != CANDIDATE)
+            continue;
+
+        // A vertex keeps its distance if another tight edge from an unaffected
+        // vertex still reaches it. Zero-weight edges are not trusted, since
+        // their tail may be a descendant of v that was not examined yet.
+        int rescued = 0;
+        for (AdjNode* in = dsssp->inLists[v]; in != NULL; in = in->next) {
+            int x = in->dest;
+            if (state[x] != AFFECTED && in->weight > 0 && dist[x] != INT_MAX &&
+                dist[x] + in->weight == dist[v]) {
+                pred[v] = x;
+                rescued = 1;
+                break;
+            }
+        }
+        if (rescued) {
+            state[v] = UNTOUCHED;
+            continue;
+        }
+
+        state[v] = AFFECTED;
+        if (numAffected == affectedCapacity) {
+            affectedCapacity *= 2;
+            affected = (int*) trackedRealloc(MEM_BUFFERS, affected, affectedCapacity * sizeof(int));
+        }
+        affected[numAffected++] = v;
+
+        // Children in the shortest path tree become candidates
+        for (AdjNode* node = graph->adjLists[v]; node != NULL; node = node->next) {
+            int c = node->dest;
+            if (pred[c] == v && state[c] == UNTOUCHED) {
+                state[c] = CANDIDATE;
+                lazyQueuePush(&queue, c, dist[c]);
+            }
+        }
+    }
+
+    for (int i = 0; i < numAffected; i++) {
+        dist[affected[i]] = INT_MAX;
+        pred[affected[i]] = -1;
+    }
+
+    // Phase 2: seed affected vertices from their unaffected in-neighbours
+    for (int i = 0; i < numAffected; i++) {
+        int v = affected[i];
+        for (AdjNode* in = dsssp->inLists[v]; in != NULL; in = in->next) {
+            int x = in->dest;
+            if (state[x] != AFFECTED && dist[x] != INT_MAX && dist[x] + in->weight < dist[v]) {
+                dist[v] = dist[x] + in->weight;
+                pred[v] = x;
+            }
+        }
+        if (dist[v] != INT_MAX)
+            lazyQueuePush(&queue, v, dist[v]);
+    }
+
+    // Edges that got cheaper (or were inserted) may shorten paths directly
+    for (int i = 0; i < numUpdates; i++) {
+        const EdgeUpdate* update = &updates[i];
+        if (update->type == EDGE_DELETE)
+            continue;
+        int u = update->src, v = update->dest;
+        if (dist[u] == INT_MAX)
+            continue;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            if (node->dest == v && dist[u] + node->weight < dist[v]) {
+                dist[v] = dist[u] + node->weight;
+                pred[v] = u;
+                lazyQueuePush(&queue, v, dist[v]);
+            }
+        }
+    }
+
+    for (int i = 0; i < numAffected; i++) {
+        state[affected[i]] = UNTOUCHED;
+    }
+
+    int settled = 0;
+    while (!lazyQueueIsEmpty(&queue)) {
+        QueueEntry entry = lazyQueuePop(&queue);
+        int u = entry.vertex;
+        if (entry.key != dist[u])
+            continue;
+        settled++;
+
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            if (dist[u] + node->weight < dist[node->dest]) {
+                dist[node->dest] = dist[u] + node->weight;
+                pred[node->dest] = u;
+                lazyQueuePush(&queue, node->dest, dist[node->dest]);
+            }
+        }
+    }
+
+    trackedFree(MEM_BUFFERS, affected);
+    freeLazyQueue(&queue);
+
+    return settled;
+}
+
+/**
+ * @brief Returns the current shortest distance from the source to a vertex.
+ *
+ * @param dsssp Pointer to the dynamic structure.
+ * @param v Vertex number.
+ * @return The distance, or INT_MAX if v is unreachable.
+ */
+int dynamicDistance(DynamicSSSP* dsssp, int v) {
+    return dsssp->dist[v];
+}
+
+/**
+ * @brief Frees the memory allocated for the dynamic structure. The graph is
+ * not freed.
+ *
+ * @param dsssp Pointer to the dynamic structure.
+ */
+void freeDynamicSSSP(DynamicSSSP* dsssp) {
+    for (int i = 0; i < dsssp->graph->numNodes; i++) {
+        AdjNode* node = dsssp->inLists[i];
+        while (node != NULL) {
+            AdjNode* temp = node;
+            node = node->next;
+            trackedFree(MEM_GRAPH, temp);
+        }
+    }
+    trackedFree(MEM_GRAPH, dsssp->inLists);
+    trackedFree(MEM_BUFFERS, dsssp->dist);
+    trackedFree(MEM_BUFFERS, dsssp->pred);
+    trackedFree(MEM_BUFFERS, dsssp->state);
+    trackedFree(MEM_BUFFERS, dsssp);
+}
@@ -0,0 +1,54 @@
+//
+//  dynamic_sssp.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef dynamic_sssp_h
+#define dynamic_sssp_h
+
+#include <stdio.h>
+#include "graph.h"
+
+/**
+ * @brief Kind of change applied to an edge of the graph.
+ */
+typedef enum {
+    EDGE_INSERT,        // Adds a new edge src -> dest with the given weight
+    EDGE_DELETE,        // Removes the edge src -> dest (weight is ignored)
+    EDGE_UPDATE_WEIGHT  // Changes the weight of the edge src -> dest
+} EdgeUpdateType;
+
+/**
+ * @brief A single edge update of a batch.
+ */
+typedef struct {
+    EdgeUpdateType type;
+    int src;
+    int dest;
+    int weight;
+} EdgeUpdate;
+
+/**
+ * @brief Single-source shortest paths that are kept up to date while the
+ * graph changes.
+ *
+ * The structure does not own the graph, but it modifies it when update
+ * batches are applied. Edge weights must be non-negative.
+ */
+typedef struct {
+    Graph* graph;           // Graph being tracked (owned by the caller)
+    AdjNode** inLists;      // Reverse adjacency lists (dest holds the source node)
+    int src;                // Source node
+    int* dist;              // Shortest distance from src (INT_MAX if unreachable)
+    int* pred;              // Predecessor in the shortest path tree (-1 for none)
+    int* state;             // Scratch marks used while applying a batch
+} DynamicSSSP;
+
+DynamicSSSP* createDynamicSSSP(Graph* graph, int src);
+int applyEdgeUpdates(DynamicSSSP* dsssp, const EdgeUpdate* updates, int numUpdates);
+int dynamicDistance(DynamicSSSP* dsssp, int v);
+void freeDynamicSSSP(DynamicSSSP* dsssp);
+
+#endif /* dynamic_sssp_h */
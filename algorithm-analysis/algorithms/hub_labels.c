@@ -0,0 +1,420 @@
+//
+//  hub_labels.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "hub_labels.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include "constants.h"
+#include "memory_stats.h"
+#include "priority_queue.h"
+
+/**
+ * @brief Label of one node while the labels are being built.
+ */
+typedef struct {
+    LabelEntry* entries;
+    int size;
+    int capacity;
+} LabelList;
+
+/**
+ * @brief Arcs in compressed sparse row form, used for the reverse graph.
+ */
+typedef struct {
+    int* offsets;
+    int* dest;
+    int* weight;
+} ArcArray;
+
+static void appendLabel(LabelList* list, int hub, int dist) {
+    if (list->size == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 4;
+        list->entries = (LabelEntry*) trackedRealloc(MEM_BUFFERS, list->entries, list->capacity * sizeof(LabelEntry));
+    }
+    list->entries[list->size++] = (LabelEntry) { hub, dist };
+}
+
+static ArcArray reverseArcs(Graph* graph) {
+    int numNodes = graph->numNodes;
+    ArcArray reverse;
+    reverse.offsets = (int*) trackedCalloc(MEM_BUFFERS, (size_t)numNodes + 1, sizeof(int));
+    reverse.dest = (int*) trackedMalloc(MEM_BUFFERS, (graph->numEdges > 0 ? graph->numEdges : 1) * sizeof(int));
+    reverse.weight = (int*) trackedMalloc(MEM_BUFFERS, (graph->numEdges > 0 ? graph->numEdges : 1) * sizeof(int));
+
+    for (int u = 0; u < numNodes; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            reverse.offsets[node->dest + 1]++;
+        }
+    }
+    for (int u = 0; u < numNodes; u++) {
+        reverse.offsets[u + 1] += reverse.offsets[u];
+    }
+
+    int* fill = (int*) trackedMalloc(MEM_BUFFERS, (numNodes > 0 ? numNodes : 1) * sizeof(int));
+    memcpy(fill, reverse.offsets, numNodes * sizeof(int));
+    for (int u = 0; u < numNodes; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int i = fill[node->dest]++;
+            reverse.dest[i] = u;
+            reverse.weight[i] = node->weight;
+        }
+    }
+    trackedFree(MEM_BUFFERS, fill);
+    return reverse;
+}
+
+/**
+ * @brief Orders the nodes by decreasing degree (in plus out arcs), ties by
+ * node number, with a counting sort. High-degree nodes cover many shortest
+ * paths, so labeling them first prunes the later searches the most.
+ */
+static int* degreeOrder(Graph* graph, const ArcArray* reverse) {
+    int numNodes = graph->numNodes;
+    int* degree = (int*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(int));
+    int* order = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int maxDegree = 0;
+
+    for (int u = 0; u < numNodes; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            degree[u]++;
+        }
+        degree[u] += reverse->offsets[u + 1] - reverse->offsets[u];
+        maxDegree = degree[u] > maxDegree ? degree[u] : maxDegree;
+    }
+
+    // start[d] is the first position of the nodes with degree d
+    int* start = (int*) trackedCalloc(MEM_BUFFERS, (size_t)maxDegree + 2, sizeof(int));
+    for (int u = 0; u < numNodes; u++) {
+        start[maxDegree - degree[u] + 1]++;
+    }
+    for (int d = 0; d <= maxDegree; d++) {
+        start[d + 1] += start[d];
+    }
+    for (int u = 0; u < numNodes; u++) {
+        order[start[maxDegree - degree[u]]++] = u;
+    }
+
+    trackedFree(MEM_BUFFERS, start);
+    trackedFree(MEM_BUFFERS, degree);
+    return order;
+}
+
+/**
+ * @brief One pruned Dijkstra run of the labeling. From the root, nodes are
+ * visited in order of distance; a node whose distance is already covered by
+ * the existing labels is not labeled and not expanded.
+ *
+ * @param rank Rank of the root, which becomes the hub of the new entries.
+ * @param rootLabel Label of the root on the opposite side (out-label for a forward run).
+ * @param labels Labels that receive the new entries (in-labels for a forward run).
+ * @param forward true to follow the arcs of the graph, false to follow them reversed.
+ */
+static void prunedSearch(Graph* graph, const ArcArray* reverse, int root, int rank,
+                         const LabelList* rootLabel, LabelList* labels, bool forward,
+                         int* dist, int* hubDist, int* touched, LazyQueue* queue) {
+    int numTouched = 0;
+
+    // Distances from the root to its own hubs, for the pruning test
+    for (int i = 0; i < rootLabel->size; i++) {
+        hubDist[rootLabel->entries[i].hub] = rootLabel->entries[i].dist;
+    }
+
+    dist[root] = 0;
+    touched[numTouched++] = root;
+    lazyQueuePush(queue, root, 0);
+
+    while (!lazyQueueIsEmpty(queue)) {
+        QueueEntry entry = lazyQueuePop(queue);
+        int u = entry.vertex;
+        if (entry.key != dist[u])
+            continue;
+
+        int covered = 0;
+        const LabelList* label = &labels[u];
+        for (int i = 0; i < label->size && !covered; i++) {
+            int h = hubDist[label->entries[i].hub];
+            covered = h != INT_MAX && (long long)h + label->entries[i].dist <= dist[u];
+        }
+        if (covered)
+            continue;
+        appendLabel(&labels[u], rank, dist[u]);
+
+        if (forward) {
+            for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+                int v = node->dest;
+                if (dist[u] + node->weight < dist[v]) {
+                    if (dist[v] == INT_MAX)
+                        touched[numTouched++] = v;
+                    dist[v] = dist[u] + node->weight;
+                    lazyQueuePush(queue, v, dist[v]);
+                }
+            }
+        } else {
+            for (int i = reverse->offsets[u]; i < reverse->offsets[u + 1]; i++) {
+                int v = reverse->dest[i];
+                if (dist[u] + reverse->weight[i] < dist[v]) {
+                    if (dist[v] == INT_MAX)
+                        touched[numTouched++] = v;
+                    dist[v] = dist[u] + reverse->weight[i];
+                    lazyQueuePush(queue, v, dist[v]);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < numTouched; i++) {
+        dist[touched[i]] = INT_MAX;
+    }
+    for (int i = 0; i < rootLabel->size; i++) {
+        hubDist[rootLabel->entries[i].hub] = INT_MAX;
+    }
+}
+
+static void flattenLabels(LabelList* lists, int numNodes, long long** offsets, LabelEntry** entries) {
+    long long total = 0;
+    for (int u = 0; u < numNodes; u++) {
+        total += lists[u].size;
+    }
+
+    *offsets = (long long*) trackedMalloc(MEM_GRAPH, ((size_t)numNodes + 1) * sizeof(long long));
+    *entries = (LabelEntry*) trackedMalloc(MEM_GRAPH, (total > 0 ? total : 1) * sizeof(LabelEntry));
+
+    long long position = 0;
+    for (int u = 0; u < numNodes; u++) {
+        (*offsets)[u] = position;
+        memcpy(*entries + position, lists[u].entries, lists[u].size * sizeof(LabelEntry));
+        position += lists[u].size;
+        trackedFree(MEM_BUFFERS, lists[u].entries);
+    }
+    (*offsets)[numNodes] = position;
+}
+
+/**
+ * @brief Builds 2-hop labels with pruned landmark labeling (Akiba, Iwata and
+ * Yoshida). Nodes are processed by decreasing degree; each one runs a pruned
+ * Dijkstra forward (filling in-labels) and one backward (filling out-labels).
+ * Edge weights must be non-negative.
+ *
+ * @param graph Pointer to the graph.
+ * @return Pointer to the labels.
+ */
+HubLabels* buildHubLabels(Graph* graph) {
+    int numNodes = graph->numNodes;
+    ArcArray reverse = reverseArcs(graph);
+    int* order = degreeOrder(graph, &reverse);
+    LabelList* outLists = (LabelList*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(LabelList));
+    LabelList* inLists = (LabelList*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(LabelList));
+    int* dist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* hubDist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* touched = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    LazyQueue queue;
+    initLazyQueue(&queue);
+
+    for (int i = 0; i < numNodes; i++) {
+        dist[i] = INT_MAX;
+        hubDist[i] = INT_MAX;
+    }
+
+    for (int rank = 0; rank < numNodes; rank++) {
+        int root = order[rank];
+        prunedSearch(graph, &reverse, root, rank, &outLists[root], inLists, true, dist, hubDist, touched, &queue);
+        prunedSearch(graph, &reverse, root, rank, &inLists[root], outLists, false, dist, hubDist, touched, &queue);
+    }
+
+    HubLabels* labels = (HubLabels*) trackedMalloc(MEM_GRAPH, sizeof(HubLabels));
+    labels->numNodes = numNodes;
+    labels->fingerprint = graphFingerprint(graph);
+    flattenLabels(outLists, numNodes, &labels->outOffsets, &labels->outLabels);
+    flattenLabels(inLists, numNodes, &labels->inOffsets, &labels->inLabels);
+
+    freeLazyQueue(&queue);
+    trackedFree(MEM_BUFFERS, outLists);
+    trackedFree(MEM_BUFFERS, inLists);
+    trackedFree(MEM_BUFFERS, dist);
+    trackedFree(MEM_BUFFERS, hubDist);
+    trackedFree(MEM_BUFFERS, touched);
+    trackedFree(MEM_BUFFERS, order);
+    trackedFree(MEM_BUFFERS, reverse.offsets);
+    trackedFree(MEM_BUFFERS, reverse.dest);
+    trackedFree(MEM_BUFFERS, reverse.weight);
+    return labels;
+}
+
+/**
+ * @brief Answers a distance query by merging out(src) and in(dest).
+ *
+ * @param labels Pointer to the labels.
+ * @param src The source node.
+ * @param dest The destination node.
+ * @return The shortest distance, or INT_MAX if dest is unreachable.
+ */
+int hubLabelDistance(const HubLabels* labels, int src, int dest) {
+    const LabelEntry* a = labels->outLabels + labels->outOffsets[src];
+    const LabelEntry* aEnd = labels->outLabels + labels->outOffsets[src + 1];
+    const LabelEntry* b = labels->inLabels + labels->inOffsets[dest];
+    const LabelEntry* bEnd = labels->inLabels + labels->inOffsets[dest + 1];
+    long long best = INT_MAX;
+
+    while (a < aEnd && b < bEnd) {
+        if (a->hub == b->hub) {
+            long long d = (long long)a->dist + b->dist;
+            best = d < best ? d : best;
+            a++;
+            b++;
+        } else if (a->hub < b->hub) {
+            a++;
+        } else {
+            b++;
+        }
+    }
+    return (int)best;
+}
+
+/**
+ * @brief Returns the number of bytes used by the labels.
+ */
+long long hubLabelBytes(const HubLabels* labels) {
+    int numNodes = labels->numNodes;
+    return 2 * ((long long)numNodes + 1) * sizeof(long long) +
+           (labels->outOffsets[numNodes] + labels->inOffsets[numNodes]) * (long long)sizeof(LabelEntry);
+}
+
+static inline unsigned long long hashValue(unsigned long long hash, int value) {
+    return (hash ^ (unsigned)value) * 1099511628211ULL;
+}
+
+/**
+ * @brief FNV-1a hash of the size and of every arc (tail, head and weight) of a
+ * graph, stored with the labels so that an index saved for other arcs or
+ * weights is not reused.
+ */
+unsigned long long graphFingerprint(Graph* graph) {
+    unsigned long long hash = hashValue(hashValue(14695981039346656037ULL, graph->numNodes), graph->numEdges);
+    for (int u = 0; u < graph->numNodes; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            hash = hashValue(hashValue(hashValue(hash, u), node->dest), node->weight);
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes the labels to a binary file: the magic, the number of nodes,
+ * the fingerprint of the graph, then the offsets and entries of the out-labels and of the in-labels.
+ *
+ * @param labels Pointer to the labels.
+ * @param path Path of the file to be written.
+ * @return 1 on success, 0 on error.
+ */
+int saveHubLabels(const HubLabels* labels, const char* path) {
+    FILE* fp = fopen(path, "wb");
+    if (fp == NULL) {
+        perror("Error opening output file");
+        return 0;
+    }
+
+    int numNodes = labels->numNodes;
+    int ok = fwrite(HUB_LABELS_MAGIC, 1, sizeof(HUB_LABELS_MAGIC) - 1, fp) == sizeof(HUB_LABELS_MAGIC) - 1 &&
+             fwrite(&numNodes, sizeof(int), 1, fp) == 1 &&
+             fwrite(&labels->fingerprint, sizeof(unsigned long long), 1, fp) == 1 &&
+             fwrite(labels->outOffsets, sizeof(long long), numNodes + 1, fp) == (size_t)numNodes + 1 &&
+             fwrite(labels->outLabels, sizeof(LabelEntry), labels->outOffsets[numNodes], fp) == (size_t)labels->outOffsets[numNodes] &&
+             fwrite(labels->inOffsets, sizeof(long long), numNodes + 1, fp) == (size_t)numNodes + 1 &&
+             fwrite(labels->inLabels, sizeof(LabelEntry), labels->inOffsets[numNodes], fp) == (size_t)labels->inOffsets[numNodes];
+
+    fclose(fp);
+    return ok;
+}
+
+/**
+ * @brief Reads the offsets and entries of one side of the labels.
+ *
+ * @param remaining Bytes left in the file, decreased by what is read.
+ * @return 0 if the file is truncated or the offsets do not start at 0, decrease
+ * or end past the entries stored in the file.
+ */
+static int readLabelSide(FILE* fp, int numNodes, long long* remaining, long long** offsets, LabelEntry** entries) {
+    *offsets = NULL;
+    *entries = NULL;
+    long long offsetBytes = ((long long)numNodes + 1) * (long long)sizeof(long long);
+    if (offsetBytes > *remaining)
+        return 0;
+    *offsets = (long long*) trackedMalloc(MEM_GRAPH, (size_t)offsetBytes);
+    if (fread(*offsets, sizeof(long long), numNodes + 1, fp) != (size_t)numNodes + 1 || (*offsets)[0] != 0)
+        return 0;
+    for (int v = 0; v < numNodes; v++) {
+        if ((*offsets)[v + 1] < (*offsets)[v])
+            return 0;
+    }
+    *remaining -= offsetBytes;
+
+    long long total = (*offsets)[numNodes];
+    if (total > *remaining / (long long)sizeof(LabelEntry))
+        return 0;
+    *entries = (LabelEntry*) trackedMalloc(MEM_GRAPH, (total > 0 ? total : 1) * sizeof(LabelEntry));
+    *remaining -= total * (long long)sizeof(LabelEntry);
+    return fread(*entries, sizeof(LabelEntry), total, fp) == (size_t)total;
+}
+
+/**
+ * @brief Reads labels written by saveHubLabels.
+ *
+ * @param path Path of the file.
+ * @return Pointer to the labels, or NULL if the file cannot be read.
+ */
+HubLabels* loadHubLabels(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (fp == NULL)
+        return NULL;
+
+    char magic[sizeof(HUB_LABELS_MAGIC) - 1];
+    int numNodes;
+    unsigned long long fingerprint;
+    if (fread(magic, 1, sizeof(magic), fp) != sizeof(magic) || memcmp(magic, HUB_LABELS_MAGIC, sizeof(magic)) != 0 ||
+        fread(&numNodes, sizeof(int), 1, fp) != 1 || numNodes < 0 ||
+        fread(&fingerprint, sizeof(unsigned long long), 1, fp) != 1) {
+        fprintf(stderr, "Invalid hub label file: %s\n", path);
+        fclose(fp);
+        return NULL;
+    }
+
+    long long start = ftell(fp);
+    fseek(fp, 0, SEEK_END);
+    long long remaining = ftell(fp) - start;
+    fseek(fp, start, SEEK_SET);
+
+    HubLabels* labels = (HubLabels*) trackedMalloc(MEM_GRAPH, sizeof(HubLabels));
+    labels->numNodes = numNodes;
+    labels->fingerprint = fingerprint;
+    labels->inOffsets = NULL;
+    labels->inLabels = NULL;
+    int ok = readLabelSide(fp, numNodes, &remaining, &labels->outOffsets, &labels->outLabels) &&
+             readLabelSide(fp, numNodes, &remaining, &labels->inOffsets, &labels->inLabels);
+    fclose(fp);
+
+    if (!ok) {
+        fprintf(stderr, "Invalid hub label file: %s\n", path);
+        freeHubLabels(labels);
+        return NULL;
+    }
+    return labels;
+}
+
+/**
+ * @brief Frees the memory allocated for the labels.
+ *
+ * @param labels Pointer to the labels.
+ */
+void freeHubLabels(HubLabels* labels) {
+    trackedFree(MEM_GRAPH, labels->outOffsets);
+    trackedFree(MEM_GRAPH, labels->outLabels);
+    trackedFree(MEM_GRAPH, labels->inOffsets);
+    trackedFree(MEM_GRAPH, labels->inLabels);
+    trackedFree(MEM_GRAPH, labels);
+}
@@ -0,0 +1,44 @@
+//
+//  hub_labels.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef hub_labels_h
+#define hub_labels_h
+
+#include <stdio.h>
+#include "graph.h"
+
+/**
+ * @brief Entry of a label: a hub (by rank) and the distance to or from it.
+ */
+typedef struct {
+    int hub;
+    int dist;
+} LabelEntry;
+
+/**
+ * @brief 2-hop distance labels. Every node u has an out-label with hubs h and
+ * d(u, h) and an in-label with hubs h and d(h, u), both sorted by hub rank, such
+ * that every shortest u-v path goes through a hub shared by out(u) and in(v).
+ */
+typedef struct {
+    int numNodes;
+    unsigned long long fingerprint; // graphFingerprint of the graph the labels were built for
+    long long* outOffsets;      // out(u) is outLabels[outOffsets[u]] .. outLabels[outOffsets[u + 1] - 1]
+    LabelEntry* outLabels;
+    long long* inOffsets;
+    LabelEntry* inLabels;
+} HubLabels;
+
+unsigned long long graphFingerprint(Graph* graph);
+HubLabels* buildHubLabels(Graph* graph);
+int hubLabelDistance(const HubLabels* labels, int src, int dest);
+long long hubLabelBytes(const HubLabels* labels);
+int saveHubLabels(const HubLabels* labels, const char* path);
+HubLabels* loadHubLabels(const char* path);
+void freeHubLabels(HubLabels* labels);
+
+#endif /* hub_labels_h */
@@ -0,0 +1,232 @@
+//
+//  integer_dijkstra.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "integer_dijkstra.h"
+#include <stdlib.h>
+#include <limits.h>
+#include "memory_stats.h"
+#include "priority_queue.h"
+#include "operation_stats.h"
+
+#define RADIX_BUCKETS 33
+
+/**
+ * @brief Dial's algorithm: Dijkstra with one bucket per distance value.
+ *
+ * The keys in the queue always lie in [d, d + C], where d is the distance
+ * being settled, so C + 1 circular buckets are enough. Buckets are doubly
+ * linked lists kept in arrays, so a vertex moves to another bucket in O(1)
+ * and no heap is maintained. Runs in O(m + D), where D <= (n - 1) C is the
+ * largest distance. Edge weights must be in [0, maxWeight]. If the buckets
+ * cannot be allocated (maxWeight is INT_MAX, or too large for the memory),
+ * the radix heap is used instead.
+ *
+ * @param graph Pointer to the graph.
+ * @param src The source node.
+ * @param maxWeight Largest edge weight C.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ */
+void dialDistances(Graph* graph, int src, int maxWeight, int* dist) {
+    int numNodes = graph->numNodes;
+    if (maxWeight < 0 || maxWeight == INT_MAX) {
+        radixHeapDistances(graph, src, dist);
+        return;
+    }
+    int numBuckets = maxWeight + 1;
+    int* head = (int*) trackedMalloc(MEM_HEAP, (size_t)numBuckets * sizeof(int));
+    if (head == NULL) {
+        radixHeapDistances(graph, src, dist);
+        return;
+    }
+    int* next = (int*) trackedMalloc(MEM_HEAP, numNodes * sizeof(int));
+    int* prev = (int*) trackedMalloc(MEM_HEAP, numNodes * sizeof(int));
+
+    for (int b = 0; b < numBuckets; b++) {
+        head[b] = -1;
+    }
+    for (int i = 0; i < numNodes; i++) {
+        dist[i] = INT_MAX;
+    }
+
+    dist[src] = 0;
+    head[0] = src;
+    next[src] = -1;
+    prev[src] = -1;
+    int queued = 1;
+    long long current = 0;
+
+    while (queued > 0) {
+        int b = (int)(current % numBuckets);
+        while (head[b] < 0) {
+            current++;
+            b = (int)(current % numBuckets);
+        }
+
+        int u = head[b];
+        head[b] = next[u];
+        if (next[u] >= 0)
+            prev[next[u]] = -1;
+        queued--;
+        COUNT_OPERATION(OP_EXTRACT_MINS);
+
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            COUNT_OPERATION(OP_RELAXATIONS);
+            if (dist[u] + node->weight >= dist[v])
+                continue;
+            COUNT_IMPROVEMENT(dist[v]);
+
+            // A vertex with a finite distance that can still improve is queued
+            if (dist[v] != INT_MAX) {
+                COUNT_OPERATION(OP_DECREASE_KEYS);
+                int old = dist[v] % numBuckets;
+                if (prev[v] >= 0)
+                    next[prev[v]] = next[v];
+                else
+                    head[old] = next[v];
+                if (next[v] >= 0)
+                    prev[next[v]] = prev[v];
+            } else {
+                COUNT_OPERATION(OP_HEAP_INSERTS);
+                queued++;
+            }
+
+            dist[v] = dist[u] + node->weight;
+            int nb = dist[v] % numBuckets;
+            next[v] = head[nb];
+            prev[v] = -1;
+            if (head[nb] >= 0)
+                prev[head[nb]] = v;
+            head[nb] = v;
+        }
+        END_SETTLE();
+    }
+
+    trackedFree(MEM_HEAP, head);
+    trackedFree(MEM_HEAP, next);
+    trackedFree(MEM_HEAP, prev);
+}
+
+/**
+ * @brief Monotone radix heap. Bucket 0 holds the keys equal to the last
+ * extracted key; bucket i > 0 holds the keys whose highest bit differing from
+ * it is bit i - 1. Entries are lazy, as in LazyQueue.
+ */
+typedef struct {
+    QueueEntry* entries[RADIX_BUCKETS];
+    int size[RADIX_BUCKETS];
+    int capacity[RADIX_BUCKETS];
+    unsigned int last;
+    int count;
+} RadixHeap;
+
+static int radixBucket(unsigned int key, unsigned int last) {
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+}
+
+static void radixPush(RadixHeap* heap, int vertex, int key) {
+    int b = radixBucket((unsigned int)key, heap->last);
+    if (heap->size[b] == heap->capacity[b]) {
+        heap->capacity[b] = heap->capacity[b] ? heap->capacity[b] * 2 : 64;
+        heap->entries[b] = (QueueEntry*) trackedRealloc(MEM_HEAP, heap->entries[b], heap->capacity[b] * sizeof(QueueEntry));
+    }
+    heap->entries[b][heap->size[b]++] = (QueueEntry) { key, vertex };
+    heap->count++;
+}
+
+static QueueEntry radixPop(RadixHeap* heap) {
+    if (heap->size[0] == 0) {
+        int b = 1;
+        while (heap->size[b] == 0) {
+            b++;
+        }
+
+        // The new minimum splits bucket b into lower buckets
+        unsigned int minKey = UINT_MAX;
+        for (int i = 0; i < heap->size[b]; i++) {
+            unsigned int key = (unsigned int)heap->entries[b][i].key;
+            minKey = key < minKey ? key : minKey;
+        }
+        heap->last = minKey;
+
+        // Moving an entry to a lower bucket is the radix heap's sift step
+        int moved = heap->size[b];
+        heap->size[b] = 0;
+        heap->count -= moved;
+        COUNT_OPERATIONS(OP_SIFT_STEPS, moved);
+        for (int i = 0; i < moved; i++) {
+            QueueEntry entry = heap->entries[b][i];
+            radixPush(heap, entry.vertex, entry.key);
+        }
+    }
+
+    heap->count--;
+    COUNT_OPERATION(OP_EXTRACT_MINS);
+    return heap->entries[0][--heap->size[0]];
+}
+
+/**
+ * @brief Dijkstra's algorithm with a monotone radix heap. Since the keys in the
+ * heap never exceed the last extracted key by more than C, each entry moves
+ * down at most log C + 1 buckets, which gives O(m + n log C). Edge weights
+ * must be non-negative.
+ *
+ * @param graph Pointer to the graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ */
+void radixHeapDistances(Graph* graph, int src, int* dist) {
+    RadixHeap heap = { { NULL }, { 0 }, { 0 }, 0, 0 };
+
+    for (int i = 0; i < graph->numNodes; i++) {
+        dist[i] = INT_MAX;
+    }
+    dist[src] = 0;
+    radixPush(&heap, src, 0);
+    COUNT_OPERATION(OP_HEAP_INSERTS);
+
+    while (heap.count > 0) {
+        QueueEntry entry = radixPop(&heap);
+        int u = entry.vertex;
+        if (entry.key != dist[u])
+            continue;
+
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            COUNT_OPERATION(OP_RELAXATIONS);
+            if (dist[u] + node->weight < dist[v]) {
+                COUNT_IMPROVEMENT(dist[v]);
+                dist[v] = dist[u] + node->weight;
+                radixPush(&heap, v, dist[v]);
+                COUNT_OPERATION(OP_HEAP_INSERTS);
+            }
+        }
+        END_SETTLE();
+    }
+
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+        trackedFree(MEM_HEAP, heap.entries[b]);
+    }
+}
+
+/**
+ * @brief Integer-weight Dijkstra: Dial's buckets when the largest weight is at
+ * most DIAL_MAX_WEIGHT, the radix heap otherwise. Edge weights must be
+ * non-negative.
+ *
+ * @param graph Pointer to the graph.
+ * @param src The source node.
+ * @param maxWeight Largest edge weight C (see edgeWeightRange).
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ */
+void integerDijkstraDistances(Graph* graph, int src, int maxWeight, int* dist) {
+    if (maxWeight <= DIAL_MAX_WEIGHT) {
+        dialDistances(graph, src, maxWeight, dist);
+    } else {
+        radixHeapDistances(graph, src, dist);
+    }
+}
@@ -0,0 +1,22 @@
+//
+//  integer_dijkstra.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef integer_dijkstra_h
+#define integer_dijkstra_h
+
+#include <stdio.h>
+#include "graph.h"
+
+// Largest maximum weight C for which Dial's buckets are used; the radix heap
+// is used above it
+#define DIAL_MAX_WEIGHT 1024
+
+void dialDistances(Graph* graph, int src, int maxWeight, int* dist);
+void radixHeapDistances(Graph* graph, int src, int* dist);
+void integerDijkstraDistances(Graph* graph, int src, int maxWeight, int* dist);
+
+#endif /* integer_dijkstra_h */
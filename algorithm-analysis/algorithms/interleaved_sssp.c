@@ -0,0 +1,240 @@
+//
+//  interleaved_sssp.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "interleaved_sssp.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "priority_queue.h"
+#include "memory_stats.h"
+
+/**
+ * @brief Next step of a query in interleavedDijkstra.
+ */
+typedef enum {
+    STAGE_POP,      // Extract the next node to settle
+    STAGE_LIST,     // Read the head of its adjacency list
+    STAGE_SCAN      // Relax its arcs, one per step
+} QueryStage;
+
+/**
+ * @brief A single-source Dijkstra query written as a state machine. Every
+ * step issues prefetches for the data the next step of the same query reads
+ * and returns, so the other queries run while the cache lines arrive.
+ */
+typedef struct {
+    int query;              // Index in the sources array, -1 for a free slot
+    QueryStage stage;
+    int* dist;
+    LazyQueue queue;
+    int u;                  // Node being settled
+    int du;
+    AdjNode* pending;       // Arc relaxed on the next step; dist[pending->dest] was prefetched
+    AdjNode* next;          // Arc after it; its node was prefetched
+} QuerySlot;
+
+static void startQuery(Graph* graph, QuerySlot* slot, int query, int src) {
+    for (int v = 0; v < graph->numNodes; v++) {
+        slot->dist[v] = INT_MAX;
+    }
+    slot->dist[src] = 0;
+    lazyQueuePush(&slot->queue, src, 0);
+    slot->query = query;
+    slot->stage = STAGE_POP;
+}
+
+/**
+ * @brief Advances a query by one step.
+ *
+ * @return 1 if the query has finished, 0 otherwise.
+ */
+static int stepQuery(Graph* graph, QuerySlot* slot) {
+    int* dist = slot->dist;
+
+    switch (slot->stage) {
+        case STAGE_POP:
+            // Outdated entries are skipped in the same step; the top of the heap is cached
+            while (!lazyQueueIsEmpty(&slot->queue)) {
+                QueueEntry entry = lazyQueuePop(&slot->queue);
+                if (entry.key == dist[entry.vertex]) {
+                    slot->u = entry.vertex;
+                    slot->du = entry.key;
+                    PREFETCH(&graph->adjLists[slot->u]);
+                    slot->stage = STAGE_LIST;
+                    return 0;
+                }
+            }
+            return 1;
+
+        case STAGE_LIST:
+            slot->pending = NULL;
+            slot->next = graph->adjLists[slot->u];
+            if (slot->next != NULL) {
+                PREFETCH(slot->next);
+                slot->stage = STAGE_SCAN;
+            } else {
+                slot->stage = STAGE_POP;
+            }
+            return 0;
+
+        case STAGE_SCAN: {
+            AdjNode* arc = slot->pending;
+            if (arc != NULL && slot->du + arc->weight < dist[arc->dest]) {
+                dist[arc->dest] = slot->du + arc->weight;
+                lazyQueuePush(&slot->queue, arc->dest, dist[arc->dest]);
+            }
+
+            arc = slot->next;
+            slot->pending = arc;
+            if (arc == NULL) {
+                slot->stage = STAGE_POP;
+                return 0;
+            }
+            PREFETCH(&dist[arc->dest]);
+            slot->next = arc->next;
+            if (slot->next != NULL)
+                PREFETCH(slot->next);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Runs several single-source Dijkstra queries in lockstep on one
+ * thread. Up to width queries are in flight; they are advanced round-robin
+ * one step at a time, and every step prefetches what its query reads next
+ * (the adjacency list head, the next arc, the distance of its head), so the
+ * cache misses of different queries overlap instead of stalling one after
+ * the other. A finished query is reported and its slot starts the next source.
+ *
+ * The queues are lazy binary heaps (see LazyQueue), so a query's state is its
+ * distance array, its heap and a few words; weights must be non-negative.
+ *
+ * @param graph Pointer to the graph.
+ * @param sources Source node of every query.
+ * @param numQueries Number of queries.
+ * @param width Number of queries in flight (1 runs them one at a time).
+ * @param done Called with the distances of each query when it finishes.
+ * @param context Passed to done.
+ */
+void interleavedDijkstra(Graph* graph, const int* sources, int numQueries, int width,
+                         QueryCallback done, void* context) {
+    if (width > numQueries)
+        width = numQueries;
+    if (width < 1)
+        return;
+
+    QuerySlot* slots = (QuerySlot*) trackedMalloc(MEM_BUFFERS, width * sizeof(QuerySlot));
+    int started = 0;
+    for (int s = 0; s < width; s++) {
+        slots[s].dist = (int*) trackedMalloc(MEM_BUFFERS, graph->numNodes * sizeof(int));
+        initLazyQueue(&slots[s].queue);
+        startQuery(graph, &slots[s], started, sources[started]);
+        started++;
+    }
+
+    int active = width;
+    while (active > 0) {
+        for (int s = 0; s < width; s++) {
+            QuerySlot* slot = &slots[s];
+            if (slot->query < 0 || !stepQuery(graph, slot))
+                continue;
+
+            done(slot->query, slot->dist, context);
+            if (started < numQueries) {
+                startQuery(graph, slot, started, sources[started]);
+                started++;
+            } else {
+                slot->query = -1;
+                active--;
+            }
+        }
+    }
+
+    for (int s = 0; s < width; s++) {
+        trackedFree(MEM_BUFFERS, slots[s].dist);
+        freeLazyQueue(&slots[s].queue);
+    }
+    trackedFree(MEM_BUFFERS, slots);
+}
+
+/**
+ * @brief Relaxes one arc for every query: dv[q] = min(dv[q], du[q] + weight).
+ */
+static inline void relaxQueries(const int* du, int weight, int* dv, int width) {
+    for (int q = 0; q < width; q++) {
+        if (du[q] != INT_MAX && du[q] + weight < dv[q])
+            dv[q] = du[q] + weight;
+    }
+}
+
+/**
+ * @brief Bellman-Ford from several sources at once. Each round walks the
+ * adjacency lists once and relaxes every arc for all the queries, so the
+ * pointer chasing, which dominates a bellmanFordImprovedDistances round, is
+ * paid once for width queries. The distances are stored node-major, with the
+ * width queries of a node next to each other, so the cache line read for the
+ * head of an arc serves every query. The rounds are the same as in
+ * bellmanFordImprovedDistances (numNodes - 1, each from the distances of the
+ * previous one), and so are the results.
+ *
+ * @param graph Pointer to the graph.
+ * @param sources Source node of every query.
+ * @param width Number of queries.
+ * @param dist Array of numNodes * width entries that receives the distances:
+ * dist[v * width + q] is the distance from sources[q] to v (INT_MAX if unreachable).
+ * @param negativeCycle Array of width entries, set to 1 for the queries that
+ * reach a negative weight cycle and to 0 for the others.
+ */
+void interleavedBellmanFord(Graph* graph, const int* sources, int width, int* dist, int* negativeCycle) {
+    int numNodes = graph->numNodes;
+    size_t cells = (size_t)numNodes * width;
+    int* buffer = (int*) trackedMalloc(MEM_BUFFERS, cells * sizeof(int));
+    int* current = dist;
+    int* next = buffer;
+
+    for (size_t i = 0; i < cells; i++) {
+        current[i] = INT_MAX;
+    }
+    for (int q = 0; q < width; q++) {
+        current[(size_t)sources[q] * width + q] = 0;
+    }
+
+    for (int i = 1; i < numNodes; i++) {
+        memcpy(next, current, cells * sizeof(int));
+        for (int u = 0; u < numNodes; u++) {
+            const int* du = current + (size_t)u * width;
+            for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+                if (node->next != NULL)
+                    PREFETCH(next + (size_t)node->next->dest * width);
+                relaxQueries(du, node->weight, next + (size_t)node->dest * width, width);
+            }
+        }
+        int* temp = current;
+        current = next;
+        next = temp;
+    }
+
+    for (int q = 0; q < width; q++) {
+        negativeCycle[q] = 0;
+    }
+    for (int u = 0; u < numNodes; u++) {
+        const int* du = current + (size_t)u * width;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            const int* dv = current + (size_t)node->dest * width;
+            for (int q = 0; q < width; q++) {
+                if (du[q] != INT_MAX && du[q] + node->weight < dv[q])
+                    negativeCycle[q] = 1;
+            }
+        }
+    }
+
+    if (current != dist)
+        memcpy(dist, current, cells * sizeof(int));
+    trackedFree(MEM_BUFFERS, buffer);
+}
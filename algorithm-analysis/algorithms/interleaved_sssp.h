@@ -0,0 +1,28 @@
+//
+//  interleaved_sssp.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef interleaved_sssp_h
+#define interleaved_sssp_h
+
+#include <stdio.h>
+#include "graph.h"
+
+/**
+ * @brief Called by interleavedDijkstra when a query has finished.
+ *
+ * @param query Index of the query in the sources array.
+ * @param dist Distances of the query (INT_MAX if unreachable). The array is
+ * reused for a later query once the callback returns.
+ * @param context The context pointer given to interleavedDijkstra.
+ */
+typedef void (*QueryCallback)(int query, const int* dist, void* context);
+
+void interleavedDijkstra(Graph* graph, const int* sources, int numQueries, int width,
+                         QueryCallback done, void* context);
+void interleavedBellmanFord(Graph* graph, const int* sources, int width, int* dist, int* negativeCycle);
+
+#endif /* interleaved_sssp_h */
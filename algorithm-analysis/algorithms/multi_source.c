@@ -0,0 +1,124 @@
+//
+//  multi_source.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "multi_source.h"
+#include <stdlib.h>
+#include <limits.h>
+#include "memory_stats.h"
+#include "priority_queue.h"
+
+/**
+ * @brief Dijkstra's algorithm from a set of sources, as if a virtual super-source
+ * were connected to every source with a zero-weight edge.
+ *
+ * Besides the distances, each vertex is labeled with the source that reaches it
+ * first (its graph Voronoi cell). If isTarget is given, the search stops as soon
+ * as k target vertices are settled; in that case only the settled vertices have
+ * final distances, and the others keep upper bounds (or INT_MAX).
+ *
+ * @param graph Pointer to the graph.
+ * @param sources Array with the source vertices.
+ * @param numSources Number of sources.
+ * @param isTarget Boolean array marking the target vertices, or NULL to run to completion.
+ * @param k Number of targets to settle before stopping (ignored if isTarget is NULL or k < 1).
+ * @param dist Array of numNodes entries that receives the distances.
+ * @param pred Array of numNodes entries that receives the predecessors (-1 for sources
+ *             and unreached vertices), or NULL.
+ * @param nearest Array of numNodes entries that receives the nearest source (-1 if
+ *                unreached), or NULL.
+ * @param settledTargets Array of at least k entries that receives the settled targets
+ *                       in order of distance, or NULL.
+ * @return Number of targets settled (0 if isTarget is NULL).
+ */
+int multiSourceDijkstra(Graph* graph, const int* sources, int numSources,
+                        const bool* isTarget, int k,
+                        int* dist, int* pred, int* nearest, int* settledTargets) {
+    int numNodes = graph->numNodes;
+    int found = 0;
+    LazyQueue queue;
+    initLazyQueue(&queue);
+
+    for (int i = 0; i < numNodes; i++) {
+        dist[i] = INT_MAX;
+        if (pred != NULL)
+            pred[i] = -1;
+        if (nearest != NULL)
+            nearest[i] = -1;
+    }
+
+    for (int i = 0; i < numSources; i++) {
+        int s = sources[i];
+        if (dist[s] == 0)
+            continue;
+        dist[s] = 0;
+        if (nearest != NULL)
+            nearest[s] = s;
+        lazyQueuePush(&queue, s, 0);
+    }
+
+    while (!lazyQueueIsEmpty(&queue)) {
+        QueueEntry entry = lazyQueuePop(&queue);
+        int u = entry.vertex;
+        if (entry.key != dist[u])
+            continue;
+
+        if (isTarget != NULL && k > 0 && isTarget[u]) {
+            if (settledTargets != NULL)
+                settledTargets[found] = u;
+            if (++found >= k)
+                break;
+        }
+
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            if (dist[u] + node->weight < dist[v]) {
+                dist[v] = dist[u] + node->weight;
+                if (pred != NULL)
+                    pred[v] = u;
+                if (nearest != NULL)
+                    nearest[v] = nearest[u];
+                lazyQueuePush(&queue, v, dist[v]);
+            }
+        }
+    }
+
+    freeLazyQueue(&queue);
+    return found;
+}
+
+/**
+ * @brief Finds the k targets nearest to a source with a single Dijkstra run that
+ * stops once they are settled, instead of one full run per target.
+ *
+ * @param graph Pointer to the graph.
+ * @param src The source vertex.
+ * @param targets Array with the target vertices.
+ * @param numTargets Number of targets.
+ * @param k Number of nearest targets wanted.
+ * @param foundTargets Array of at least k entries that receives the targets, nearest first.
+ * @param foundDist Array of at least k entries that receives their distances.
+ * @return Number of targets found (less than k if fewer targets are reachable).
+ */
+int nearestTargets(Graph* graph, int src, const int* targets, int numTargets, int k,
+                   int* foundTargets, int* foundDist) {
+    int numNodes = graph->numNodes;
+    int* dist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    bool* isTarget = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+
+    for (int i = 0; i < numTargets; i++) {
+        isTarget[targets[i]] = true;
+    }
+
+    int found = multiSourceDijkstra(graph, &src, 1, isTarget, k, dist, NULL, NULL, foundTargets);
+    for (int i = 0; i < found; i++) {
+        foundDist[i] = dist[foundTargets[i]];
+    }
+
+    trackedFree(MEM_BUFFERS, dist);
+    trackedFree(MEM_BUFFERS, isTarget);
+    return found;
+}
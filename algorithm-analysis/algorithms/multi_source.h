@@ -0,0 +1,21 @@
+//
+//  multi_source.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef multi_source_h
+#define multi_source_h
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "graph.h"
+
+int multiSourceDijkstra(Graph* graph, const int* sources, int numSources,
+                        const bool* isTarget, int k,
+                        int* dist, int* pred, int* nearest, int* settledTargets);
+int nearestTargets(Graph* graph, int src, const int* targets, int numTargets, int k,
+                   int* foundTargets, int* foundDist);
+
+#endif /* multi_source_h */
@@ -0,0 +1,198 @@
+//
+//  negative_cycle.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "negative_cycle.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "memory_stats.h"
+#include "operation_stats.h"
+
+/**
+ * @brief Shortest path tree of the search, kept as a list of its vertices in
+ * preorder with their depths, so the subtree of a vertex is the run of
+ * vertices after it with a greater depth.
+ */
+typedef struct {
+    int* parent;
+    int* parentWeight;          // Weight of the arc from the parent
+    int* after;                 // Next vertex in preorder (-1 at the end)
+    int* before;                // Previous vertex in preorder (-1 for the root)
+    int* depth;
+    bool* inTree;
+} ShortestPathTree;
+
+/**
+ * @brief Removes the subtree of v (v included) from the tree. Its vertices
+ * keep their distances, but those are no longer consistent with the new
+ * distance of v, so they are not scanned until they improve again.
+ *
+ * @param u Vertex whose arc improved v.
+ * @return true if u is in the subtree of v, which closes a negative cycle.
+ */
+static bool disassembleSubtree(ShortestPathTree* tree, int v, int u) {
+    if (!tree->inTree[v])
+        return false;
+
+    int w = v;
+    do {
+        if (w == u)
+            return true;
+        tree->inTree[w] = false;
+        w = tree->after[w];
+    } while (w != -1 && tree->depth[w] > tree->depth[v]);
+
+    if (tree->before[v] != -1)
+        tree->after[tree->before[v]] = w;
+    if (w != -1)
+        tree->before[w] = tree->before[v];
+    return false;
+}
+
+/**
+ * @brief Makes v the first child of u.
+ */
+static void attachChild(ShortestPathTree* tree, int u, int v, int weight) {
+    tree->parent[v] = u;
+    tree->parentWeight[v] = weight;
+    tree->depth[v] = tree->depth[u] + 1;
+    tree->before[v] = u;
+    tree->after[v] = tree->after[u];
+    if (tree->after[u] != -1)
+        tree->before[tree->after[u]] = v;
+    tree->after[u] = v;
+    tree->inTree[v] = true;
+}
+
+/**
+ * @brief Builds the cycle closed by the arc (u, v) when u is a descendant of
+ * v: the tree path from v down to u, then back to v.
+ */
+static void extractCycle(const ShortestPathTree* tree, int u, int v, int weight, NegativeCycle* cycle) {
+    int length = 1;
+    for (int w = u; w != v; w = tree->parent[w]) {
+        length++;
+    }
+
+    cycle->vertices = (int*) malloc(length * sizeof(int));
+    cycle->length = length;
+    cycle->weight = weight;
+    int i = length - 1;
+    for (int w = u; w != v; w = tree->parent[w]) {
+        cycle->vertices[i--] = w;
+        cycle->weight += tree->parentWeight[w];
+    }
+    cycle->vertices[0] = v;
+}
+
+/**
+ * @brief Bellman-Ford with a FIFO queue and Tarjan's subtree disassembly.
+ *
+ * The search keeps the tree of the current parents. When the arc (u, v)
+ * lowers the distance of v, the whole subtree of v is taken out of the tree
+ * and its vertices are not scanned again until they improve, which saves the
+ * work of propagating distances that are already out of date. If u is in the
+ * subtree of v, the arc closes a cycle of negative weight and the search stops
+ * at once, instead of after numNodes - 1 rounds.
+ *
+ * @param graph Pointer to the graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if
+ * unreachable; meaningless if a negative cycle is found).
+ * @param cycle Output parameter with the cycle, or NULL. It is only set when a
+ * cycle is found, and must be freed with freeNegativeCycle.
+ * @return 1 if a negative cycle reachable from src was found, 0 otherwise.
+ */
+int bellmanFordTarjanDistances(Graph* graph, int src, int* dist, NegativeCycle* cycle) {
+    int numNodes = graph->numNodes;
+    ShortestPathTree tree;
+    tree.parent = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    tree.parentWeight = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    tree.after = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    tree.before = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    tree.depth = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    tree.inTree = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+    bool* queued = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+    // Circular FIFO queue; a vertex is in it at most once
+    int* queue = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int head = 0, size = 0;
+    int passLeft = 1;           // Vertices of the current pass still in the queue
+
+    for (int i = 0; i < numNodes; i++) {
+        dist[i] = INT_MAX;
+    }
+    dist[src] = 0;
+    tree.parent[src] = -1;
+    tree.after[src] = -1;
+    tree.before[src] = -1;
+    tree.depth[src] = 0;
+    tree.inTree[src] = true;
+    queue[0] = src;
+    queued[src] = true;
+    size = 1;
+
+    int negativeCycle = 0;
+    while (size > 0 && !negativeCycle) {
+        // A pass ends when the vertices queued during the previous one have been taken out
+        if (passLeft == 0) {
+            END_ROUND(size);
+            passLeft = size;
+        }
+        passLeft--;
+
+        int u = queue[head];
+        head = (head + 1) % numNodes;
+        size--;
+        queued[u] = false;
+        if (!tree.inTree[u])
+            continue;
+
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            COUNT_OPERATION(OP_RELAXATIONS);
+            if (dist[u] + node->weight >= dist[v])
+                continue;
+
+            COUNT_IMPROVEMENT(dist[v]);
+            if (disassembleSubtree(&tree, v, u)) {
+                negativeCycle = 1;
+                if (cycle != NULL)
+                    extractCycle(&tree, u, v, node->weight, cycle);
+                break;
+            }
+            dist[v] = dist[u] + node->weight;
+            attachChild(&tree, u, v, node->weight);
+            if (!queued[v]) {
+                queue[(head + size) % numNodes] = v;
+                size++;
+                queued[v] = true;
+            }
+        }
+    }
+    END_ROUND(size);
+
+    trackedFree(MEM_BUFFERS, tree.parent);
+    trackedFree(MEM_BUFFERS, tree.parentWeight);
+    trackedFree(MEM_BUFFERS, tree.after);
+    trackedFree(MEM_BUFFERS, tree.before);
+    trackedFree(MEM_BUFFERS, tree.depth);
+    trackedFree(MEM_BUFFERS, tree.inTree);
+    trackedFree(MEM_BUFFERS, queued);
+    trackedFree(MEM_BUFFERS, queue);
+    return negativeCycle;
+}
+
+/**
+ * @brief Frees the vertices of a cycle.
+ *
+ * @param cycle Pointer to the cycle.
+ */
+void freeNegativeCycle(NegativeCycle* cycle) {
+    free(cycle->vertices);
+    cycle->vertices = NULL;
+    cycle->length = 0;
+}
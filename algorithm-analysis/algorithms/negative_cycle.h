@@ -0,0 +1,28 @@
+//
+//  negative_cycle.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef negative_cycle_h
+#define negative_cycle_h
+
+#include <stdio.h>
+#include "graph.h"
+
+/**
+ * @brief A cycle of negative total weight, as the list of its vertices: there
+ * is an arc from vertices[i] to vertices[i + 1], and from the last vertex back
+ * to the first.
+ */
+typedef struct {
+    int* vertices;
+    int length;
+    long long weight;           // Total weight of the arcs of the cycle
+} NegativeCycle;
+
+int bellmanFordTarjanDistances(Graph* graph, int src, int* dist, NegativeCycle* cycle);
+void freeNegativeCycle(NegativeCycle* cycle);
+
+#endif /* negative_cycle_h */
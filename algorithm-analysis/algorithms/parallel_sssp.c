@@ -0,0 +1,253 @@
+//
+//  parallel_sssp.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "parallel_sssp.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "priority_queue.h"
+#include "memory_stats.h"
+#include "scheduler.h"
+
+/**
+ * @brief One binary heap of the MultiQueue. The key of its top entry is
+ * published in an atomic so that threads can compare two queues without
+ * locking them. Heaps grow inside worker threads, whose memory counters are
+ * not the ones of the run, so their entries use plain realloc and the calling
+ * thread accounts them with trackMemory once the workers are done.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    QueueEntry* entries;
+    int size;
+    int capacity;
+    atomic_int topKey;          // INT_MAX when the heap is empty
+} SharedHeap;
+
+typedef struct {
+    Graph* graph;
+    atomic_int* dist;
+    SharedHeap* heaps;
+    int numHeaps;
+    atomic_llong pending;       // Entries pushed and not yet fully processed
+} MultiQueueJob;
+
+typedef struct {
+    MultiQueueJob* job;
+    unsigned long long random;  // xorshift state
+} MultiQueueWorker;
+
+static unsigned int nextIndex(MultiQueueWorker* worker, int bound) {
+    unsigned long long x = worker->random;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    worker->random = x;
+    return (unsigned int)((x >> 32) % (unsigned long long)bound);
+}
+
+static void heapPush(SharedHeap* heap, int vertex, int key) {
+    if (heap->size == heap->capacity) {
+        heap->capacity = heap->capacity ? heap->capacity * 2 : 256;
+        heap->entries = (QueueEntry*) realloc(heap->entries, heap->capacity * sizeof(QueueEntry));
+    }
+    int i = heap->size++;
+    while (i > 0 && heap->entries[(i - 1) / 2].key > key) {
+        heap->entries[i] = heap->entries[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap->entries[i] = (QueueEntry) { key, vertex };
+    atomic_store_explicit(&heap->topKey, heap->entries[0].key, memory_order_relaxed);
+}
+
+static QueueEntry heapPop(SharedHeap* heap) {
+    QueueEntry top = heap->entries[0];
+    QueueEntry last = heap->entries[--heap->size];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= heap->size)
+            break;
+        if (child + 1 < heap->size && heap->entries[child + 1].key < heap->entries[child].key)
+            child++;
+        if (heap->entries[child].key >= last.key)
+            break;
+        heap->entries[i] = heap->entries[child];
+        i = child;
+    }
+    if (heap->size > 0)
+        heap->entries[i] = last;
+    atomic_store_explicit(&heap->topKey, heap->size > 0 ? heap->entries[0].key : INT_MAX, memory_order_relaxed);
+    return top;
+}
+
+/**
+ * @brief Pushes an entry into a random heap, skipping heaps locked by other threads.
+ */
+static void multiQueuePush(MultiQueueWorker* worker, int vertex, int key) {
+    MultiQueueJob* job = worker->job;
+    for (;;) {
+        SharedHeap* heap = &job->heaps[nextIndex(worker, job->numHeaps)];
+        if (pthread_mutex_trylock(&heap->lock) == 0) {
+            heapPush(heap, vertex, key);
+            pthread_mutex_unlock(&heap->lock);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Pops the smaller top of two random heaps. The result is only
+ * approximately the global minimum, which is what lets the threads avoid a
+ * single contended queue.
+ *
+ * @return true if an entry was taken, false if both heaps were empty or busy.
+ */
+static bool multiQueuePop(MultiQueueWorker* worker, QueueEntry* entry) {
+    MultiQueueJob* job = worker->job;
+    SharedHeap* a = &job->heaps[nextIndex(worker, job->numHeaps)];
+    SharedHeap* b = &job->heaps[nextIndex(worker, job->numHeaps)];
+    if (atomic_load_explicit(&b->topKey, memory_order_relaxed) < atomic_load_explicit(&a->topKey, memory_order_relaxed))
+        a = b;
+    if (atomic_load_explicit(&a->topKey, memory_order_relaxed) == INT_MAX || pthread_mutex_trylock(&a->lock) != 0)
+        return false;
+
+    bool found = a->size > 0;
+    if (found)
+        *entry = heapPop(a);
+    pthread_mutex_unlock(&a->lock);
+    return found;
+}
+
+/**
+ * @brief Lowers dist[v] to key with compare-and-swap.
+ *
+ * @return true if this thread set the new distance.
+ */
+static bool relaxAtomic(atomic_int* dist, int v, int key) {
+    int current = atomic_load_explicit(&dist[v], memory_order_relaxed);
+    while (key < current) {
+        if (atomic_compare_exchange_weak_explicit(&dist[v], &current, key, memory_order_relaxed, memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Worker loop. Every pushed entry is counted in pending before it is
+ * pushed and uncounted only after it has been processed (which pushes its
+ * successors first), so pending reaches zero exactly when no entry is left
+ * anywhere and every thread can stop without a barrier.
+ */
+static void* multiQueueWorker(void* arg) {
+    MultiQueueWorker* worker = (MultiQueueWorker*) arg;
+    MultiQueueJob* job = worker->job;
+    int failures = 0;
+
+    while (atomic_load(&job->pending) > 0) {
+        QueueEntry entry;
+        if (!multiQueuePop(worker, &entry)) {
+            if (++failures >= 64) {
+                sched_yield();
+                failures = 0;
+            }
+            continue;
+        }
+        failures = 0;
+
+        // Skip entries whose vertex has improved since they were pushed
+        int u = entry.vertex;
+        if (entry.key <= atomic_load_explicit(&job->dist[u], memory_order_relaxed)) {
+            for (AdjNode* node = job->graph->adjLists[u]; node != NULL; node = node->next) {
+                int key = entry.key + node->weight;
+                if (relaxAtomic(job->dist, node->dest, key)) {
+                    atomic_fetch_add(&job->pending, 1);
+                    multiQueuePush(worker, node->dest, key);
+                }
+            }
+        }
+        atomic_fetch_sub(&job->pending, 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Computes the shortest distances with an asynchronous label-correcting
+ * search. The threads share a MultiQueue (MULTIQUEUE_FACTOR heaps per thread),
+ * take approximately the smallest tentative distance from it and lower dist[]
+ * with compare-and-swap. Vertices may be settled more than once because the
+ * order is relaxed; the result is the same as Dijkstra's. Edge weights must be
+ * non-negative.
+ *
+ * @param graph Pointer to the graph.
+ * @param src The source node.
+ * @param numThreads Number of threads (one per processor if < 1).
+ * @param dist Array of numNodes entries that receives the distances.
+ */
+void multiQueueDistances(Graph* graph, int src, int numThreads, int* dist) {
+    int numNodes = graph->numNodes;
+    if (numThreads < 1)
+        numThreads = availableProcessors();
+
+    MultiQueueJob job;
+    job.graph = graph;
+    job.dist = (atomic_int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(atomic_int));
+    job.numHeaps = MULTIQUEUE_FACTOR * numThreads;
+    job.heaps = (SharedHeap*) trackedMalloc(MEM_HEAP, job.numHeaps * sizeof(SharedHeap));
+    atomic_init(&job.pending, 1);
+
+    for (int i = 0; i < numNodes; i++) {
+        atomic_init(&job.dist[i], INT_MAX);
+    }
+    for (int i = 0; i < job.numHeaps; i++) {
+        pthread_mutex_init(&job.heaps[i].lock, NULL);
+        job.heaps[i].entries = NULL;
+        job.heaps[i].size = 0;
+        job.heaps[i].capacity = 0;
+        atomic_init(&job.heaps[i].topKey, INT_MAX);
+    }
+    atomic_store(&job.dist[src], 0);
+    heapPush(&job.heaps[0], src, 0);
+
+    MultiQueueWorker* workers = (MultiQueueWorker*) trackedCalloc(MEM_BUFFERS, numThreads, sizeof(MultiQueueWorker));
+    pthread_t* threads = (pthread_t*) trackedMalloc(MEM_BUFFERS, numThreads * sizeof(pthread_t));
+    for (int i = 0; i < numThreads; i++) {
+        workers[i].job = &job;
+        workers[i].random = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+    for (int i = 1; i < numThreads; i++) {
+        pthread_create(&threads[i], NULL, multiQueueWorker, &workers[i]);
+    }
+    multiQueueWorker(&workers[0]);
+    for (int i = 1; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (int i = 0; i < numNodes; i++) {
+        dist[i] = atomic_load(&job.dist[i]);
+    }
+
+    // Heaps only grow, so their final capacities are the most they held
+    size_t entryBytes = 0;
+    for (int i = 0; i < job.numHeaps; i++) {
+        entryBytes += (size_t)job.heaps[i].capacity * sizeof(QueueEntry);
+    }
+    trackMemory(MEM_HEAP, entryBytes);
+    untrackMemory(MEM_HEAP, entryBytes);
+
+    for (int i = 0; i < job.numHeaps; i++) {
+        pthread_mutex_destroy(&job.heaps[i].lock);
+        free(job.heaps[i].entries);
+    }
+    trackedFree(MEM_HEAP, job.heaps);
+    trackedFree(MEM_BUFFERS, job.dist);
+    trackedFree(MEM_BUFFERS, workers);
+    trackedFree(MEM_BUFFERS, threads);
+}
@@ -0,0 +1,19 @@
+//
+//  parallel_sssp.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef parallel_sssp_h
+#define parallel_sssp_h
+
+#include <stdio.h>
+#include "graph.h"
+
+// Number of queues of the MultiQueue per thread
+#define MULTIQUEUE_FACTOR 4
+
+void multiQueueDistances(Graph* graph, int src, int numThreads, int* dist);
+
+#endif /* parallel_sssp_h */
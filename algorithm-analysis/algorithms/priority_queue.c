@@ -0,0 +1,94 @@
+//
+//  priority_queue.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "priority_queue.h"
+#include <stdlib.h>
+#include "memory_stats.h"
+#include "operation_stats.h"
+
+/**
+ * @brief Initializes an empty queue. Memory is allocated on the first push.
+ *
+ * @param queue Pointer to the queue.
+ */
+void initLazyQueue(LazyQueue* queue) {
+    queue->entries = NULL;
+    queue->size = 0;
+    queue->capacity = 0;
+}
+
+/**
+ * @brief Inserts a vertex with the given key in the queue.
+ *
+ * @param queue Pointer to the queue.
+ * @param vertex Vertex number.
+ * @param key Key associated with the vertex.
+ */
+void lazyQueuePush(LazyQueue* queue, int vertex, int key) {
+    if (queue->size == queue->capacity) {
+        queue->capacity = queue->capacity ? queue->capacity * 2 : 64;
+        queue->entries = (QueueEntry*) trackedRealloc(MEM_HEAP, queue->entries, queue->capacity * sizeof(QueueEntry));
+    }
+
+    COUNT_OPERATION(OP_HEAP_INSERTS);
+    int idx = queue->size++;
+    while (idx && queue->entries[(idx - 1) / 2].key > key) {
+        COUNT_OPERATION(OP_SIFT_STEPS);
+        queue->entries[idx] = queue->entries[(idx - 1) / 2];
+        idx = (idx - 1) / 2;
+    }
+    queue->entries[idx].key = key;
+    queue->entries[idx].vertex = vertex;
+}
+
+/**
+ * @brief Removes the entry with the smallest key from the queue.
+ *
+ * @param queue Pointer to a non-empty queue.
+ * @return The removed entry.
+ */
+QueueEntry lazyQueuePop(LazyQueue* queue) {
+    QueueEntry root = queue->entries[0];
+    QueueEntry last = queue->entries[--queue->size];
+    COUNT_OPERATION(OP_EXTRACT_MINS);
+
+    int idx = 0;
+    while (2 * idx + 1 < queue->size) {
+        int child = 2 * idx + 1;
+        if (child + 1 < queue->size && queue->entries[child + 1].key < queue->entries[child].key)
+            child++;
+        if (queue->entries[child].key >= last.key)
+            break;
+        COUNT_OPERATION(OP_SIFT_STEPS);
+        queue->entries[idx] = queue->entries[child];
+        idx = child;
+    }
+    if (queue->size > 0)
+        queue->entries[idx] = last;
+
+    return root;
+}
+
+/**
+ * @brief Checks if the queue is empty.
+ *
+ * @param queue Pointer to the queue.
+ * @return true if the queue is empty, false otherwise.
+ */
+bool lazyQueueIsEmpty(LazyQueue* queue) {
+    return queue->size == 0;
+}
+
+/**
+ * @brief Frees the memory of the queue and leaves it empty.
+ *
+ * @param queue Pointer to the queue.
+ */
+void freeLazyQueue(LazyQueue* queue) {
+    trackedFree(MEM_HEAP, queue->entries);
+    initLazyQueue(queue);
+}
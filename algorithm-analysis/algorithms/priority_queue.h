@@ -0,0 +1,39 @@
+//
+//  priority_queue.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef priority_queue_h
+#define priority_queue_h
+
+#include <stdio.h>
+#include <stdbool.h>
+
+/**
+ * @brief Entry of the lazy priority queue.
+ */
+typedef struct {
+    int key;
+    int vertex;
+} QueueEntry;
+
+/**
+ * @brief Binary min-heap without decrease-key. A vertex is pushed again each
+ * time its key improves, and outdated entries are skipped by the caller when
+ * they are extracted (their key no longer matches the vertex's distance).
+ */
+typedef struct {
+    QueueEntry* entries;
+    int size;
+    int capacity;
+} LazyQueue;
+
+void initLazyQueue(LazyQueue* queue);
+void lazyQueuePush(LazyQueue* queue, int vertex, int key);
+QueueEntry lazyQueuePop(LazyQueue* queue);
+bool lazyQueueIsEmpty(LazyQueue* queue);
+void freeLazyQueue(LazyQueue* queue);
+
+#endif /* priority_queue_h */
@@ -0,0 +1,425 @@
+//
+//  sharded_sssp.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "sharded_sssp.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdalign.h>
+#include <limits.h>
+#include <signal.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "memory_stats.h"
+#include "operation_stats.h"
+
+#define CACHE_LINE 64
+
+/**
+ * @brief A relaxation sent to the shard that owns its node.
+ */
+typedef struct {
+    int node;               // Numbered in the receiving shard
+    int distance;
+} Message;
+
+/**
+ * @brief Single-producer, single-consumer ring of messages from one shard to
+ * another. The indices only grow: the producer publishes messages by moving
+ * tail and the consumer frees them by moving head, so neither side locks.
+ */
+typedef struct {
+    alignas(CACHE_LINE) atomic_uint head;
+    alignas(CACHE_LINE) atomic_uint tail;
+    unsigned int mask;      // Capacity - 1 (a power of two)
+    size_t offset;          // Of its messages, from the start of the shared region
+} MessageRing;
+
+/**
+ * @brief Barrier of the shard processes: the last one to arrive moves the
+ * generation, which the others wait for.
+ */
+typedef struct {
+    alignas(CACHE_LINE) atomic_int arrived;
+    alignas(CACHE_LINE) atomic_int generation;
+} ShardBarrier;
+
+typedef struct {
+    ShardBarrier barrier;
+    atomic_llong active[3];     // Nodes queued for the next superstep over all shards, one counter per superstep mod 3
+    atomic_int start;           // 1 once every process runs, -1 if one could not be started or failed
+    int negativeCycle;
+    long long supersteps;
+} SharedControl;
+
+typedef struct {
+    long long relaxations;
+    long long improvements;
+    long long messages;
+} ShardStats;
+
+/**
+ * @brief Everything a shard process needs. It is filled in before forking, so
+ * every process inherits it; only the region is shared between them.
+ */
+typedef struct {
+    const ShardedGraph* graph;
+    unsigned char* region;      // Shared mapping: control, statistics, distances and rings
+    size_t regionBytes;
+    SharedControl* control;
+    ShardStats* stats;
+    int* dist;                  // numNodes entries; each shard only writes its own range
+    MessageRing* rings;         // rings[from * numShards + to]
+    int* scratch;               // Private buffers of the shards (each process writes its own copy)
+    size_t* scratchOffset;
+    pid_t parent;
+} ShardedRun;
+
+static size_t alignUp(size_t bytes) {
+    return (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+static unsigned int ringCapacity(int messages) {
+    unsigned int capacity = 1;
+    while (capacity < (unsigned int)messages) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/**
+ * @brief Tells a waiting shard to give up: the run was aborted, or the
+ * process that started it is gone.
+ */
+static bool abandoned(const ShardedRun* run) {
+    return atomic_load_explicit(&run->control->start, memory_order_relaxed) < 0 || getppid() != run->parent;
+}
+
+static void barrierWait(ShardedRun* run) {
+    ShardBarrier* barrier = &run->control->barrier;
+    int generation = atomic_load_explicit(&barrier->generation, memory_order_acquire);
+    if (atomic_fetch_add_explicit(&barrier->arrived, 1, memory_order_acq_rel) == run->graph->numShards - 1) {
+        atomic_store_explicit(&barrier->arrived, 0, memory_order_relaxed);
+        atomic_fetch_add_explicit(&barrier->generation, 1, memory_order_release);
+        return;
+    }
+    while (atomic_load_explicit(&barrier->generation, memory_order_acquire) == generation) {
+        if (abandoned(run))
+            _exit(EXIT_FAILURE);
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Appends a message to a ring. Rings are never full: a shard sends at
+ * most one message per slot and superstep, every ring holds the slots of its
+ * sender owned by its receiver, and it is drained before the next messages.
+ */
+static void sendMessage(ShardedRun* run, MessageRing* ring, int node, int distance) {
+    Message* messages = (Message*) (run->region + ring->offset);
+    unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    messages[tail & ring->mask] = (Message) { node, distance };
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+}
+
+/**
+ * @brief One shard of the BSP Bellman-Ford. Every superstep scans the queued
+ * nodes once: arcs inside the shard are relaxed in place, and a node lowered
+ * before its scan in the same superstep is scanned then. Arcs to other shards
+ * lower the distance kept for their slot, and each lowered slot is sent once
+ * at the end of the superstep. After a barrier, the shard applies the messages
+ * it received and adds its queued nodes to a shared count; after a second
+ * barrier, every shard reads the count and stops when it is zero. Without a
+ * negative cycle the distances settle within numNodes - 1 supersteps.
+ */
+static void runShard(ShardedRun* run, int s, int src) {
+    const ShardedGraph* graph = run->graph;
+    const Shard* shard = &graph->shards[s];
+    SharedControl* control = run->control;
+    ShardStats stats = { 0, 0, 0 };
+    int numShards = graph->numShards;
+    int n = shard->numNodes;
+
+    int* dist = run->dist + shard->firstNode;
+    int* queued = run->scratch + run->scratchOffset[s];    // 1 while the node waits in current or next
+    int* scanned = queued + n;                              // Last superstep + 1 that scanned the node
+    int* current = scanned + n;
+    int* next = current + n;
+    int* sent = next + n;                                   // Smallest distance sent to every slot
+    int* dirty = sent + shard->numSlots;                    // 1 if the slot must be sent this superstep
+    int* dirtyList = dirty + shard->numSlots;
+    int numCurrent = 0, numNext = 0, numDirty = 0;
+
+    for (int v = 0; v < n; v++) {
+        dist[v] = INT_MAX;
+        queued[v] = 0;
+        scanned[v] = 0;
+    }
+    for (int i = 0; i < shard->numSlots; i++) {
+        sent[i] = INT_MAX;
+        dirty[i] = 0;
+    }
+    if (src >= shard->firstNode && src < shard->firstNode + n) {
+        dist[src - shard->firstNode] = 0;
+        queued[src - shard->firstNode] = 1;
+        current[numCurrent++] = src - shard->firstNode;
+    }
+
+    long long superstep = 0, active = 0;
+    for (;;) {
+        int stamp = (int)superstep + 1;
+        for (int head = 0; head < numCurrent; head++) {
+            int u = current[head];
+            queued[u] = 0;
+            scanned[u] = stamp;
+            stats.relaxations += shard->offsets[u + 1] - shard->offsets[u];
+            for (int a = shard->offsets[u]; a < shard->offsets[u + 1]; a++) {
+                int distance = dist[u] + shard->weights[a];
+                int t = shard->targets[a];
+                if (t >= 0) {
+                    if (distance < dist[t]) {
+                        dist[t] = distance;
+                        stats.improvements++;
+                        if (!queued[t]) {
+                            queued[t] = 1;
+                            if (scanned[t] == stamp)
+                                next[numNext++] = t;
+                            else
+                                current[numCurrent++] = t;
+                        }
+                    }
+                } else if (distance < sent[-t - 1]) {
+                    int slot = -t - 1;
+                    sent[slot] = distance;
+                    if (!dirty[slot]) {
+                        dirty[slot] = 1;
+                        dirtyList[numDirty++] = slot;
+                    }
+                }
+            }
+        }
+
+        for (int i = 0; i < numDirty; i++) {
+            int slot = dirtyList[i];
+            int t = shard->slotShard[slot];
+            sendMessage(run, &run->rings[s * numShards + t], shard->slotNode[slot], sent[slot]);
+            dirty[slot] = 0;
+        }
+        stats.messages += numDirty;
+        numDirty = 0;
+        barrierWait(run);
+
+        for (int r = 0; r < numShards; r++) {
+            MessageRing* ring = &run->rings[r * numShards + s];
+            if (r == s)
+                continue;
+            Message* messages = (Message*) (run->region + ring->offset);
+            unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+            unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+            for (; head != tail; head++) {
+                Message message = messages[head & ring->mask];
+                if (message.distance < dist[message.node]) {
+                    dist[message.node] = message.distance;
+                    stats.improvements++;
+                    if (!queued[message.node]) {
+                        queued[message.node] = 1;
+                        next[numNext++] = message.node;
+                    }
+                }
+            }
+            atomic_store_explicit(&ring->head, head, memory_order_release);
+        }
+
+        // The counter of superstep + 1 was last read two barriers ago
+        atomic_fetch_add_explicit(&control->active[superstep % 3], numNext, memory_order_relaxed);
+        atomic_store_explicit(&control->active[(superstep + 1) % 3], 0, memory_order_relaxed);
+        barrierWait(run);
+        active = atomic_load_explicit(&control->active[superstep % 3], memory_order_relaxed);
+        superstep++;
+        if (active == 0 || superstep >= graph->numNodes)
+            break;
+
+        int* swap = current;
+        current = next;
+        next = swap;
+        numCurrent = numNext;
+        numNext = 0;
+    }
+
+    run->stats[s] = stats;
+    if (s == 0) {
+        control->supersteps = superstep;
+        control->negativeCycle = active > 0;
+    }
+}
+
+/**
+ * @brief Lays out the shared region and maps it. The mapping is accounted as
+ * buffers of the calling thread, since the tracked functions do not see it.
+ *
+ * @return false if the region could not be mapped.
+ */
+static bool mapSharedRegion(ShardedRun* run) {
+    const ShardedGraph* graph = run->graph;
+    int numShards = graph->numShards;
+    size_t statsOffset = alignUp(sizeof(SharedControl));
+    size_t distOffset = statsOffset + alignUp(numShards * sizeof(ShardStats));
+    size_t ringsOffset = distOffset + alignUp((size_t)graph->numNodes * sizeof(int));
+    size_t bytes = ringsOffset + alignUp((size_t)numShards * numShards * sizeof(MessageRing));
+    for (int from = 0; from < numShards; from++) {
+        for (int to = 0; to < numShards; to++) {
+            if (from != to)
+                bytes += alignUp(ringCapacity(graph->shards[from].outgoing[to]) * sizeof(Message));
+        }
+    }
+
+    void* region = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        perror("mmap");
+        return false;
+    }
+    trackMemory(MEM_BUFFERS, bytes);
+    run->region = (unsigned char*) region;
+    run->regionBytes = bytes;
+    run->control = (SharedControl*) region;
+    run->stats = (ShardStats*) (run->region + statsOffset);
+    run->dist = (int*) (run->region + distOffset);
+    run->rings = (MessageRing*) (run->region + ringsOffset);
+
+    // The mapping starts zeroed, so the atomics start at 0
+    size_t offset = ringsOffset + alignUp((size_t)numShards * numShards * sizeof(MessageRing));
+    for (int from = 0; from < numShards; from++) {
+        for (int to = 0; to < numShards; to++) {
+            MessageRing* ring = &run->rings[from * numShards + to];
+            unsigned int capacity = ringCapacity(graph->shards[from].outgoing[to]);
+            ring->mask = capacity - 1;
+            ring->offset = offset;
+            if (from != to)
+                offset += alignUp(capacity * sizeof(Message));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps the shared region.
+ */
+static void unmapSharedRegion(ShardedRun* run) {
+    untrackMemory(MEM_BUFFERS, run->regionBytes);
+    munmap(run->region, run->regionBytes);
+}
+
+/**
+ * @brief Waits for the shard processes. If one of them fails, the others are
+ * killed.
+ *
+ * @return true if every process finished its shard.
+ */
+static bool waitForShards(ShardedRun* run, pid_t group, int numStarted) {
+    bool ok = true;
+    for (int i = 0; i < numStarted; i++) {
+        int status;
+        if (waitpid(-group, &status, 0) < 0) {
+            perror("waitpid");
+            return false;
+        }
+        if (ok && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+            ok = false;
+            atomic_store(&run->control->start, -1);
+            kill(-group, SIGKILL);
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Computes the shortest distances with a bulk-synchronous Bellman-Ford
+ * in which every shard runs in its own process, as on a cluster with one node
+ * per shard. The processes share nothing but an anonymous shared mapping with
+ * the distances (each shard writes only its own range), a barrier and a
+ * lock-free ring for every ordered pair of shards, through which the
+ * relaxations of arcs between shards are sent. The processes are forked for
+ * every run and form their own process group, so the caller can wait for them
+ * without touching other children.
+ *
+ * @param graph Pointer to the sharded graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ * @return 1 if a negative weight cycle is reachable from src, 0 otherwise, or
+ * -1 if the shared region could not be mapped or a shard process could not be
+ * started or did not finish (dist is then undefined).
+ */
+int shardedBellmanFordDistances(ShardedGraph* graph, int src, int* dist) {
+    int numShards = graph->numShards;
+    ShardedRun run;
+    run.graph = graph;
+    run.parent = getpid();
+    if (!mapSharedRegion(&run))
+        return -1;
+
+    // Private buffers are allocated here, since the processes must not call
+    // malloc after forking a process that may have other threads
+    run.scratchOffset = (size_t*) trackedMalloc(MEM_BUFFERS, ((size_t)numShards + 1) * sizeof(size_t));
+    run.scratchOffset[0] = 0;
+    for (int s = 0; s < numShards; s++) {
+        run.scratchOffset[s + 1] = run.scratchOffset[s] + 4 * (size_t)graph->shards[s].numNodes +
+                                   3 * (size_t)graph->shards[s].numSlots;
+    }
+    run.scratch = (int*) trackedMalloc(MEM_BUFFERS, (run.scratchOffset[numShards] > 0 ? run.scratchOffset[numShards] : 1) * sizeof(int));
+
+    pid_t group = 0;
+    int numStarted = 0;
+    for (; numStarted < numShards; numStarted++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            setpgid(0, group);
+            while (atomic_load(&run.control->start) == 0) {
+                if (getppid() != run.parent)
+                    _exit(EXIT_FAILURE);
+                sched_yield();
+            }
+            if (atomic_load(&run.control->start) > 0)
+                runShard(&run, numStarted, src);
+            _exit(EXIT_SUCCESS);
+        }
+        if (pid < 0) {
+            perror("fork");
+            break;
+        }
+        // Set by both sides, so the group exists before either goes on
+        setpgid(pid, group);
+        if (group == 0)
+            group = pid;
+    }
+    atomic_store(&run.control->start, numStarted == numShards ? 1 : -1);
+
+    if (numStarted == 0 || !waitForShards(&run, group, numStarted) || numStarted < numShards) {
+        fprintf(stderr, "The sharded run failed: a shard process could not be started or did not finish.\n");
+        trackedFree(MEM_BUFFERS, run.scratch);
+        trackedFree(MEM_BUFFERS, run.scratchOffset);
+        unmapSharedRegion(&run);
+        return -1;
+    }
+
+    for (int v = 0; v < graph->numNodes; v++) {
+        dist[v] = run.dist[v];
+    }
+    for (int s = 0; s < numShards; s++) {
+        COUNT_OPERATIONS(OP_RELAXATIONS, run.stats[s].relaxations);
+        COUNT_OPERATIONS(OP_IMPROVEMENTS, run.stats[s].improvements);
+        COUNT_OPERATIONS(OP_MESSAGES, run.stats[s].messages);
+    }
+    COUNT_OPERATIONS(OP_ROUNDS, run.control->supersteps);
+    int negativeCycle = run.control->negativeCycle;
+
+    trackedFree(MEM_BUFFERS, run.scratch);
+    trackedFree(MEM_BUFFERS, run.scratchOffset);
+    unmapSharedRegion(&run);
+    return negativeCycle;
+}
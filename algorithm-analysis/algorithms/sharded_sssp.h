@@ -0,0 +1,16 @@
+//
+//  sharded_sssp.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef sharded_sssp_h
+#define sharded_sssp_h
+
+#include <stdio.h>
+#include "sharded_graph.h"
+
+int shardedBellmanFordDistances(ShardedGraph* graph, int src, int* dist);
+
+#endif /* sharded_sssp_h */
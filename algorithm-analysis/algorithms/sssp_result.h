@@ -0,0 +1,25 @@
+//
+//  sssp_result.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef sssp_result_h
+#define sssp_result_h
+
+#include <stdio.h>
+
+/**
+ * @brief Result of a shortest path run towards one destination. The
+ * algorithms return it instead of printing, so that printing stays out of the
+ * timed region; see printShortestPathResult and the JSON-lines run records.
+ */
+typedef struct {
+    int src;
+    int dest;
+    int distance;           // INT_MAX if dest is unreachable
+    int negativeCycle;      // 1 if a negative cycle reachable from src was found (distance is then meaningless)
+} ShortestPathResult;
+
+#endif /* sssp_result_h */
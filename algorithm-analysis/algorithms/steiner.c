@@ -0,0 +1,500 @@
+//
+//  steiner.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "steiner.h"
+#include <stdlib.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "memory_stats.h"
+#include "priority_queue.h"
+#include "multi_source.h"
+
+/**
+ * @brief Appends an edge to the tree and adds its weight to the cost. Tree edges
+ * use plain malloc because trees built by a worker thread are freed by another
+ * one, and the memory counters are kept per thread.
+ */
+static void appendTreeEdge(SteinerTree* tree, int* capacity, int src, int dest, int weight) {
+    if (tree->numEdges == *capacity) {
+        *capacity = *capacity ? *capacity * 2 : 64;
+        tree->edges = (TreeEdge*) realloc(tree->edges, *capacity * sizeof(TreeEdge));
+    }
+    tree->edges[tree->numEdges++] = (TreeEdge) { src, dest, weight };
+    tree->cost += weight;
+}
+
+static void initSteinerTree(SteinerTree* tree, int root) {
+    tree->edges = NULL;
+    tree->numEdges = 0;
+    tree->cost = 0;
+    tree->root = root;
+    tree->spansTerminals = true;
+}
+
+static int numProcessors(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+/**
+ * @brief Runs Dijkstra's algorithm from the vertices already in the queue,
+ * keeping the distances computed so far. Terminals whose distance improves
+ * are pushed to the terminal queue.
+ */
+static void growDistances(Graph* graph, LazyQueue* queue, LazyQueue* terminalQueue,
+                          int* dist, int* pred, const bool* isTerminal, const bool* inTree) {
+    while (!lazyQueueIsEmpty(queue)) {
+        QueueEntry entry = lazyQueuePop(queue);
+        int u = entry.vertex;
+        if (entry.key != dist[u])
+            continue;
+
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            if (dist[u] + node->weight < dist[v]) {
+                dist[v] = dist[u] + node->weight;
+                pred[v] = u;
+                lazyQueuePush(queue, v, dist[v]);
+                if (isTerminal[v] && !inTree[v])
+                    lazyQueuePush(terminalQueue, v, dist[v]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Shortest path heuristic of Takahashi and Matsuyama.
+ *
+ * The tree starts at the root and, at each step, the terminal nearest to the
+ * tree is connected to it through a shortest path. Instead of one Dijkstra run
+ * per step, the distances to the tree are kept between steps: the vertices of
+ * each new path become sources with distance 0 and only the vertices that get
+ * closer to the tree are visited again.
+ *
+ * @param graph Pointer to the graph.
+ * @param terminals Array with the terminal vertices.
+ * @param numTerminals Number of terminals.
+ * @param root Vertex the tree is grown from (usually a terminal).
+ * @param tree Output parameter with the tree. It must be freed with freeSteinerTree.
+ * @return 1 if the tree spans all terminals, 0 if some terminal is unreachable.
+ */
+int steinerShortestPath(Graph* graph, const int* terminals, int numTerminals, int root, SteinerTree* tree) {
+    int numNodes = graph->numNodes;
+    int* dist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* pred = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    bool* isTerminal = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+    bool* inTree = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+    int capacity = 0, remaining = 0;
+    LazyQueue queue, terminalQueue;
+
+    initSteinerTree(tree, root);
+    initLazyQueue(&queue);
+    initLazyQueue(&terminalQueue);
+
+    for (int i = 0; i < numTerminals; i++) {
+        if (!isTerminal[terminals[i]] && terminals[i] != root)
+            remaining++;
+        isTerminal[terminals[i]] = true;
+    }
+    for (int i = 0; i < numNodes; i++) {
+        dist[i] = INT_MAX;
+        pred[i] = -1;
+    }
+
+    dist[root] = 0;
+    inTree[root] = true;
+    lazyQueuePush(&queue, root, 0);
+    growDistances(graph, &queue, &terminalQueue, dist, pred, isTerminal, inTree);
+
+    while (remaining > 0) {
+        int t = -1;
+        while (!lazyQueueIsEmpty(&terminalQueue)) {
+            QueueEntry entry = lazyQueuePop(&terminalQueue);
+            if (!inTree[entry.vertex] && entry.key == dist[entry.vertex]) {
+                t = entry.vertex;
+                break;
+            }
+        }
+        if (t < 0) {
+            tree->spansTerminals = false;
+            break;
+        }
+
+        // Walk back to the tree; the path vertices become sources
+        for (int v = t; !inTree[v]; v = pred[v]) {
+            int p = pred[v];
+            appendTreeEdge(tree, &capacity, p, v, dist[v] - dist[p]);
+            inTree[v] = true;
+            if (isTerminal[v])
+                remaining--;
+            dist[v] = 0;
+            lazyQueuePush(&queue, v, 0);
+        }
+        growDistances(graph, &queue, &terminalQueue, dist, pred, isTerminal, inTree);
+    }
+
+    freeLazyQueue(&queue);
+    freeLazyQueue(&terminalQueue);
+    trackedFree(MEM_BUFFERS, dist);
+    trackedFree(MEM_BUFFERS, pred);
+    trackedFree(MEM_BUFFERS, isTerminal);
+    trackedFree(MEM_BUFFERS, inTree);
+
+    return tree->spansTerminals;
+}
+
+/**
+ * @brief Work shared by the threads of the multi-start heuristic.
+ */
+typedef struct {
+    Graph* graph;
+    const int* terminals;
+    int numTerminals;
+    int numRoots;
+    atomic_int nextRoot;
+} MultiStartJob;
+
+/**
+ * @brief Best tree found by one thread, with the index of its root.
+ */
+typedef struct {
+    MultiStartJob* job;
+    SteinerTree best;
+    int bestIndex;
+} MultiStartWorker;
+
+static bool isBetterTree(const SteinerTree* tree, int index, const SteinerTree* best, int bestIndex) {
+    if (bestIndex < 0)
+        return true;
+    if (tree->spansTerminals != best->spansTerminals)
+        return tree->spansTerminals;
+    if (tree->cost != best->cost)
+        return tree->cost < best->cost;
+    return index < bestIndex;
+}
+
+static void* multiStartWorker(void* arg) {
+    MultiStartWorker* worker = (MultiStartWorker*) arg;
+    MultiStartJob* job = worker->job;
+
+    for (;;) {
+        int index = atomic_fetch_add(&job->nextRoot, 1);
+        if (index >= job->numRoots)
+            break;
+
+        // Roots are spread evenly over the terminal list
+        int root = job->terminals[(long long)index * job->numTerminals / job->numRoots];
+        SteinerTree tree;
+        steinerShortestPath(job->graph, job->terminals, job->numTerminals, root, &tree);
+
+        if (isBetterTree(&tree, index, &worker->best, worker->bestIndex)) {
+            if (worker->bestIndex >= 0)
+                freeSteinerTree(&worker->best);
+            worker->best = tree;
+            worker->bestIndex = index;
+        } else {
+            freeSteinerTree(&tree);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Runs the shortest path heuristic from several terminals in parallel
+ * and keeps the cheapest tree. Ties are broken by the position of the root, so
+ * the result does not depend on the number of threads.
+ *
+ * @param graph Pointer to the graph.
+ * @param terminals Array with the terminal vertices.
+ * @param numTerminals Number of terminals (at least 1).
+ * @param numRoots Number of terminals used as roots (all of them if < 1).
+ * @param numThreads Number of threads (one per processor if < 1).
+ * @param tree Output parameter with the best tree. It must be freed with freeSteinerTree.
+ * @return 1 if the tree spans all terminals, 0 if some terminal is unreachable.
+ */
+int steinerShortestPathMultiStart(Graph* graph, const int* terminals, int numTerminals,
+                                  int numRoots, int numThreads, SteinerTree* tree) {
+    if (numRoots < 1 || numRoots > numTerminals)
+        numRoots = numTerminals;
+    if (numThreads < 1)
+        numThreads = numProcessors();
+    if (numThreads > numRoots)
+        numThreads = numRoots;
+
+    MultiStartJob job = { graph, terminals, numTerminals, numRoots, 0 };
+    MultiStartWorker* workers = (MultiStartWorker*) malloc(numThreads * sizeof(MultiStartWorker));
+    pthread_t* threads = (pthread_t*) malloc(numThreads * sizeof(pthread_t));
+
+    for (int i = 0; i < numThreads; i++) {
+        workers[i].job = &job;
+        workers[i].bestIndex = -1;
+    }
+    for (int i = 1; i < numThreads; i++) {
+        pthread_create(&threads[i], NULL, multiStartWorker, &workers[i]);
+    }
+    multiStartWorker(&workers[0]);
+
+    int bestWorker = 0;
+    for (int i = 1; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    for (int i = 1; i < numThreads; i++) {
+        if (workers[i].bestIndex >= 0 &&
+            isBetterTree(&workers[i].best, workers[i].bestIndex, &workers[bestWorker].best, workers[bestWorker].bestIndex)) {
+            bestWorker = i;
+        }
+    }
+    for (int i = 0; i < numThreads; i++) {
+        if (i != bestWorker && workers[i].bestIndex >= 0)
+            freeSteinerTree(&workers[i].best);
+    }
+
+    *tree = workers[bestWorker].best;
+    free(workers);
+    free(threads);
+    return tree->spansTerminals;
+}
+
+/**
+ * @brief Edge of the distance network between two Voronoi cells: the path from
+ * the terminal of src to src, the graph edge (src, dest) and the path from dest
+ * to its terminal.
+ */
+typedef struct {
+    long long cost;
+    int src;
+    int dest;
+    int weight;
+} BoundaryEdge;
+
+/**
+ * @brief Boundary edges found by one thread in its range of vertices. Like the
+ * tree edges, they are allocated with plain malloc since the calling thread
+ * frees them.
+ */
+typedef struct {
+    Graph* graph;
+    const int* dist;
+    const int* nearest;
+    int first;
+    int last;
+    BoundaryEdge* edges;
+    int numEdges;
+} BoundaryScan;
+
+static void* scanBoundaryEdges(void* arg) {
+    BoundaryScan* scan = (BoundaryScan*) arg;
+    const int* nearest = scan->nearest;
+    int capacity = 0;
+
+    scan->edges = NULL;
+    scan->numEdges = 0;
+    for (int u = scan->first; u < scan->last; u++) {
+        if (nearest[u] < 0)
+            continue;
+        for (AdjNode* node = scan->graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            // Each undirected edge is seen from both ends; keep it once
+            if (u >= v || nearest[v] < 0 || nearest[u] == nearest[v])
+                continue;
+            if (scan->numEdges == capacity) {
+                capacity = capacity ? capacity * 2 : 64;
+                scan->edges = (BoundaryEdge*) realloc(scan->edges, capacity * sizeof(BoundaryEdge));
+            }
+            long long cost = (long long)scan->dist[u] + node->weight + scan->dist[v];
+            scan->edges[scan->numEdges++] = (BoundaryEdge) { cost, u, v, node->weight };
+        }
+    }
+    return NULL;
+}
+
+static int compareBoundaryEdges(const void* a, const void* b) {
+    const BoundaryEdge* x = (const BoundaryEdge*) a;
+    const BoundaryEdge* y = (const BoundaryEdge*) b;
+    if (x->cost != y->cost)
+        return x->cost < y->cost ? -1 : 1;
+    if (x->src != y->src)
+        return x->src < y->src ? -1 : 1;
+    if (x->dest != y->dest)
+        return x->dest < y->dest ? -1 : 1;
+    return (x->weight > y->weight) - (x->weight < y->weight);
+}
+
+static int findSet(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * @brief Adds the shortest path from a vertex to the terminal of its Voronoi
+ * cell, stopping at the first vertex whose path was already added.
+ */
+static void appendPathToTerminal(SteinerTree* tree, int* capacity, int v,
+                                 const int* dist, const int* pred, bool* onTree) {
+    while (pred[v] >= 0 && !onTree[v]) {
+        onTree[v] = true;
+        appendTreeEdge(tree, capacity, pred[v], v, dist[v] - dist[pred[v]]);
+        v = pred[v];
+    }
+}
+
+/**
+ * @brief Distance network heuristic of Mehlhorn.
+ *
+ * A single multi-source Dijkstra from all terminals splits the graph into
+ * Voronoi cells. Every edge between two cells gives an edge of the distance
+ * network between their terminals, and the minimum spanning tree of that
+ * network (Kruskal) is expanded back to the paths it stands for. The scan of
+ * the edges between cells is split over the threads.
+ *
+ * @param graph Pointer to the graph.
+ * @param terminals Array with the terminal vertices.
+ * @param numTerminals Number of terminals.
+ * @param numThreads Number of threads for the boundary scan (one per processor if < 1).
+ * @param tree Output parameter with the tree. It must be freed with freeSteinerTree.
+ * @return 1 if the tree spans all terminals, 0 if some terminal is unreachable.
+ */
+int steinerMehlhorn(Graph* graph, const int* terminals, int numTerminals, int numThreads, SteinerTree* tree) {
+    int numNodes = graph->numNodes;
+    int* dist = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* pred = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* nearest = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int capacity = 0;
+
+    initSteinerTree(tree, -1);
+    multiSourceDijkstra(graph, terminals, numTerminals, NULL, 0, dist, pred, nearest, NULL);
+
+    if (numThreads < 1)
+        numThreads = numProcessors();
+    if (numThreads > numNodes)
+        numThreads = numNodes > 0 ? numNodes : 1;
+
+    BoundaryScan* scans = (BoundaryScan*) malloc(numThreads * sizeof(BoundaryScan));
+    pthread_t* threads = (pthread_t*) malloc(numThreads * sizeof(pthread_t));
+    for (int i = 0; i < numThreads; i++) {
+        scans[i] = (BoundaryScan) { graph, dist, nearest,
+            (int)((long long)i * numNodes / numThreads), (int)((long long)(i + 1) * numNodes / numThreads), NULL, 0 };
+    }
+    for (int i = 1; i < numThreads; i++) {
+        pthread_create(&threads[i], NULL, scanBoundaryEdges, &scans[i]);
+    }
+    scanBoundaryEdges(&scans[0]);
+    for (int i = 1; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    int numBoundary = 0;
+    for (int i = 0; i < numThreads; i++) {
+        numBoundary += scans[i].numEdges;
+    }
+    BoundaryEdge* boundary = (BoundaryEdge*) trackedMalloc(MEM_BUFFERS, (numBoundary > 0 ? numBoundary : 1) * sizeof(BoundaryEdge));
+    for (int i = 0, offset = 0; i < numThreads; i++) {
+        for (int j = 0; j < scans[i].numEdges; j++) {
+            boundary[offset++] = scans[i].edges[j];
+        }
+        free(scans[i].edges);
+    }
+    free(scans);
+    free(threads);
+    qsort(boundary, numBoundary, sizeof(BoundaryEdge), compareBoundaryEdges);
+
+    // Kruskal over the terminals, expanding each accepted edge into its path
+    int* parent = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    bool* onTree = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+    int components = 0;
+    for (int i = 0; i < numNodes; i++) {
+        parent[i] = i;
+    }
+    for (int i = 0; i < numTerminals; i++) {
+        if (!onTree[terminals[i]])
+            components++;
+        onTree[terminals[i]] = true;
+    }
+
+    for (int i = 0; i < numBoundary && components > 1; i++) {
+        BoundaryEdge* edge = &boundary[i];
+        int a = findSet(parent, nearest[edge->src]);
+        int b = findSet(parent, nearest[edge->dest]);
+        if (a == b)
+            continue;
+        parent[a] = b;
+        components--;
+
+        appendTreeEdge(tree, &capacity, edge->src, edge->dest, edge->weight);
+        appendPathToTerminal(tree, &capacity, edge->src, dist, pred, onTree);
+        appendPathToTerminal(tree, &capacity, edge->dest, dist, pred, onTree);
+    }
+    tree->spansTerminals = components <= 1;
+
+    trackedFree(MEM_BUFFERS, boundary);
+    trackedFree(MEM_BUFFERS, parent);
+    trackedFree(MEM_BUFFERS, onTree);
+    trackedFree(MEM_BUFFERS, dist);
+    trackedFree(MEM_BUFFERS, pred);
+    trackedFree(MEM_BUFFERS, nearest);
+
+    return tree->spansTerminals;
+}
+
+/**
+ * @brief Checks that a tree is made of edges of the graph, has no cycles,
+ * connects all terminals and that its cost is the sum of its edges.
+ *
+ * @param graph Pointer to the graph.
+ * @param terminals Array with the terminal vertices.
+ * @param numTerminals Number of terminals.
+ * @param tree The tree to be checked.
+ * @return true if the tree is a valid Steiner tree.
+ */
+bool checkSteinerTree(Graph* graph, const int* terminals, int numTerminals, const SteinerTree* tree) {
+    int numNodes = graph->numNodes;
+    int* parent = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    bool valid = true;
+    long long cost = 0;
+
+    for (int i = 0; i < numNodes; i++) {
+        parent[i] = i;
+    }
+
+    for (int i = 0; i < tree->numEdges && valid; i++) {
+        const TreeEdge* edge = &tree->edges[i];
+        AdjNode* node = graph->adjLists[edge->src];
+        while (node != NULL && (node->dest != edge->dest || node->weight != edge->weight)) {
+            node = node->next;
+        }
+        int a = findSet(parent, edge->src);
+        int b = findSet(parent, edge->dest);
+        if (node == NULL || a == b) {
+            valid = false;
+        }
+        parent[a] = b;
+        cost += edge->weight;
+    }
+
+    for (int i = 1; i < numTerminals && valid; i++) {
+        valid = findSet(parent, terminals[i]) == findSet(parent, terminals[0]);
+    }
+
+    trackedFree(MEM_BUFFERS, parent);
+    return valid && cost == tree->cost;
+}
+
+/**
+ * @brief Frees the edges of a tree.
+ *
+ * @param tree Pointer to the tree.
+ */
+void freeSteinerTree(SteinerTree* tree) {
+    free(tree->edges);
+    tree->edges = NULL;
+    tree->numEdges = 0;
+}
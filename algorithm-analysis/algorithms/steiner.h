@@ -0,0 +1,43 @@
+//
+//  steiner.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef steiner_h
+#define steiner_h
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "graph.h"
+
+/**
+ * @brief Edge of a Steiner tree.
+ */
+typedef struct {
+    int src;
+    int dest;
+    int weight;
+} TreeEdge;
+
+/**
+ * @brief Steiner tree built by one of the heuristics. The graph must store every
+ * edge in both directions, as the .stp loader does.
+ */
+typedef struct {
+    TreeEdge* edges;
+    int numEdges;
+    long long cost;             // Sum of the weights of the edges
+    int root;                   // Terminal the tree was grown from (-1 if not applicable)
+    bool spansTerminals;        // false if some terminal is unreachable
+} SteinerTree;
+
+int steinerShortestPath(Graph* graph, const int* terminals, int numTerminals, int root, SteinerTree* tree);
+int steinerShortestPathMultiStart(Graph* graph, const int* terminals, int numTerminals,
+                                  int numRoots, int numThreads, SteinerTree* tree);
+int steinerMehlhorn(Graph* graph, const int* terminals, int numTerminals, int numThreads, SteinerTree* tree);
+bool checkSteinerTree(Graph* graph, const int* terminals, int numTerminals, const SteinerTree* tree);
+void freeSteinerTree(SteinerTree* tree);
+
+#endif /* steiner_h */
@@ -0,0 +1,124 @@
+//
+//  undirected_sssp.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "undirected_sssp.h"
+#include <stdlib.h>
+#include <limits.h>
+#include "memory_stats.h"
+#include "priority_queue.h"
+#include "operation_stats.h"
+
+/**
+ * @brief Bellman-Ford over the undirected edge array. Each round reads every
+ * edge once and relaxes it in both directions, so it moves half the data of a
+ * round of bellmanFordImprovedDistances over the two arcs of each edge. The
+ * rounds are otherwise the same.
+ *
+ * @param graph Pointer to the undirected graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ * @return 1 if the graph contains a negative weight cycle reachable from src
+ *         (any reachable negative edge is one, since it can be walked back and forth).
+ */
+int bellmanFordUndirectedDistances(UndirectedGraph* graph, int src, int* dist) {
+    int numNodes = graph->numNodes;
+    int* buffer = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int* current = dist;
+    int* newDist = buffer;
+    const UndirectedEdge* edges = graph->edges;
+
+    for (int i = 0; i < numNodes; i++) {
+        current[i] = INT_MAX;
+    }
+    current[src] = 0;
+
+    // Relax all edges numNodes - 1 times
+    for (int i = 1; i < numNodes; i++) {
+        for (int j = 0; j < numNodes; j++) {
+            newDist[j] = current[j];
+        }
+        for (int e = 0; e < graph->numEdges; e++) {
+            int u = edges[e].u, v = edges[e].v, weight = edges[e].weight;
+            COUNT_OPERATIONS(OP_RELAXATIONS, 2);
+            if (current[u] != INT_MAX && current[u] + weight < newDist[v]) {
+                COUNT_IMPROVEMENT(newDist[v]);
+                newDist[v] = current[u] + weight;
+            }
+            if (current[v] != INT_MAX && current[v] + weight < newDist[u]) {
+                COUNT_IMPROVEMENT(newDist[u]);
+                newDist[u] = current[v] + weight;
+            }
+        }
+        END_ROUND(countChangedDistances(current, newDist, numNodes));
+        int* temp = current;
+        current = newDist;
+        newDist = temp;
+    }
+
+    // Check for negative weight cycles
+    int negativeCycle = 0;
+    for (int e = 0; e < graph->numEdges; e++) {
+        int u = edges[e].u, v = edges[e].v, weight = edges[e].weight;
+        if ((current[u] != INT_MAX && current[u] + weight < current[v]) ||
+            (current[v] != INT_MAX && current[v] + weight < current[u])) {
+            negativeCycle = 1;
+            break;
+        }
+    }
+
+    // The final distances may have ended in the scratch buffer
+    if (current != dist) {
+        for (int j = 0; j < numNodes; j++) {
+            dist[j] = current[j];
+        }
+    }
+
+    trackedFree(MEM_BUFFERS, buffer);
+    return negativeCycle;
+}
+
+/**
+ * @brief Dijkstra's algorithm over the incidence lists of the undirected graph,
+ * with the lazy binary heap. Edge weights must be non-negative.
+ *
+ * @param graph Pointer to the undirected graph.
+ * @param src The source node.
+ * @param dist Array of numNodes entries that receives the distances (INT_MAX if unreachable).
+ */
+void dijkstraUndirectedDistances(UndirectedGraph* graph, int src, int* dist) {
+    const UndirectedEdge* edges = graph->edges;
+    LazyQueue queue;
+
+    for (int i = 0; i < graph->numNodes; i++) {
+        dist[i] = INT_MAX;
+    }
+    dist[src] = 0;
+
+    initLazyQueue(&queue);
+    lazyQueuePush(&queue, src, 0);
+
+    while (!lazyQueueIsEmpty(&queue)) {
+        QueueEntry entry = lazyQueuePop(&queue);
+        int u = entry.vertex;
+        if (entry.key != dist[u])
+            continue;
+
+        for (int i = graph->firstIncident[u]; i < graph->firstIncident[u + 1]; i++) {
+            const UndirectedEdge* edge = &edges[graph->incident[i]];
+            int v = edge->u ^ edge->v ^ u;
+            COUNT_OPERATION(OP_RELAXATIONS);
+            if (dist[u] + edge->weight < dist[v]) {
+                COUNT_IMPROVEMENT(dist[v]);
+                dist[v] = dist[u] + edge->weight;
+                lazyQueuePush(&queue, v, dist[v]);
+            }
+        }
+        END_SETTLE();
+    }
+
+    freeLazyQueue(&queue);
+}
@@ -0,0 +1,17 @@
+//
+//  undirected_sssp.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef undirected_sssp_h
+#define undirected_sssp_h
+
+#include <stdio.h>
+#include "undirected_graph.h"
+
+int bellmanFordUndirectedDistances(UndirectedGraph* graph, int src, int* dist);
+void dijkstraUndirectedDistances(UndirectedGraph* graph, int src, int* dist);
+
+#endif /* undirected_sssp_h */
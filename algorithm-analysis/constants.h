@@ -14,9 +14,19 @@
 #define DMXA "/DMXA"
 #define TEST_SET1 "/test_set1"
 #define TEST_SET2 "/test_set2"
+#define SYNTHETIC "/synthetic"
+#define COST_MODEL_FILE "/cost_model.txt"
 
 #define MAX_LINE_LENGTH 256
 
+#define BINARY_GRAPH_MAGIC "AAGB"
+#define BINARY_GRAPH_EXTENSION ".bin"
+
+#define HUB_LABELS_MAGIC "AAH2"
+#define HUB_LABELS_EXTENSION ".hl"
+
+#define SERVER_SOCKET_PATH "/tmp/algorithm-analysis.sock"
+
 #define ERROR_MSG_SELECT_FILE "Failed to select a file.\n"
 #define ERROR_MSG_PROCESS_FILE "Failed to process the file.\n"
 #define ERROR_MSG_INVALID_CHOICE "Invalid choice.\n"
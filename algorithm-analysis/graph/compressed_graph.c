@@ -0,0 +1,158 @@
+//
+//  compressed_graph.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "compressed_graph.h"
+#include <stdlib.h>
+#include "memory_stats.h"
+
+typedef struct {
+    int dest;
+    int weight;
+} Arc;
+
+static int compareArcs(const void* a, const void* b) {
+    const Arc* x = (const Arc*) a;
+    const Arc* y = (const Arc*) b;
+    if (x->dest != y->dest)
+        return x->dest < y->dest ? -1 : 1;
+    return (x->weight > y->weight) - (x->weight < y->weight);
+}
+
+static int varintSize(uint32_t value) {
+    int size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+static unsigned char* writeVarint(unsigned char* p, uint32_t value) {
+    while (value >= 0x80) {
+        *p++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (unsigned char)value;
+    return p;
+}
+
+static uint32_t zigzag(int value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+/**
+ * @brief Copies the arcs of a node and sorts them by destination.
+ *
+ * @return Number of arcs copied.
+ */
+static int sortedArcs(Graph* graph, int u, Arc* arcs) {
+    int degree = 0;
+    for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+        arcs[degree++] = (Arc) { node->dest, node->weight };
+    }
+    qsort(arcs, degree, sizeof(Arc), compareArcs);
+    return degree;
+}
+
+/**
+ * @brief Builds the compressed adjacency of a graph. The graph is not modified
+ * and can be freed afterwards.
+ *
+ * @param graph Pointer to the graph.
+ * @return Pointer to the compressed graph, or NULL if it needs more than 4 GB.
+ */
+CompressedGraph* compressGraph(Graph* graph) {
+    int numNodes = graph->numNodes;
+    int maxDegree = 0, minWeight = 0, maxWeight = 0;
+
+    for (int u = 0; u < numNodes; u++) {
+        int degree = 0;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            degree++;
+            minWeight = node->weight < minWeight ? node->weight : minWeight;
+            maxWeight = node->weight > maxWeight ? node->weight : maxWeight;
+        }
+        maxDegree = degree > maxDegree ? degree : maxDegree;
+    }
+
+    int weightBytes = 4;
+    if (minWeight >= INT8_MIN && maxWeight <= INT8_MAX) {
+        weightBytes = 1;
+    } else if (minWeight >= INT16_MIN && maxWeight <= INT16_MAX) {
+        weightBytes = 2;
+    }
+
+    // First pass: size of each node's stream
+    Arc* arcs = (Arc*) trackedMalloc(MEM_BUFFERS, (maxDegree > 0 ? maxDegree : 1) * sizeof(Arc));
+    uint32_t* offsets = (uint32_t*) trackedMalloc(MEM_GRAPH, ((size_t)numNodes + 1) * sizeof(uint32_t));
+    unsigned long long size = 0;
+
+    for (int u = 0; u < numNodes; u++) {
+        offsets[u] = (uint32_t)size;
+        int degree = sortedArcs(graph, u, arcs);
+        for (int i = 0, prev = u; i < degree; prev = arcs[i].dest, i++) {
+            uint32_t gap = i == 0 ? zigzag(arcs[i].dest - u) : (uint32_t)(arcs[i].dest - prev);
+            size += varintSize(gap) + weightBytes;
+        }
+        if (size > UINT32_MAX) {
+            fprintf(stderr, "Graph is too large for the compressed adjacency\n");
+            trackedFree(MEM_BUFFERS, arcs);
+            trackedFree(MEM_GRAPH, offsets);
+            return NULL;
+        }
+    }
+    offsets[numNodes] = (uint32_t)size;
+
+    // Second pass: encode
+    CompressedGraph* compressed = (CompressedGraph*) trackedMalloc(MEM_GRAPH, sizeof(CompressedGraph));
+    compressed->numNodes = numNodes;
+    compressed->numEdges = graph->numEdges;
+    compressed->weightBytes = weightBytes;
+    compressed->offsets = offsets;
+    compressed->data = (unsigned char*) trackedMalloc(MEM_GRAPH, size > 0 ? size : 1);
+
+    for (int u = 0; u < numNodes; u++) {
+        unsigned char* p = compressed->data + offsets[u];
+        int degree = sortedArcs(graph, u, arcs);
+        for (int i = 0, prev = u; i < degree; prev = arcs[i].dest, i++) {
+            uint32_t gap = i == 0 ? zigzag(arcs[i].dest - u) : (uint32_t)(arcs[i].dest - prev);
+            p = writeVarint(p, gap);
+            if (weightBytes == 1) {
+                int8_t w = (int8_t)arcs[i].weight;
+                memcpy(p, &w, 1);
+            } else if (weightBytes == 2) {
+                int16_t w = (int16_t)arcs[i].weight;
+                memcpy(p, &w, 2);
+            } else {
+                int32_t w = arcs[i].weight;
+                memcpy(p, &w, 4);
+            }
+            p += weightBytes;
+        }
+    }
+
+    trackedFree(MEM_BUFFERS, arcs);
+    return compressed;
+}
+
+/**
+ * @brief Returns the number of bytes used by the arrays of a compressed graph.
+ */
+long long compressedGraphBytes(const CompressedGraph* graph) {
+    return ((long long)graph->numNodes + 1) * sizeof(uint32_t) + graph->offsets[graph->numNodes];
+}
+
+/**
+ * @brief Frees the memory allocated for a compressed graph.
+ *
+ * @param graph Pointer to the compressed graph.
+ */
+void freeCompressedGraph(CompressedGraph* graph) {
+    trackedFree(MEM_GRAPH, graph->offsets);
+    trackedFree(MEM_GRAPH, graph->data);
+    trackedFree(MEM_GRAPH, graph);
+}
@@ -0,0 +1,91 @@
+//
+//  compressed_graph.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef compressed_graph_h
+#define compressed_graph_h
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "graph.h"
+
+/**
+ * @brief Read-only adjacency storage with compressed neighbor lists.
+ *
+ * The arcs of each node are sorted by destination and stored in a byte stream
+ * as the gap to the previous destination, in LEB128 varint encoding (the first
+ * gap is taken from the node itself and zigzag encoded, since it may be
+ * negative). Each gap is followed by the weight in the narrowest signed width
+ * (1, 2 or 4 bytes) that holds every weight of the graph.
+ */
+typedef struct {
+    int numNodes;
+    int numEdges;               // Number of arcs
+    int weightBytes;            // Width of the stored weights: 1, 2 or 4
+    uint32_t* offsets;          // Arcs of node u are in data[offsets[u]] .. data[offsets[u + 1]]
+    unsigned char* data;
+} CompressedGraph;
+
+/**
+ * @brief Position in the arc stream of one node.
+ */
+typedef struct {
+    const unsigned char* pos;
+    const unsigned char* end;
+    int prev;                   // Destination of the previous arc
+    bool first;
+    int weightBytes;
+} ArcCursor;
+
+CompressedGraph* compressGraph(Graph* graph);
+long long compressedGraphBytes(const CompressedGraph* graph);
+void freeCompressedGraph(CompressedGraph* graph);
+
+/**
+ * @brief Positions a cursor on the first arc of a node.
+ */
+static inline void openArcs(const CompressedGraph* graph, int u, ArcCursor* cursor) {
+    cursor->pos = graph->data + graph->offsets[u];
+    cursor->end = graph->data + graph->offsets[u + 1];
+    cursor->prev = u;
+    cursor->first = true;
+    cursor->weightBytes = graph->weightBytes;
+}
+
+/**
+ * @brief Decodes the next arc of a node.
+ *
+ * @return true if an arc was decoded, false at the end of the list.
+ */
+static inline bool nextArc(ArcCursor* cursor, int* dest, int* weight) {
+    if (cursor->pos == cursor->end)
+        return false;
+
+    const unsigned char* p = cursor->pos;
+    uint32_t gap = *p & 0x7F;
+    for (int shift = 7; *p++ & 0x80; shift += 7) {
+        gap |= (uint32_t)(*p & 0x7F) << shift;
+    }
+    if (cursor->first) {
+        cursor->prev += (int)(gap >> 1) ^ -(int)(gap & 1);
+        cursor->first = false;
+    } else {
+        cursor->prev += (int)gap;
+    }
+    *dest = cursor->prev;
+
+    switch (cursor->weightBytes) {
+        case 1: *weight = (int8_t)*p; break;
+        case 2: { int16_t w; memcpy(&w, p, 2); *weight = w; break; }
+        default: { int32_t w; memcpy(&w, p, 4); *weight = w; break; }
+    }
+    cursor->pos = p + cursor->weightBytes;
+    return true;
+}
+
+#endif /* compressed_graph_h */
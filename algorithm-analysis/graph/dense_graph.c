@@ -0,0 +1,58 @@
+//
+//  dense_graph.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "dense_graph.h"
+#include <stdlib.h>
+#include "memory_stats.h"
+
+/**
+ * @brief Builds the weight matrix of a graph. The graph is not modified and
+ * can be freed afterwards.
+ *
+ * @param graph Pointer to the graph.
+ * @return Pointer to the dense graph, or NULL if the matrix needs more than
+ * DENSE_GRAPH_MAX_BYTES.
+ */
+DenseGraph* createDenseGraph(Graph* graph) {
+    long long numNodes = graph->numNodes;
+    if (numNodes * numNodes * (long long)sizeof(int) > DENSE_GRAPH_MAX_BYTES)
+        return NULL;
+
+    DenseGraph* dense = (DenseGraph*) trackedMalloc(MEM_GRAPH, sizeof(DenseGraph));
+    dense->numNodes = graph->numNodes;
+    dense->numEdges = graph->numEdges;
+    dense->weights = (int*) trackedMalloc(MEM_GRAPH, (numNodes * numNodes > 0 ? numNodes * numNodes : 1) * sizeof(int));
+
+    for (long long i = 0; i < numNodes * numNodes; i++) {
+        dense->weights[i] = DENSE_NO_ARC;
+    }
+    for (int u = 0; u < numNodes; u++) {
+        int* row = dense->weights + (size_t)u * numNodes;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            if (node->weight < row[node->dest])
+                row[node->dest] = node->weight;
+        }
+    }
+    return dense;
+}
+
+/**
+ * @brief Returns the number of bytes used by the matrix.
+ */
+long long denseGraphBytes(const DenseGraph* graph) {
+    return (long long)graph->numNodes * graph->numNodes * sizeof(int);
+}
+
+/**
+ * @brief Frees the memory allocated for a dense graph.
+ *
+ * @param graph Pointer to the dense graph.
+ */
+void freeDenseGraph(DenseGraph* graph) {
+    trackedFree(MEM_GRAPH, graph->weights);
+    trackedFree(MEM_GRAPH, graph);
+}
@@ -0,0 +1,42 @@
+//
+//  dense_graph.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef dense_graph_h
+#define dense_graph_h
+
+#include <stdio.h>
+#include <limits.h>
+#include "graph.h"
+
+// Density (arcs / (n (n - 1))) from which batch runs store a graph as a
+// matrix. A cell takes 4 bytes and a list node about 32 with the allocator's
+// overhead, so the matrix is also the smaller one well below this density.
+#define DENSE_GRAPH_MIN_DENSITY 0.25
+
+// Largest matrix built (n = 16384)
+#define DENSE_GRAPH_MAX_BYTES (1LL << 30)
+
+// Weight of the cells without an arc
+#define DENSE_NO_ARC INT_MAX
+
+/**
+ * @brief Graph stored as an n x n weight matrix, row u holding the arcs out of
+ * node u. Missing arcs are DENSE_NO_ARC; of parallel arcs only the lightest is
+ * kept. Rows are contiguous, so relaxing all arcs of a node is a linear scan
+ * that vectorizes.
+ */
+typedef struct {
+    int numNodes;
+    int numEdges;               // Arcs of the original graph
+    int* weights;               // weights[u * numNodes + v]
+} DenseGraph;
+
+DenseGraph* createDenseGraph(Graph* graph);
+long long denseGraphBytes(const DenseGraph* graph);
+void freeDenseGraph(DenseGraph* graph);
+
+#endif /* dense_graph_h */
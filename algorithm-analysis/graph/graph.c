@@ -8,6 +8,8 @@
 #include "graph.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include "memory_stats.h"
 
 /**
  * @brief Creates a new node.
@@ -16,7 +18,7 @@
  * @return A pointer to the newly created adjacency node.
  */
 AdjNode* createNode(int dest, int weight) {
-    AdjNode* newNode = (AdjNode*)malloc(sizeof(AdjNode));
+    AdjNode* newNode = (AdjNode*)trackedMalloc(MEM_GRAPH, sizeof(AdjNode));
     newNode->dest = dest;
     newNode->weight = weight;
     newNode->next = NULL;
@@ -29,9 +31,12 @@ AdjNode* createNode(int dest, int weight) {
  * @return A pointer to the newly created graph.
  */
 Graph* createGraph(int numNodes) {
-    Graph* graph = (Graph*)malloc(sizeof(Graph));
+    Graph* graph = (Graph*)trackedMalloc(MEM_GRAPH, sizeof(Graph));
     graph->numNodes = numNodes;
-    graph->adjLists = (AdjNode**)malloc(numNodes * sizeof(AdjNode*));
+    graph->numEdges = 0;
+    graph->numTerminals = 0;
+    graph->terminals = NULL;
+    graph->adjLists = (AdjNode**)trackedMalloc(MEM_GRAPH, numNodes * sizeof(AdjNode*));
 
     for (int i = 0; i < numNodes; i++) {
         graph->adjLists[i] = NULL;
@@ -53,6 +58,76 @@ void addEdge(Graph* graph, int src, int dest, int weight) {
     graph->numEdges++;
 }
 
+/**
+ * @brief Finds the first edge from src to dest.
+ * @param graph The graph to search.
+ * @param src The source node of the edge.
+ * @param dest The destination node of the edge.
+ * @return A pointer to the adjacency node of the edge, or NULL if there is no such edge.
+ */
+AdjNode* findEdge(Graph* graph, int src, int dest) {
+    AdjNode* node = graph->adjLists[src];
+    while (node != NULL && node->dest != dest) {
+        node = node->next;
+    }
+    return node;
+}
+
+/**
+ * @brief Removes the first edge from src to dest.
+ * @param graph The graph from which the edge will be removed.
+ * @param src The source node of the edge.
+ * @param dest The destination node of the edge.
+ * @return 1 if an edge was removed, 0 if there is no such edge.
+ */
+int removeEdge(Graph* graph, int src, int dest) {
+    AdjNode** link = &graph->adjLists[src];
+    while (*link != NULL) {
+        if ((*link)->dest == dest) {
+            AdjNode* removed = *link;
+            *link = removed->next;
+            trackedFree(MEM_GRAPH, removed);
+            graph->numEdges--;
+            return 1;
+        }
+        link = &(*link)->next;
+    }
+    return 0;
+}
+
+/**
+ * @brief Sets the terminal nodes of the graph, replacing any previous ones.
+ * @param graph The graph.
+ * @param terminals Array with the terminal nodes.
+ * @param numTerminals Number of terminal nodes.
+ */
+void setTerminals(Graph* graph, const int* terminals, int numTerminals) {
+    trackedFree(MEM_GRAPH, graph->terminals);
+    graph->terminals = (int*)trackedMalloc(MEM_GRAPH, (numTerminals > 0 ? numTerminals : 1) * sizeof(int));
+    for (int i = 0; i < numTerminals; i++) {
+        graph->terminals[i] = terminals[i];
+    }
+    graph->numTerminals = numTerminals;
+}
+
+/**
+ * @brief Frees the memory allocated for the graph and all its edges.
+ * @param graph The graph to be freed.
+ */
+void freeGraph(Graph* graph) {
+    for (int i = 0; i < graph->numNodes; i++) {
+        AdjNode* adjList = graph->adjLists[i];
+        while (adjList != NULL) {
+            AdjNode* temp = adjList;
+            adjList = adjList->next;
+            trackedFree(MEM_GRAPH, temp);
+        }
+    }
+    trackedFree(MEM_GRAPH, graph->adjLists);
+    trackedFree(MEM_GRAPH, graph->terminals);
+    trackedFree(MEM_GRAPH, graph);
+}
+
 /**
  * @brief Prints the adjacency lists of the graph.
  *
@@ -112,3 +187,22 @@ GraphStats graphStatistics(Graph* graph) {
     }
     return stats;
 }
+
+/**
+ * @brief Finds the smallest and the largest edge weight of a graph.
+ *
+ * @param graph Pointer to the graph.
+ * @param minWeight Output parameter with the smallest weight (0 if there are no edges).
+ * @param maxWeight Output parameter with the largest weight (0 if there are no edges).
+ */
+void edgeWeightRange(Graph* graph, int* minWeight, int* maxWeight) {
+    int low = INT_MAX, high = INT_MIN;
+    for (int u = 0; u < graph->numNodes; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            low = node->weight < low ? node->weight : low;
+            high = node->weight > high ? node->weight : high;
+        }
+    }
+    *minWeight = low == INT_MAX ? 0 : low;
+    *maxWeight = high == INT_MIN ? 0 : high;
+}
@@ -10,6 +10,14 @@
 
 #include <stdio.h>
 
+// Software prefetch hint for data that will be read soon. Building with
+// -DNO_PREFETCH turns the hints off, to measure what they are worth.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(NO_PREFETCH)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)(address))
+#endif
+
 typedef struct AdjNode {
     int dest;
     int weight;
@@ -20,6 +28,8 @@ typedef struct Graph {
     int numNodes;
     int numEdges;
     AdjNode** adjLists;
+    int numTerminals;   // Terminal nodes of SteinLib instances (0 if none)
+    int* terminals;
 } Graph;
 
 typedef struct {
@@ -31,7 +41,12 @@ typedef struct {
 AdjNode* createNode(int dest, int weight);
 Graph* createGraph(int numNodes);
 void addEdge(Graph* graph, int src, int dest, int weight);
+AdjNode* findEdge(Graph* graph, int src, int dest);
+int removeEdge(Graph* graph, int src, int dest);
+void setTerminals(Graph* graph, const int* terminals, int numTerminals);
+void freeGraph(Graph* graph);
 void printAdjacencyList(Graph* graph);
 GraphStats graphStatistics(Graph* graph);
+void edgeWeightRange(Graph* graph, int* minWeight, int* maxWeight);
 
 #endif
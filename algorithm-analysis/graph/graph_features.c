@@ -0,0 +1,41 @@
+//
+//  graph_features.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "graph_features.h"
+#include <limits.h>
+
+/**
+ * @brief Computes the features of a graph.
+ *
+ * @param graph Pointer to the graph.
+ * @param features Output parameter with the features.
+ */
+void computeGraphFeatures(Graph* graph, GraphFeatures* features) {
+    int numNodes = graph->numNodes;
+    int numArcs = 0, maxDegree = 0, low = INT_MAX, high = INT_MIN;
+
+    for (int u = 0; u < numNodes; u++) {
+        int degree = 0;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            low = node->weight < low ? node->weight : low;
+            high = node->weight > high ? node->weight : high;
+            degree++;
+        }
+        numArcs += degree;
+        maxDegree = degree > maxDegree ? degree : maxDegree;
+    }
+
+    features->numNodes = numNodes;
+    features->numArcs = numArcs;
+    features->density = numNodes > 1 ? numArcs / ((double)numNodes * (numNodes - 1)) : 0;
+    features->averageDegree = numNodes > 0 ? (double)numArcs / numNodes : 0;
+    features->maxDegree = maxDegree;
+    features->degreeSkew = numArcs > 0 ? maxDegree / features->averageDegree : 1;
+    features->minWeight = low == INT_MAX ? 0 : low;
+    features->maxWeight = high == INT_MIN ? 0 : high;
+    features->negativeWeights = features->minWeight < 0;
+}
@@ -0,0 +1,33 @@
+//
+//  graph_features.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef graph_features_h
+#define graph_features_h
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "graph.h"
+
+/**
+ * @brief Cheap structural features of a graph, computed in one pass over the
+ * arcs. They are the inputs of the cost model that picks an algorithm.
+ */
+typedef struct {
+    int numNodes;
+    int numArcs;
+    double density;             // numArcs / (numNodes * (numNodes - 1))
+    double averageDegree;       // Out-degree
+    int maxDegree;
+    double degreeSkew;          // maxDegree / averageDegree (1 for regular graphs)
+    int minWeight;
+    int maxWeight;
+    bool negativeWeights;
+} GraphFeatures;
+
+void computeGraphFeatures(Graph* graph, GraphFeatures* features);
+
+#endif /* graph_features_h */
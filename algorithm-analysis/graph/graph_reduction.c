@@ -0,0 +1,379 @@
+//
+//  graph_reduction.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "graph_reduction.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "memory_stats.h"
+
+#define NO_ARC INT_MAX
+
+/**
+ * @brief The arcs between a node and one neighbor, seen from the node: the
+ * lightest arc to the neighbor and the lightest arc from it (NO_ARC if none).
+ */
+typedef struct {
+    int neighbor;
+    int out;
+    int in;
+} Link;
+
+/**
+ * @brief The reachable part of the graph as undirected neighborhoods that can
+ * lose nodes. The links of node v are links[first[v]] .. links[first[v] +
+ * degree[v] - 1]; the space reserved for a node never grows, since a
+ * contracted node frees a link in each of its neighbors before the arc
+ * between them is added.
+ */
+typedef struct {
+    Link* links;
+    int* first;
+    int* degree;
+} Neighborhoods;
+
+typedef struct {
+    int a;                  // a < b
+    int b;
+    int ab;                 // Lightest arc a -> b
+    int ba;                 // Lightest arc b -> a
+} NodePair;
+
+static int comparePairs(const void* x, const void* y) {
+    const NodePair* p = (const NodePair*) x;
+    const NodePair* q = (const NodePair*) y;
+    if (p->a != q->a)
+        return p->a < q->a ? -1 : 1;
+    return (p->b > q->b) - (p->b < q->b);
+}
+
+static inline int minArc(int x, int y) {
+    return x < y ? x : y;
+}
+
+/**
+ * @brief Marks the nodes the source reaches (breadth-first).
+ *
+ * @return Number of nodes reached, the source included.
+ */
+static int markReachable(Graph* graph, int src, bool* reachable) {
+    int* queue = (int*) trackedMalloc(MEM_BUFFERS, graph->numNodes * sizeof(int));
+    int head = 0, tail = 0;
+
+    reachable[src] = true;
+    queue[tail++] = src;
+    while (head < tail) {
+        int u = queue[head++];
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            if (!reachable[node->dest]) {
+                reachable[node->dest] = true;
+                queue[tail++] = node->dest;
+            }
+        }
+    }
+
+    trackedFree(MEM_BUFFERS, queue);
+    return tail;
+}
+
+/**
+ * @brief Builds the neighborhoods of the reachable nodes, merging the arcs
+ * of each pair of nodes. Self-loops are left out; the lightest one of every
+ * node is stored in loop.
+ */
+static Neighborhoods buildNeighborhoods(Graph* graph, const bool* reachable, int* loop) {
+    int numNodes = graph->numNodes;
+    NodePair* pairs = (NodePair*) trackedMalloc(MEM_BUFFERS, (graph->numEdges > 0 ? graph->numEdges : 1) * sizeof(NodePair));
+    int numPairs = 0;
+
+    for (int u = 0; u < numNodes; u++) {
+        loop[u] = NO_ARC;
+        if (!reachable[u])
+            continue;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            if (v == u) {
+                loop[u] = minArc(loop[u], node->weight);
+            } else if (u < v) {
+                pairs[numPairs++] = (NodePair) { u, v, node->weight, NO_ARC };
+            } else {
+                pairs[numPairs++] = (NodePair) { v, u, NO_ARC, node->weight };
+            }
+        }
+    }
+    qsort(pairs, numPairs, sizeof(NodePair), comparePairs);
+
+    // Merge the arcs of each pair
+    int numMerged = 0;
+    for (int i = 0; i < numPairs; i++) {
+        if (numMerged > 0 && pairs[numMerged - 1].a == pairs[i].a && pairs[numMerged - 1].b == pairs[i].b) {
+            pairs[numMerged - 1].ab = minArc(pairs[numMerged - 1].ab, pairs[i].ab);
+            pairs[numMerged - 1].ba = minArc(pairs[numMerged - 1].ba, pairs[i].ba);
+        } else {
+            pairs[numMerged++] = pairs[i];
+        }
+    }
+
+    Neighborhoods hoods;
+    hoods.first = (int*) trackedCalloc(MEM_BUFFERS, (size_t)numNodes + 1, sizeof(int));
+    hoods.degree = (int*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(int));
+    hoods.links = (Link*) trackedMalloc(MEM_BUFFERS, (numMerged > 0 ? 2 * (size_t)numMerged : 1) * sizeof(Link));
+    for (int i = 0; i < numMerged; i++) {
+        hoods.first[pairs[i].a + 1]++;
+        hoods.first[pairs[i].b + 1]++;
+    }
+    for (int v = 0; v < numNodes; v++) {
+        hoods.first[v + 1] += hoods.first[v];
+    }
+    for (int i = 0; i < numMerged; i++) {
+        NodePair* p = &pairs[i];
+        hoods.links[hoods.first[p->a] + hoods.degree[p->a]++] = (Link) { p->b, p->ab, p->ba };
+        hoods.links[hoods.first[p->b] + hoods.degree[p->b]++] = (Link) { p->a, p->ba, p->ab };
+    }
+
+    trackedFree(MEM_BUFFERS, pairs);
+    return hoods;
+}
+
+static Link* findLink(Neighborhoods* hoods, int v, int neighbor) {
+    Link* links = hoods->links + hoods->first[v];
+    for (int i = 0; i < hoods->degree[v]; i++) {
+        if (links[i].neighbor == neighbor)
+            return &links[i];
+    }
+    return NULL;
+}
+
+static void removeLink(Neighborhoods* hoods, int v, int neighbor) {
+    Link* link = findLink(hoods, v, neighbor);
+    *link = hoods->links[hoods->first[v] + --hoods->degree[v]];
+}
+
+/**
+ * @brief Adds the arc a -> b, or lowers the weight of the existing one.
+ */
+static void addArc(Neighborhoods* hoods, int a, int b, int weight) {
+    Link* link = findLink(hoods, a, b);
+    if (link == NULL) {
+        hoods->links[hoods->first[a] + hoods->degree[a]++] = (Link) { b, NO_ARC, NO_ARC };
+        hoods->links[hoods->first[b] + hoods->degree[b]++] = (Link) { a, NO_ARC, NO_ARC };
+        link = findLink(hoods, a, b);
+    }
+    link->out = minArc(link->out, weight);
+    Link* reverse = findLink(hoods, b, a);
+    reverse->in = minArc(reverse->in, weight);
+}
+
+/**
+ * @brief Tells whether the arcs between a node and a neighbor form a cycle of
+ * negative weight, which the reduction must keep.
+ */
+static bool negativeTwoCycle(const Link* link) {
+    return link->out != NO_ARC && link->in != NO_ARC && (long long)link->out + link->in < 0;
+}
+
+/**
+ * @brief Weight of the path a -> v -> b through the arcs a -> v and v -> b
+ * (NO_ARC if one of them is missing).
+ *
+ * @return false if the sum does not fit in an int.
+ */
+static bool pathWeight(int in, int out, int* weight) {
+    *weight = NO_ARC;
+    if (in == NO_ARC || out == NO_ARC)
+        return true;
+    long long sum = (long long)in + out;
+    if (sum < INT_MIN || sum >= NO_ARC)
+        return false;
+    *weight = (int)sum;
+    return true;
+}
+
+/**
+ * @brief Reduces a graph for the shortest paths from src, with the tests of
+ * SteinLib preprocessing:
+ *
+ * - nodes the source does not reach are dropped;
+ * - a node with a single neighbor u is removed; its distance is the distance
+ *   of u plus the arc u -> v;
+ * - a node v with two neighbors a and b is contracted: the paths a -> v -> b
+ *   and b -> v -> a become arcs (lowering existing ones), and its distance is
+ *   the best of the arcs a -> v and b -> v.
+ *
+ * Neighbors are counted in both directions, so the tests apply to directed
+ * graphs as well. Removing a node can lower the degree of its neighbors, so
+ * they are tested again, which collapses whole chains and hanging trees. The
+ * source, the terminals and the nodes with a negative self-loop are kept, as
+ * are the nodes in a negative cycle of two arcs with a neighbor, so negative
+ * cycles reachable from the source survive the reduction. Distances are
+ * expanded back with expandDistances.
+ *
+ * @param graph Pointer to the graph. It is not modified.
+ * @param src The source node.
+ * @return The reduction, to be freed with freeGraphReduction.
+ */
+GraphReduction* reduceGraph(Graph* graph, int src) {
+    int numNodes = graph->numNodes;
+    GraphReduction* reduction = (GraphReduction*) trackedMalloc(MEM_GRAPH, sizeof(GraphReduction));
+    reduction->originalNodes = numNodes;
+    reduction->originalArcs = graph->numEdges;
+    reduction->numRemoved = 0;
+    reduction->numLeaves = 0;
+    reduction->numChains = 0;
+
+    bool* kept = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+    reduction->numUnreachable = numNodes - markReachable(graph, src, kept);
+    int* loop = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    Neighborhoods hoods = buildNeighborhoods(graph, kept, loop);
+
+    bool* fixed = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+    fixed[src] = true;
+    for (int t = 0; t < graph->numTerminals; t++) {
+        fixed[graph->terminals[t]] = true;
+    }
+    for (int v = 0; v < numNodes; v++) {
+        fixed[v] |= loop[v] != NO_ARC && loop[v] < 0;
+    }
+
+    // Every reachable node is tested once, and again when a neighbor is removed
+    int* stack = (int*) trackedMalloc(MEM_BUFFERS, (numNodes > 0 ? numNodes : 1) * sizeof(int));
+    bool* stacked = (bool*) trackedCalloc(MEM_BUFFERS, numNodes, sizeof(bool));
+    int size = 0;
+    for (int v = numNodes - 1; v >= 0; v--) {
+        if (kept[v] && !fixed[v]) {
+            stack[size++] = v;
+            stacked[v] = true;
+        }
+    }
+    reduction->removed = (RemovedNode*) trackedMalloc(MEM_GRAPH, (size > 0 ? size : 1) * sizeof(RemovedNode));
+
+    while (size > 0) {
+        int v = stack[--size];
+        stacked[v] = false;
+        int degree = hoods.degree[v];
+        Link* links = hoods.links + hoods.first[v];
+        if (degree < 1 || degree > 2 || negativeTwoCycle(&links[0]) || (degree == 2 && negativeTwoCycle(&links[1])))
+            continue;
+
+        RemovedNode removed = { v, links[0].neighbor, links[0].in, -1, NO_ARC };
+        if (degree == 2) {
+            Link a = links[0], b = links[1];
+            int ab, ba;
+            if (!pathWeight(a.in, b.out, &ab) || !pathWeight(b.in, a.out, &ba))
+                continue;
+            removed.second = b.neighbor;
+            removed.secondWeight = b.in;
+            removeLink(&hoods, a.neighbor, v);
+            removeLink(&hoods, b.neighbor, v);
+            if (ab != NO_ARC)
+                addArc(&hoods, a.neighbor, b.neighbor, ab);
+            if (ba != NO_ARC)
+                addArc(&hoods, b.neighbor, a.neighbor, ba);
+            reduction->numChains++;
+        } else {
+            removeLink(&hoods, links[0].neighbor, v);
+            reduction->numLeaves++;
+        }
+        hoods.degree[v] = 0;
+        kept[v] = false;
+        reduction->removed[reduction->numRemoved++] = removed;
+
+        int neighbors[2] = { removed.first, removed.second };
+        for (int i = 0; i < degree; i++) {
+            int u = neighbors[i];
+            if (!fixed[u] && !stacked[u]) {
+                stack[size++] = u;
+                stacked[u] = true;
+            }
+        }
+    }
+
+    // Number the nodes that are left and copy their arcs
+    int* reducedId = (int*) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+    int numKept = 0;
+    for (int v = 0; v < numNodes; v++) {
+        reducedId[v] = kept[v] ? numKept++ : -1;
+    }
+    reduction->originalId = (int*) trackedMalloc(MEM_GRAPH, (numKept > 0 ? numKept : 1) * sizeof(int));
+    reduction->graph = createGraph(numKept);
+    for (int v = 0; v < numNodes; v++) {
+        if (!kept[v])
+            continue;
+        reduction->originalId[reducedId[v]] = v;
+        if (loop[v] < 0)
+            addEdge(reduction->graph, reducedId[v], reducedId[v], loop[v]);
+        Link* links = hoods.links + hoods.first[v];
+        for (int i = 0; i < hoods.degree[v]; i++) {
+            if (links[i].out != NO_ARC)
+                addEdge(reduction->graph, reducedId[v], reducedId[links[i].neighbor], links[i].out);
+        }
+    }
+    reduction->source = reducedId[src];
+
+    int numTerminals = 0;
+    int* terminals = (int*) trackedMalloc(MEM_BUFFERS, (graph->numTerminals > 0 ? graph->numTerminals : 1) * sizeof(int));
+    for (int t = 0; t < graph->numTerminals; t++) {
+        if (kept[graph->terminals[t]])
+            terminals[numTerminals++] = reducedId[graph->terminals[t]];
+    }
+    if (numTerminals > 0)
+        setTerminals(reduction->graph, terminals, numTerminals);
+
+    trackedFree(MEM_BUFFERS, terminals);
+    trackedFree(MEM_BUFFERS, reducedId);
+    trackedFree(MEM_BUFFERS, stack);
+    trackedFree(MEM_BUFFERS, stacked);
+    trackedFree(MEM_BUFFERS, fixed);
+    trackedFree(MEM_BUFFERS, loop);
+    trackedFree(MEM_BUFFERS, kept);
+    trackedFree(MEM_BUFFERS, hoods.links);
+    trackedFree(MEM_BUFFERS, hoods.first);
+    trackedFree(MEM_BUFFERS, hoods.degree);
+    return reduction;
+}
+
+static inline int extend(int distance, int weight) {
+    return distance == INT_MAX || weight == NO_ARC ? INT_MAX : distance + weight;
+}
+
+/**
+ * @brief Expands the distances computed on a reduced graph to every node of
+ * the original graph. The removed nodes are restored in the reverse order of
+ * their removal, so the neighbors each of them depends on already have their
+ * distances.
+ *
+ * @param reduction The reduction.
+ * @param reducedDist Distances from the source of the reduced graph.
+ * @param dist Array of originalNodes entries that receives the distances (INT_MAX if unreachable).
+ */
+void expandDistances(const GraphReduction* reduction, const int* reducedDist, int* dist) {
+    for (int v = 0; v < reduction->originalNodes; v++) {
+        dist[v] = INT_MAX;
+    }
+    for (int v = 0; v < reduction->graph->numNodes; v++) {
+        dist[reduction->originalId[v]] = reducedDist[v];
+    }
+    for (int i = reduction->numRemoved - 1; i >= 0; i--) {
+        const RemovedNode* removed = &reduction->removed[i];
+        int best = extend(dist[removed->first], removed->firstWeight);
+        if (removed->second >= 0)
+            best = minArc(best, extend(dist[removed->second], removed->secondWeight));
+        dist[removed->node] = best;
+    }
+}
+
+/**
+ * @brief Frees a reduction and its reduced graph.
+ *
+ * @param reduction Pointer to the reduction.
+ */
+void freeGraphReduction(GraphReduction* reduction) {
+    freeGraph(reduction->graph);
+    trackedFree(MEM_GRAPH, reduction->originalId);
+    trackedFree(MEM_GRAPH, reduction->removed);
+    trackedFree(MEM_GRAPH, reduction);
+}
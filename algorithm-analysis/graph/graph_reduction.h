@@ -0,0 +1,48 @@
+//
+//  graph_reduction.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef graph_reduction_h
+#define graph_reduction_h
+
+#include <stdio.h>
+#include "graph.h"
+
+/**
+ * @brief A node taken out by the reduction, with the arcs that reached it
+ * from its neighbors when it was removed. Node ids are those of the original
+ * graph.
+ */
+typedef struct {
+    int node;
+    int first;              // Its only neighbor (degree 1) or one of its two neighbors
+    int firstWeight;        // Weight of the arc first -> node (INT_MAX if there is none)
+    int second;             // The other neighbor (degree 2), or -1
+    int secondWeight;       // Weight of the arc second -> node (INT_MAX if there is none)
+} RemovedNode;
+
+/**
+ * @brief A graph reduced for the shortest paths from one source, and what is
+ * needed to expand its distances back to the original graph.
+ */
+typedef struct {
+    Graph* graph;           // The reduced graph
+    int source;             // The source, numbered in the reduced graph
+    int originalNodes;
+    int originalArcs;
+    int* originalId;        // Node of the original graph of every reduced node
+    RemovedNode* removed;   // Nodes removed by the degree tests, in removal order
+    int numRemoved;
+    int numUnreachable;     // Nodes dropped because the source does not reach them
+    int numLeaves;          // Nodes of degree 1 removed
+    int numChains;          // Nodes of degree 2 removed (contracted into an arc between their neighbors)
+} GraphReduction;
+
+GraphReduction* reduceGraph(Graph* graph, int src);
+void expandDistances(const GraphReduction* reduction, const int* reducedDist, int* dist);
+void freeGraphReduction(GraphReduction* reduction);
+
+#endif /* graph_reduction_h */
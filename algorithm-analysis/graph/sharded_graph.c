@@ -0,0 +1,168 @@
+//
+//  sharded_graph.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "sharded_graph.h"
+#include <stdlib.h>
+#include "memory_stats.h"
+
+/**
+ * @brief Splits the nodes into ranges of consecutive nodes, each with about
+ * the same number of nodes plus outgoing arcs, so that both the distances and
+ * the relaxations of a superstep are spread evenly.
+ *
+ * @param owner Array of numNodes entries that receives the shard of every node.
+ * @param firstNode Array of numShards + 1 entries that receives the ranges.
+ */
+static void partitionNodes(Graph* graph, int numShards, int* owner, int* firstNode) {
+    int numNodes = graph->numNodes;
+    long long total = (long long)numNodes + graph->numEdges;
+    long long cost = 0;
+    int shard = 0;
+
+    firstNode[0] = 0;
+    for (int u = 0; u < numNodes; u++) {
+        // Close the shard once it has its share, or when the nodes left are
+        // just enough for one in each of the next shards
+        if (shard < numShards - 1 && u > firstNode[shard] &&
+            (cost >= total * (shard + 1) / numShards || numNodes - u == numShards - 1 - shard)) {
+            firstNode[++shard] = u;
+        }
+        owner[u] = shard;
+        cost++;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            cost++;
+        }
+    }
+    firstNode[numShards] = numNodes;
+}
+
+/**
+ * @brief Copies the arcs of one shard, giving a slot to every node of another
+ * shard they reach.
+ *
+ * @param slotOf Scratch array of numNodes entries, all -1; restored before returning.
+ */
+static void buildShard(Graph* graph, ShardedGraph* sharded, const int* owner, const int* firstNode,
+                       int s, int* slotOf) {
+    Shard* shard = &sharded->shards[s];
+    shard->firstNode = firstNode[s];
+    shard->numNodes = firstNode[s + 1] - firstNode[s];
+
+    int numArcs = 0;
+    for (int u = shard->firstNode; u < firstNode[s + 1]; u++) {
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            numArcs++;
+        }
+    }
+    shard->offsets = (int*) trackedMalloc(MEM_GRAPH, ((size_t)shard->numNodes + 1) * sizeof(int));
+    shard->targets = (int*) trackedMalloc(MEM_GRAPH, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+    shard->weights = (int*) trackedMalloc(MEM_GRAPH, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+    shard->slotNode = (int*) trackedMalloc(MEM_GRAPH, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+    shard->slotShard = (int*) trackedMalloc(MEM_GRAPH, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+    shard->outgoing = (int*) trackedCalloc(MEM_GRAPH, sharded->numShards, sizeof(int));
+    shard->numSlots = 0;
+
+    int arc = 0;
+    for (int u = shard->firstNode; u < firstNode[s + 1]; u++) {
+        shard->offsets[u - shard->firstNode] = arc;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            int t = owner[v];
+            if (t == s) {
+                shard->targets[arc] = v - shard->firstNode;
+            } else {
+                if (slotOf[v] < 0) {
+                    slotOf[v] = shard->numSlots++;
+                    shard->slotNode[slotOf[v]] = v - firstNode[t];
+                    shard->slotShard[slotOf[v]] = t;
+                    shard->outgoing[t]++;
+                }
+                shard->targets[arc] = -(slotOf[v] + 1);
+                sharded->cutArcs++;
+            }
+            shard->weights[arc++] = node->weight;
+        }
+    }
+    shard->offsets[shard->numNodes] = arc;
+
+    for (int i = 0; i < shard->numSlots; i++) {
+        int t = shard->slotShard[i];
+        slotOf[shard->slotNode[i] + firstNode[t]] = -1;
+    }
+}
+
+/**
+ * @brief Splits a graph into shards for shardedBellmanFordDistances.
+ *
+ * @param graph Pointer to the graph.
+ * @param numShards Number of shards (at least 1, at most the number of nodes).
+ * @return The sharded graph, to be freed with freeShardedGraph.
+ */
+ShardedGraph* createShardedGraph(Graph* graph, int numShards) {
+    int numNodes = graph->numNodes;
+    if (numShards > numNodes)
+        numShards = numNodes;
+    if (numShards < 1)
+        numShards = 1;
+
+    ShardedGraph* sharded = (ShardedGraph*) trackedMalloc(MEM_GRAPH, sizeof(ShardedGraph));
+    sharded->numNodes = numNodes;
+    sharded->numEdges = graph->numEdges;
+    sharded->numShards = numShards;
+    sharded->cutArcs = 0;
+    sharded->shards = (Shard*) trackedMalloc(MEM_GRAPH, numShards * sizeof(Shard));
+
+    int* owner = (int*) trackedMalloc(MEM_BUFFERS, (numNodes > 0 ? numNodes : 1) * sizeof(int));
+    int* slotOf = (int*) trackedMalloc(MEM_BUFFERS, (numNodes > 0 ? numNodes : 1) * sizeof(int));
+    int* firstNode = (int*) trackedMalloc(MEM_BUFFERS, ((size_t)numShards + 1) * sizeof(int));
+    for (int v = 0; v < numNodes; v++) {
+        slotOf[v] = -1;
+    }
+
+    partitionNodes(graph, numShards, owner, firstNode);
+    for (int s = 0; s < numShards; s++) {
+        buildShard(graph, sharded, owner, firstNode, s, slotOf);
+    }
+
+    trackedFree(MEM_BUFFERS, owner);
+    trackedFree(MEM_BUFFERS, slotOf);
+    trackedFree(MEM_BUFFERS, firstNode);
+    return sharded;
+}
+
+/**
+ * @brief Bytes used by the shards (arcs, offsets and slot tables).
+ */
+long long shardedGraphBytes(const ShardedGraph* graph) {
+    long long bytes = (long long)graph->numShards * (sizeof(Shard) + graph->numShards * sizeof(int));
+    for (int s = 0; s < graph->numShards; s++) {
+        const Shard* shard = &graph->shards[s];
+        int numArcs = shard->offsets[shard->numNodes];
+        bytes += ((long long)shard->numNodes + 1) * sizeof(int) + 2LL * numArcs * sizeof(int) +
+                 2LL * shard->numSlots * sizeof(int);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Frees a sharded graph.
+ *
+ * @param graph Pointer to the sharded graph.
+ */
+void freeShardedGraph(ShardedGraph* graph) {
+    for (int s = 0; s < graph->numShards; s++) {
+        Shard* shard = &graph->shards[s];
+        trackedFree(MEM_GRAPH, shard->offsets);
+        trackedFree(MEM_GRAPH, shard->targets);
+        trackedFree(MEM_GRAPH, shard->weights);
+        trackedFree(MEM_GRAPH, shard->slotNode);
+        trackedFree(MEM_GRAPH, shard->slotShard);
+        trackedFree(MEM_GRAPH, shard->outgoing);
+    }
+    trackedFree(MEM_GRAPH, graph->shards);
+    trackedFree(MEM_GRAPH, graph);
+}
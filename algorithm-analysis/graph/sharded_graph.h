@@ -0,0 +1,48 @@
+//
+//  sharded_graph.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef sharded_graph_h
+#define sharded_graph_h
+
+#include <stdio.h>
+#include "graph.h"
+
+/**
+ * @brief The part of a graph owned by one shard: a range of nodes and their
+ * outgoing arcs. Arcs to nodes of the range use local numbers; the others
+ * point to a slot, one per node of another shard that the range reaches.
+ */
+typedef struct {
+    int firstNode;              // The shard owns nodes firstNode .. firstNode + numNodes - 1
+    int numNodes;
+    int* offsets;               // Arcs of local node u are targets[offsets[u]] .. targets[offsets[u + 1] - 1]
+    int* targets;               // Local node (>= 0), or -(slot + 1) for an arc that leaves the shard
+    int* weights;
+    int numSlots;
+    int* slotNode;              // Node of every slot, numbered in the shard that owns it
+    int* slotShard;             // Shard that owns it
+    int* outgoing;              // Slots owned by each shard: no more messages are sent to it per superstep
+} Shard;
+
+/**
+ * @brief A graph split into shards of consecutive nodes with about the same
+ * number of nodes plus arcs (an edge cut: arcs between shards are stored by
+ * the shard of their tail).
+ */
+typedef struct {
+    int numNodes;
+    int numEdges;
+    int numShards;
+    Shard* shards;
+    long long cutArcs;          // Arcs between nodes of different shards
+} ShardedGraph;
+
+ShardedGraph* createShardedGraph(Graph* graph, int numShards);
+long long shardedGraphBytes(const ShardedGraph* graph);
+void freeShardedGraph(ShardedGraph* graph);
+
+#endif /* sharded_graph_h */
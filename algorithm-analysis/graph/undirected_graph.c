@@ -0,0 +1,165 @@
+//
+//  undirected_graph.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "undirected_graph.h"
+#include <stdlib.h>
+#include "memory_stats.h"
+
+static int compareEdges(const void* a, const void* b) {
+    const UndirectedEdge* x = (const UndirectedEdge*) a;
+    const UndirectedEdge* y = (const UndirectedEdge*) b;
+    if (x->u != y->u)
+        return x->u < y->u ? -1 : 1;
+    if (x->v != y->v)
+        return x->v < y->v ? -1 : 1;
+    return (x->weight > y->weight) - (x->weight < y->weight);
+}
+
+static int compareWeights(const void* a, const void* b) {
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+static int sameEdge(const UndirectedEdge* a, const UndirectedEdge* b) {
+    return a->u == b->u && a->v == b->v && a->weight == b->weight;
+}
+
+/**
+ * @brief Builds the undirected version of a graph that lists every edge in
+ * both directions, as the .stp loader and the test_set files do.
+ *
+ * Every arc u -> v must have a matching arc v -> u with the same weight
+ * (parallel edges are matched one to one, and the self loops of a node are
+ * paired by weight). The graph is not modified.
+ *
+ * @param graph Pointer to the graph.
+ * @return Pointer to the undirected graph, or NULL if the graph is not symmetric.
+ */
+UndirectedGraph* createUndirectedGraph(Graph* graph) {
+    int numNodes = graph->numNodes;
+    int numArcs = graph->numEdges;
+    UndirectedEdge* forward = (UndirectedEdge*) trackedMalloc(MEM_BUFFERS, (numArcs / 2 + 1) * sizeof(UndirectedEdge));
+    UndirectedEdge* backward = (UndirectedEdge*) trackedMalloc(MEM_BUFFERS, (numArcs / 2 + 1) * sizeof(UndirectedEdge));
+    int* loops = (int*) trackedMalloc(MEM_BUFFERS, (numArcs > 0 ? numArcs : 1) * sizeof(int));
+    int numForward = 0, numBackward = 0;
+    int symmetric = numArcs % 2 == 0;
+
+    // Arcs with u < v go to one list and arcs with u > v, reversed, to the
+    // other. The graph is symmetric if both lists hold the same edges. The
+    // self loops of a node are matched apart: sorted by weight, each pair of
+    // equal weights becomes one edge.
+    for (int u = 0; u < numNodes && symmetric; u++) {
+        int numLoops = 0;
+        for (AdjNode* node = graph->adjLists[u]; node != NULL; node = node->next) {
+            int v = node->dest;
+            if (u == v) {
+                loops[numLoops++] = node->weight;
+                continue;
+            }
+            if ((u < v ? numForward : numBackward) == numArcs / 2) {
+                symmetric = 0;
+                break;
+            }
+            if (u < v) {
+                forward[numForward++] = (UndirectedEdge) { u, v, node->weight };
+            } else {
+                backward[numBackward++] = (UndirectedEdge) { v, u, node->weight };
+            }
+        }
+        qsort(loops, numLoops, sizeof(int), compareWeights);
+        for (int i = 0; i < numLoops && symmetric; i += 2) {
+            if (i + 1 == numLoops || loops[i] != loops[i + 1] || numForward == numArcs / 2) {
+                symmetric = 0;
+            } else {
+                forward[numForward++] = (UndirectedEdge) { u, u, loops[i] };
+            }
+        }
+    }
+    trackedFree(MEM_BUFFERS, loops);
+
+    if (symmetric) {
+        // Self loops are only in forward and were matched already
+        qsort(forward, numForward, sizeof(UndirectedEdge), compareEdges);
+        qsort(backward, numBackward, sizeof(UndirectedEdge), compareEdges);
+        int b = 0;
+        for (int e = 0; e < numForward && symmetric; e++) {
+            if (forward[e].u == forward[e].v)
+                continue;
+            symmetric = b < numBackward && sameEdge(&forward[e], &backward[b++]);
+        }
+        symmetric = symmetric && b == numBackward;
+    }
+    trackedFree(MEM_BUFFERS, backward);
+
+    if (!symmetric) {
+        trackedFree(MEM_BUFFERS, forward);
+        return NULL;
+    }
+
+    UndirectedGraph* undirected = (UndirectedGraph*) trackedMalloc(MEM_GRAPH, sizeof(UndirectedGraph));
+    undirected->numNodes = numNodes;
+    undirected->numEdges = numForward;
+    undirected->edges = (UndirectedEdge*) trackedMalloc(MEM_GRAPH, (numForward > 0 ? numForward : 1) * sizeof(UndirectedEdge));
+    for (int e = 0; e < numForward; e++) {
+        undirected->edges[e] = forward[e];
+    }
+    trackedFree(MEM_BUFFERS, forward);
+
+    // Incidence lists (a self loop is listed once at its node)
+    int* firstIncident = (int*) trackedCalloc(MEM_GRAPH, (size_t)numNodes + 1, sizeof(int));
+    for (int e = 0; e < undirected->numEdges; e++) {
+        firstIncident[undirected->edges[e].u + 1]++;
+        if (undirected->edges[e].v != undirected->edges[e].u)
+            firstIncident[undirected->edges[e].v + 1]++;
+    }
+    for (int x = 0; x < numNodes; x++) {
+        firstIncident[x + 1] += firstIncident[x];
+    }
+
+    int* incident = (int*) trackedMalloc(MEM_GRAPH, (firstIncident[numNodes] > 0 ? firstIncident[numNodes] : 1) * sizeof(int));
+    int* fill = (int*) trackedMalloc(MEM_BUFFERS, (numNodes > 0 ? numNodes : 1) * sizeof(int));
+    for (int x = 0; x < numNodes; x++) {
+        fill[x] = firstIncident[x];
+    }
+    for (int e = 0; e < undirected->numEdges; e++) {
+        incident[fill[undirected->edges[e].u]++] = e;
+        if (undirected->edges[e].v != undirected->edges[e].u)
+            incident[fill[undirected->edges[e].v]++] = e;
+    }
+    trackedFree(MEM_BUFFERS, fill);
+
+    undirected->firstIncident = firstIncident;
+    undirected->incident = incident;
+    return undirected;
+}
+
+/**
+ * @brief Returns the number of bytes of the edge array.
+ */
+long long undirectedEdgeBytes(const UndirectedGraph* graph) {
+    return (long long)graph->numEdges * sizeof(UndirectedEdge);
+}
+
+/**
+ * @brief Returns the number of bytes of the incidence lists.
+ */
+long long undirectedIncidenceBytes(const UndirectedGraph* graph) {
+    return ((long long)graph->numNodes + 1 + graph->firstIncident[graph->numNodes]) * sizeof(int);
+}
+
+/**
+ * @brief Frees the memory allocated for an undirected graph.
+ *
+ * @param graph Pointer to the undirected graph.
+ */
+void freeUndirectedGraph(UndirectedGraph* graph) {
+    trackedFree(MEM_GRAPH, graph->edges);
+    trackedFree(MEM_GRAPH, graph->firstIncident);
+    trackedFree(MEM_GRAPH, graph->incident);
+    trackedFree(MEM_GRAPH, graph);
+}
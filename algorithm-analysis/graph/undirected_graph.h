@@ -0,0 +1,43 @@
+//
+//  undirected_graph.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef undirected_graph_h
+#define undirected_graph_h
+
+#include <stdio.h>
+#include "graph.h"
+
+/**
+ * @brief Undirected edge, stored once for both directions.
+ */
+typedef struct {
+    int u;
+    int v;
+    int weight;
+} UndirectedEdge;
+
+/**
+ * @brief Graph whose edges are stored once and traversed in both directions.
+ *
+ * Edge-centric algorithms such as Bellman-Ford only read the edge array. Node
+ * traversals use the incidence lists, which hold edge numbers; the neighbor
+ * through edge e from node x is edges[e].u ^ edges[e].v ^ x.
+ */
+typedef struct {
+    int numNodes;
+    int numEdges;               // Number of undirected edges (half the arcs of the directed graph)
+    UndirectedEdge* edges;      // Sorted by (u, v) with u <= v
+    int* firstIncident;         // Edges of node x are incident[firstIncident[x]] .. incident[firstIncident[x + 1] - 1]
+    int* incident;
+} UndirectedGraph;
+
+UndirectedGraph* createUndirectedGraph(Graph* graph);
+long long undirectedEdgeBytes(const UndirectedGraph* graph);
+long long undirectedIncidenceBytes(const UndirectedGraph* graph);
+void freeUndirectedGraph(UndirectedGraph* graph);
+
+#endif /* undirected_graph_h */
@@ -16,9 +16,16 @@
 #include "bellman_ford_improved.h"
 #include "dijkstra_v1.h"
 #include "dijkstra_v2.h"
+#include "runner.h"
+#include "report.h"
 
 int main(int argc, const char * argv[]) {
     
+    // Non-interactive commands (batch runs, instance generation, ...)
+    if (argc > 1) {
+        return runCommand(argc - 1, argv + 1);
+    }
+    
     int continueProcessing = 1;
     
     while (continueProcessing) {
@@ -41,39 +48,13 @@ int main(int argc, const char * argv[]) {
             continue;
         }
         
-        // Process the chosen file
-        char *temp_file = process_file(file);
-        if (temp_file == NULL) {
+        // Process the chosen file and build the graph
+        Graph* graph = loadGraph(file);
+        if (graph == NULL) {
             fprintf(stderr, ERROR_MSG_PROCESS_FILE);
             free(file);
             continue;
         }
-
-        // Open the .temp file
-        FILE *fp = fopen(temp_file, "r");
-        if (fp == NULL) {
-            perror("Failed to open the temp file");
-            free(temp_file);
-            free(file);
-            continue;
-        }
-
-        int numNodes, numEdges;
-        fscanf(fp, "NODES %d\n", &numNodes);
-        fscanf(fp, "EDGES %d\n", &numEdges);
-        fscanf(fp, "EDGE_LIST\n");
-
-        // Create a graph
-        Graph* graph = createGraph(numNodes);
-
-        // Add edges to the created graph
-        int src, dest, weight;
-        while (fscanf(fp, "%d %d %d\n", &src, &dest, &weight) == 3) {
-            addEdge(graph, src, dest, weight);
-        }
-
-        fclose(fp);
-        free(temp_file);
         
         // Print graph's adjacency list - Part 1
         // printf("Graph created:\n");
@@ -89,8 +70,9 @@ int main(int argc, const char * argv[]) {
         // Run Bellman-Ford algorithm
         printf("\nRunning Bellman-Ford algorithm from source node 0...\n");
         clock_t bf_start = clock();
-        bellmanFordImproved(graph, 0, graph->numNodes - 1); // Final implementation
+        ShortestPathResult bf_result = bellmanFordImproved(graph, 0, graph->numNodes - 1); // Final implementation
         clock_t bf_end = clock();
+        printShortestPathResult(&bf_result);
         
         double bf_cpu_time = ((double) (bf_end - bf_start)) / CLOCKS_PER_SEC;
         printf("Bellman-Ford algorithm executed in %.6f seconds.\n", bf_cpu_time);
@@ -98,8 +80,9 @@ int main(int argc, const char * argv[]) {
         // Run Dijkstra (v1) algorithm
         printf("\nRunning Dijkstra (v1) algorithm from source node 0...\n");
         clock_t d_v1_start = clock();
-        dijkstraV1(graph, 0);
+        ShortestPathResult d_v1_result = dijkstraV1(graph, 0);
         clock_t d_v1_end = clock();
+        printShortestPathResult(&d_v1_result);
         
         double d_v1_cpu_time = ((double) (d_v1_end - d_v1_start)) / CLOCKS_PER_SEC;
         printf("Dijkstra (v1) algorithm executed in %.6f seconds.\n", d_v1_cpu_time);
@@ -107,8 +90,9 @@ int main(int argc, const char * argv[]) {
         // Run Dijkstra (v2) algorithm
         printf("\nRunning Dijkstra (v2) algorithm from source node 0...\n");
         clock_t d_v2_start = clock();
-        dijkstraV2(graph, 0);
+        ShortestPathResult d_v2_result = dijkstraV2(graph, 0);
         clock_t d_v2_end = clock();
+        printShortestPathResult(&d_v2_result);
         
         double d_v2_cpu_time = ((double) (d_v2_end - d_v2_start)) / CLOCKS_PER_SEC;
         printf("Dijkstra (v2) algorithm executed in %.6f seconds.\n", d_v2_cpu_time);
@@ -124,16 +108,7 @@ int main(int argc, const char * argv[]) {
         printf("\nTheoretical complexity of Dijkstra (v2): O(m * log n) --> O(%.2f)\n", d_v2_complexity);
 
         // Free the graph memory
-        for (int i = 0; i < graph->numNodes; i++) {
-            AdjNode* adjList = graph->adjLists[i];
-            while (adjList != NULL) {
-                AdjNode* temp = adjList;
-                adjList = adjList->next;
-                free(temp);
-            }
-        }
-        free(graph->adjLists);
-        free(graph);
+        freeGraph(graph);
 
         free(file);
     }
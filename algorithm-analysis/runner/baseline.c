@@ -0,0 +1,227 @@
+//
+//  baseline.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "baseline.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include "constants.h"
+#include "statistics.h"
+
+#define BASELINE_HEADER "# algorithm-analysis timing baseline"
+
+/**
+ * @brief Initializes an empty timing set.
+ */
+void initTimingSet(TimingSet *set) {
+    set->entries = NULL;
+    set->numEntries = 0;
+    set->capacity = 0;
+}
+
+/**
+ * @brief Reduces an instance path to its suite directory and file name, so that
+ * baselines recorded with another --data-dir still match.
+ */
+static const char *instanceKey(const char *path) {
+    const char *key = path;
+    int slashes = 0;
+    for (const char *c = path + strlen(path); c > path; c--) {
+        if (c[-1] == '/' && ++slashes == 2) {
+            key = c;
+            break;
+        }
+    }
+    return key;
+}
+
+static TimingSamples *findSamples(const TimingSet *set, const char *instance, const char *algorithm) {
+    for (int i = 0; i < set->numEntries; i++) {
+        if (strcmp(set->entries[i].instance, instance) == 0 && strcmp(set->entries[i].algorithm, algorithm) == 0)
+            return &set->entries[i];
+    }
+    return NULL;
+}
+
+static void addSample(TimingSet *set, const char *instance, const char *algorithm, double seconds) {
+    TimingSamples *samples = findSamples(set, instance, algorithm);
+    if (samples == NULL) {
+        if (set->numEntries == set->capacity) {
+            set->capacity = set->capacity ? set->capacity * 2 : 64;
+            set->entries = (TimingSamples *) realloc(set->entries, set->capacity * sizeof(TimingSamples));
+        }
+        samples = &set->entries[set->numEntries++];
+        samples->instance = strdup(instance);
+        samples->algorithm = strdup(algorithm);
+        samples->seconds = NULL;
+        samples->numSamples = 0;
+        samples->capacity = 0;
+    }
+    if (samples->numSamples == samples->capacity) {
+        samples->capacity = samples->capacity ? samples->capacity * 2 : 8;
+        samples->seconds = (double *) realloc(samples->seconds, samples->capacity * sizeof(double));
+    }
+    samples->seconds[samples->numSamples++] = seconds;
+}
+
+/**
+ * @brief Records the running time of one run.
+ *
+ * @param set The timing set.
+ * @param instancePath Path of the instance.
+ * @param algorithm Name of the algorithm.
+ * @param seconds Running time.
+ */
+void addTiming(TimingSet *set, const char *instancePath, const char *algorithm, double seconds) {
+    addSample(set, instanceKey(instancePath), algorithm, seconds);
+}
+
+/**
+ * @brief Writes a timing set as text: a header line, then one line per
+ * instance and algorithm with the instance, the algorithm and the running
+ * times, separated by tabs.
+ *
+ * @return 1 on success, 0 on error.
+ */
+int saveTimingSet(const TimingSet *set, const char *path) {
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        perror(ERROR_MSG_OUTPUT_FILE);
+        return 0;
+    }
+
+    fprintf(fp, "%s\n", BASELINE_HEADER);
+    for (int i = 0; i < set->numEntries; i++) {
+        const TimingSamples *samples = &set->entries[i];
+        fprintf(fp, "%s\t%s", samples->instance, samples->algorithm);
+        for (int s = 0; s < samples->numSamples; s++) {
+            fprintf(fp, "\t%.9f", samples->seconds[s]);
+        }
+        fprintf(fp, "\n");
+    }
+
+    int ok = !ferror(fp);
+    fclose(fp);
+    return ok;
+}
+
+/**
+ * @brief Reads a timing set written by saveTimingSet.
+ *
+ * @param set Initialized timing set that receives the samples.
+ * @param path Path of the file.
+ * @return 1 on success, 0 if the file cannot be read or is not a baseline.
+ */
+int loadTimingSet(TimingSet *set, const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        perror(ERROR_MSG_INPUT_FILE);
+        return 0;
+    }
+
+    char *line = NULL;
+    size_t size = 0;
+    if (getline(&line, &size, fp) < 0 || strncmp(line, BASELINE_HEADER, strlen(BASELINE_HEADER)) != 0) {
+        fprintf(stderr, "Not a timing baseline: %s\n", path);
+        free(line);
+        fclose(fp);
+        return 0;
+    }
+
+    while (getline(&line, &size, fp) >= 0) {
+        char *instance = strtok(line, "\t\n");
+        char *algorithm = strtok(NULL, "\t\n");
+        if (instance == NULL || algorithm == NULL || instance[0] == '#')
+            continue;
+        for (char *value = strtok(NULL, "\t\n"); value != NULL; value = strtok(NULL, "\t\n")) {
+            addSample(set, instance, algorithm, strtod(value, NULL));
+        }
+    }
+
+    free(line);
+    fclose(fp);
+    return 1;
+}
+
+/**
+ * @brief Compares the running times of a run with a baseline and prints the
+ * regressions and improvements. A pair of instance and algorithm regressed if
+ * the Mann-Whitney test rejects equal distributions at level alpha and the
+ * median time grew by more than the threshold and by more than minDelta (and
+ * improved in the opposite case). The absolute floor keeps runs of a few
+ * microseconds, where timer and cache noise dominate, from being reported.
+ *
+ * @param baseline The saved times.
+ * @param current The times of the run.
+ * @param options Significance level and threshold.
+ * @return Number of regressions.
+ */
+int compareWithBaseline(const TimingSet *baseline, const TimingSet *current, const RegressionOptions *options) {
+    int regressions = 0, improvements = 0, unchanged = 0, missing = 0, underpowered = 0;
+
+    printf("\nComparison with the baseline (Mann-Whitney, alpha %g, threshold %.1f%% and %g seconds):\n",
+           options->alpha, options->threshold * 100, options->minDelta);
+
+    for (int i = 0; i < current->numEntries; i++) {
+        const TimingSamples *now = &current->entries[i];
+        const TimingSamples *before = findSamples(baseline, now->instance, now->algorithm);
+        if (before == NULL || before->numSamples == 0) {
+            missing++;
+            continue;
+        }
+
+        int n1 = before->numSamples, n2 = now->numSamples;
+        double oldMedian = median(before->seconds, n1);
+        double newMedian = median(now->seconds, n2);
+        double change = oldMedian > 0 ? (newMedian - oldMedian) / oldMedian : 0;
+        double p = mannWhitneyPValue(before->seconds, n1, now->seconds, n2);
+
+        // Smallest p-value the test can give for these sample sizes: 2 / C(n1 + n2, n1)
+        double smallestP = 2 * exp(lgamma(n1 + 1) + lgamma(n2 + 1) - lgamma(n1 + n2 + 1));
+        underpowered += smallestP >= options->alpha;
+
+        const char *verdict = NULL;
+        bool significant = p < options->alpha && fabs(newMedian - oldMedian) > options->minDelta;
+        if (significant && change > options->threshold) {
+            verdict = "REGRESSION ";
+            regressions++;
+        } else if (significant && change < -options->threshold) {
+            verdict = "improvement";
+            improvements++;
+        } else {
+            unchanged++;
+        }
+        if (verdict != NULL) {
+            printf("  %s %s %s: %.6f -> %.6f seconds (%+.1f%%, p = %.4f)\n", verdict, now->instance,
+                   now->algorithm, oldMedian, newMedian, change * 100, p);
+        }
+    }
+
+    printf("---> %d regressions, %d improvements, %d unchanged, %d not in the baseline\n",
+           regressions, improvements, unchanged, missing);
+    if (underpowered > 0) {
+        printf("---> %d comparisons have too few repetitions to reach alpha %g; use --repeat 5 or more\n",
+               underpowered, options->alpha);
+    }
+    return regressions;
+}
+
+/**
+ * @brief Frees the samples of a timing set and leaves it empty.
+ */
+void freeTimingSet(TimingSet *set) {
+    for (int i = 0; i < set->numEntries; i++) {
+        free(set->entries[i].instance);
+        free(set->entries[i].algorithm);
+        free(set->entries[i].seconds);
+    }
+    free(set->entries);
+    initTimingSet(set);
+}
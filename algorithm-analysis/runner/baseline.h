@@ -0,0 +1,49 @@
+//
+//  baseline.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef baseline_h
+#define baseline_h
+
+#include <stdio.h>
+
+/**
+ * @brief Running times of one algorithm on one instance.
+ */
+typedef struct {
+    char *instance;         // Suite directory and file name, e.g. "ALUE/alue2087.stp"
+    char *algorithm;
+    double *seconds;
+    int numSamples;
+    int capacity;
+} TimingSamples;
+
+/**
+ * @brief Running times of a batch run, or of a saved baseline.
+ */
+typedef struct {
+    TimingSamples *entries;
+    int numEntries;
+    int capacity;
+} TimingSet;
+
+/**
+ * @brief When a difference in running time counts as a regression or an improvement.
+ */
+typedef struct {
+    double alpha;           // Significance level of the Mann-Whitney test
+    double threshold;       // Smallest relative change of the median (0.05 for 5%)
+    double minDelta;        // Smallest absolute change of the median, in seconds (timer noise)
+} RegressionOptions;
+
+void initTimingSet(TimingSet *set);
+void addTiming(TimingSet *set, const char *instancePath, const char *algorithm, double seconds);
+int saveTimingSet(const TimingSet *set, const char *path);
+int loadTimingSet(TimingSet *set, const char *path);
+int compareWithBaseline(const TimingSet *baseline, const TimingSet *current, const RegressionOptions *options);
+void freeTimingSet(TimingSet *set);
+
+#endif /* baseline_h */
@@ -0,0 +1,312 @@
+//
+//  cost_model.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "cost_model.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "constants.h"
+
+#define COST_MODEL_HEADER "# algorithm-analysis cost model"
+
+// Ridge penalty of the fit, so that a feature that does not vary over the
+// calibration instances gets a small coefficient instead of a singular system
+#define COST_MODEL_RIDGE 1e-3
+
+// Running times below the timer resolution are clamped before taking logs
+#define COST_MODEL_MIN_SECONDS 1e-7
+
+/**
+ * @brief Initializes an empty model for the machine it runs on.
+ */
+void initCostModel(CostModel *model) {
+    memset(model, 0, sizeof(CostModel));
+    if (gethostname(model->host, sizeof(model->host) - 1) != 0)
+        strcpy(model->host, "unknown");
+}
+
+static void modelTerms(const GraphFeatures *features, double *terms) {
+    terms[0] = 1;
+    terms[1] = log(features->numNodes > 0 ? features->numNodes : 1);
+    terms[2] = log(features->numArcs + 1.0);
+    terms[3] = log(features->degreeSkew > 1 ? features->degreeSkew : 1);
+    terms[4] = log((double)features->maxWeight - (features->minWeight < 0 ? features->minWeight : 0) + 1);
+}
+
+/**
+ * @brief Records the running time of one calibration run.
+ *
+ * @param model The model.
+ * @param algorithm Name of the algorithm.
+ * @param features Features of the instance.
+ * @param seconds Running time.
+ */
+void addCostSample(CostModel *model, const char *algorithm, const GraphFeatures *features, double seconds) {
+    if (model->numSamples == model->sampleCapacity) {
+        model->sampleCapacity = model->sampleCapacity ? model->sampleCapacity * 2 : 64;
+        model->samples = (CostSample *) realloc(model->samples, model->sampleCapacity * sizeof(CostSample));
+    }
+    CostSample *sample = &model->samples[model->numSamples++];
+    snprintf(sample->algorithm, sizeof(sample->algorithm), "%s", algorithm);
+    modelTerms(features, sample->terms);
+    sample->logSeconds = log(seconds > COST_MODEL_MIN_SECONDS ? seconds : COST_MODEL_MIN_SECONDS);
+}
+
+/**
+ * @brief Solves a small dense linear system by Gaussian elimination with
+ * partial pivoting. The system is overwritten.
+ *
+ * @return 1 on success, 0 if the matrix is singular.
+ */
+static int solveLinearSystem(double a[COST_MODEL_TERMS][COST_MODEL_TERMS], double *b, double *x) {
+    int n = COST_MODEL_TERMS;
+    for (int col = 0; col < n; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < n; row++) {
+            if (fabs(a[row][col]) > fabs(a[pivot][col]))
+                pivot = row;
+        }
+        if (fabs(a[pivot][col]) < 1e-12)
+            return 0;
+        for (int k = 0; k < n; k++) {
+            double t = a[col][k]; a[col][k] = a[pivot][k]; a[pivot][k] = t;
+        }
+        double t = b[col]; b[col] = b[pivot]; b[pivot] = t;
+
+        for (int row = col + 1; row < n; row++) {
+            double factor = a[row][col] / a[col][col];
+            for (int k = col; k < n; k++) {
+                a[row][k] -= factor * a[col][k];
+            }
+            b[row] -= factor * b[col];
+        }
+    }
+    for (int row = n - 1; row >= 0; row--) {
+        double sum = b[row];
+        for (int k = row + 1; k < n; k++) {
+            sum -= a[row][k] * x[k];
+        }
+        x[row] = sum / a[row][row];
+    }
+    return 1;
+}
+
+/**
+ * @brief Fits the model of one algorithm to its samples by ridge least
+ * squares on ln(seconds). The intercept is not penalized.
+ *
+ * @return 1 on success, 0 if there are too few samples.
+ */
+static int fitAlgorithm(const CostModel *model, AlgorithmCost *cost) {
+    double normal[COST_MODEL_TERMS][COST_MODEL_TERMS] = { { 0 } };
+    double rhs[COST_MODEL_TERMS] = { 0 };
+    int count = 0;
+
+    for (int s = 0; s < model->numSamples; s++) {
+        const CostSample *sample = &model->samples[s];
+        if (strcmp(sample->algorithm, cost->algorithm) != 0)
+            continue;
+        for (int i = 0; i < COST_MODEL_TERMS; i++) {
+            for (int j = 0; j < COST_MODEL_TERMS; j++) {
+                normal[i][j] += sample->terms[i] * sample->terms[j];
+            }
+            rhs[i] += sample->terms[i] * sample->logSeconds;
+        }
+        count++;
+    }
+    if (count < COST_MODEL_TERMS)
+        return 0;
+    for (int i = 1; i < COST_MODEL_TERMS; i++) {
+        normal[i][i] += COST_MODEL_RIDGE * count;
+    }
+    if (!solveLinearSystem(normal, rhs, cost->coefficients))
+        return 0;
+
+    double squares = 0;
+    for (int s = 0; s < model->numSamples; s++) {
+        const CostSample *sample = &model->samples[s];
+        if (strcmp(sample->algorithm, cost->algorithm) != 0)
+            continue;
+        double predicted = 0;
+        for (int i = 0; i < COST_MODEL_TERMS; i++) {
+            predicted += cost->coefficients[i] * sample->terms[i];
+        }
+        squares += (predicted - sample->logSeconds) * (predicted - sample->logSeconds);
+    }
+    cost->numSamples = count;
+    cost->rmsError = sqrt(squares / count);
+    return 1;
+}
+
+/**
+ * @brief Fits the model of every algorithm that has samples, replacing the
+ * models already fitted or loaded for them. Algorithms need at least
+ * COST_MODEL_TERMS samples, so calibrate on at least that many instances.
+ *
+ * @return Number of algorithms fitted.
+ */
+int fitCostModel(CostModel *model) {
+    int fitted = 0;
+
+    for (int s = 0; s < model->numSamples; s++) {
+        const char *algorithm = model->samples[s].algorithm;
+        int seen = 0;
+        for (int t = 0; t < s && !seen; t++) {
+            seen = strcmp(model->samples[t].algorithm, algorithm) == 0;
+        }
+        if (seen)
+            continue;
+
+        AlgorithmCost cost;
+        memset(&cost, 0, sizeof(cost));
+        snprintf(cost.algorithm, sizeof(cost.algorithm), "%s", algorithm);
+        if (!fitAlgorithm(model, &cost)) {
+            fprintf(stderr, "Too few calibration runs of %s to fit its cost model.\n", algorithm);
+            continue;
+        }
+
+        AlgorithmCost *existing = (AlgorithmCost *) findAlgorithmCost(model, algorithm);
+        if (existing == NULL) {
+            model->costs = (AlgorithmCost *) realloc(model->costs, (model->numCosts + 1) * sizeof(AlgorithmCost));
+            existing = &model->costs[model->numCosts++];
+        }
+        *existing = cost;
+        fitted++;
+    }
+    return fitted;
+}
+
+/**
+ * @brief Returns the model of an algorithm, or NULL if it was not calibrated.
+ */
+const AlgorithmCost *findAlgorithmCost(const CostModel *model, const char *algorithm) {
+    for (int c = 0; c < model->numCosts; c++) {
+        if (strcmp(model->costs[c].algorithm, algorithm) == 0)
+            return &model->costs[c];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Predicts the running time of an algorithm on a graph.
+ *
+ * @return The predicted time in seconds.
+ */
+double predictSeconds(const AlgorithmCost *cost, const GraphFeatures *features) {
+    double terms[COST_MODEL_TERMS];
+    double sum = 0;
+    modelTerms(features, terms);
+    for (int i = 0; i < COST_MODEL_TERMS; i++) {
+        sum += cost->coefficients[i] * terms[i];
+    }
+    return exp(sum);
+}
+
+/**
+ * @brief Writes the fitted models as text: a header line, the host line, then
+ * one line per algorithm with its name, number of samples, fit error and
+ * coefficients, separated by tabs.
+ *
+ * @return 1 on success, 0 on error.
+ */
+int saveCostModel(const CostModel *model, const char *path) {
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        perror(ERROR_MSG_OUTPUT_FILE);
+        return 0;
+    }
+
+    fprintf(fp, "%s\n", COST_MODEL_HEADER);
+    fprintf(fp, "# host\t%s\n", model->host);
+    fprintf(fp, "# algorithm\tsamples\trms_error\t1\tln(nodes)\tln(arcs + 1)\tln(degree skew)\tln(weight range + 1)\n");
+    for (int c = 0; c < model->numCosts; c++) {
+        const AlgorithmCost *cost = &model->costs[c];
+        fprintf(fp, "%s\t%d\t%.6f", cost->algorithm, cost->numSamples, cost->rmsError);
+        for (int i = 0; i < COST_MODEL_TERMS; i++) {
+            fprintf(fp, "\t%.9g", cost->coefficients[i]);
+        }
+        fprintf(fp, "\n");
+    }
+
+    int ok = !ferror(fp);
+    fclose(fp);
+    return ok;
+}
+
+/**
+ * @brief Reads the models written by saveCostModel. Warns when they were
+ * calibrated on another machine, since the running times do not carry over.
+ *
+ * @param model Initialized model that receives the algorithms.
+ * @param path Path of the file.
+ * @return 1 on success, 0 if the file cannot be read or is not a cost model.
+ */
+int loadCostModel(CostModel *model, const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        perror(path);
+        return 0;
+    }
+
+    char *line = NULL;
+    size_t size = 0;
+    if (getline(&line, &size, fp) < 0 || strncmp(line, COST_MODEL_HEADER, strlen(COST_MODEL_HEADER)) != 0) {
+        fprintf(stderr, "Not a cost model: %s\n", path);
+        free(line);
+        fclose(fp);
+        return 0;
+    }
+
+    char host[sizeof(model->host)];
+    snprintf(host, sizeof(host), "%s", model->host);
+    while (getline(&line, &size, fp) >= 0) {
+        if (strncmp(line, "# host\t", 7) == 0) {
+            char *value = strtok(line + 7, "\n");
+            snprintf(model->host, sizeof(model->host), "%s", value != NULL ? value : "");
+            continue;
+        }
+        if (line[0] == '#')
+            continue;
+
+        AlgorithmCost cost;
+        memset(&cost, 0, sizeof(cost));
+        char *name = strtok(line, "\t\n");
+        char *samples = strtok(NULL, "\t\n");
+        char *error = strtok(NULL, "\t\n");
+        int terms = 0;
+        for (char *value = strtok(NULL, "\t\n"); value != NULL && terms < COST_MODEL_TERMS; value = strtok(NULL, "\t\n")) {
+            cost.coefficients[terms++] = strtod(value, NULL);
+        }
+        if (name == NULL || samples == NULL || error == NULL || terms != COST_MODEL_TERMS)
+            continue;
+        snprintf(cost.algorithm, sizeof(cost.algorithm), "%s", name);
+        cost.numSamples = atoi(samples);
+        cost.rmsError = strtod(error, NULL);
+
+        model->costs = (AlgorithmCost *) realloc(model->costs, (model->numCosts + 1) * sizeof(AlgorithmCost));
+        model->costs[model->numCosts++] = cost;
+    }
+    if (strcmp(host, model->host) != 0)
+        fprintf(stderr, "Warning: the cost model in %s was calibrated on %s, not on this machine (%s).\n",
+                path, model->host, host);
+
+    free(line);
+    fclose(fp);
+    return 1;
+}
+
+/**
+ * @brief Frees the memory of a model.
+ */
+void freeCostModel(CostModel *model) {
+    free(model->costs);
+    free(model->samples);
+    initCostModel(model);
+}
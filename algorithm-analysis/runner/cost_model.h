@@ -0,0 +1,62 @@
+//
+//  cost_model.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef cost_model_h
+#define cost_model_h
+
+#include <stdio.h>
+#include "graph_features.h"
+
+// Terms of the model: 1, ln(nodes), ln(arcs + 1), ln(degree skew) and
+// ln(weight range + 1). The running time is predicted as exp of their
+// weighted sum, so a term's coefficient is the exponent of that feature
+// (2 for ln(nodes) in an O(n^2) algorithm).
+#define COST_MODEL_TERMS 5
+#define COST_MODEL_NAME_LENGTH 16
+
+/**
+ * @brief Fitted running time model of one algorithm.
+ */
+typedef struct {
+    char algorithm[COST_MODEL_NAME_LENGTH];
+    double coefficients[COST_MODEL_TERMS];
+    int numSamples;
+    double rmsError;            // Root mean square error of the fit, in ln(seconds)
+} AlgorithmCost;
+
+/**
+ * @brief Running time of one calibration run.
+ */
+typedef struct {
+    char algorithm[COST_MODEL_NAME_LENGTH];
+    double terms[COST_MODEL_TERMS];
+    double logSeconds;
+} CostSample;
+
+/**
+ * @brief Cost models of the calibrated algorithms, and the calibration runs
+ * they are fitted to.
+ */
+typedef struct {
+    AlgorithmCost *costs;
+    int numCosts;
+    CostSample *samples;
+    int numSamples;
+    int sampleCapacity;
+    char host[64];              // Machine the model was calibrated on
+} CostModel;
+
+void initCostModel(CostModel *model);
+void addCostSample(CostModel *model, const char *algorithm, const GraphFeatures *features, double seconds);
+int fitCostModel(CostModel *model);
+const AlgorithmCost *findAlgorithmCost(const CostModel *model, const char *algorithm);
+double predictSeconds(const AlgorithmCost *cost, const GraphFeatures *features);
+int saveCostModel(const CostModel *model, const char *path);
+int loadCostModel(CostModel *model, const char *path);
+void freeCostModel(CostModel *model);
+
+#endif /* cost_model_h */
@@ -0,0 +1,204 @@
+//
+//  dynamic_command.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "runner.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+
+#include "constants.h"
+#include "graph.h"
+#include "utils.h"
+#include "instances.h"
+#include "generator.h"
+#include "memory_stats.h"
+#include "dijkstra_v2.h"
+#include "dynamic_sssp.h"
+
+/**
+ * @brief Picks an arc of the graph: a random node with outgoing arcs and a
+ * random arc of its list.
+ *
+ * @return false if no node with arcs was found after a few tries.
+ */
+static bool randomArc(Graph *graph, Random *random, int *src, int *dest) {
+    for (int attempt = 0; attempt < 32; attempt++) {
+        int u = (int)(nextRandom(random) % (unsigned long long)graph->numNodes);
+        int degree = 0;
+        for (AdjNode *node = graph->adjLists[u]; node != NULL; node = node->next) {
+            degree++;
+        }
+        if (degree == 0)
+            continue;
+
+        AdjNode *node = graph->adjLists[u];
+        for (int k = (int)(nextRandom(random) % (unsigned long long)degree); k > 0; k--) {
+            node = node->next;
+        }
+        *src = u;
+        *dest = node->dest;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Fills a batch with random insertions, deletions and weight changes
+ * (about a third of each). New weights are drawn from [1, maxWeight].
+ */
+static void randomUpdates(Graph *graph, Random *random, int maxWeight, EdgeUpdate *updates, int numUpdates) {
+    for (int i = 0; i < numUpdates; i++) {
+        EdgeUpdate *update = &updates[i];
+        update->type = (EdgeUpdateType)(nextRandom(random) % 3);
+        update->weight = 1 + (int)(nextRandom(random) % (unsigned long long)maxWeight);
+        if (update->type == EDGE_INSERT || !randomArc(graph, random, &update->src, &update->dest)) {
+            update->type = EDGE_INSERT;
+            update->src = (int)(nextRandom(random) % (unsigned long long)graph->numNodes);
+            update->dest = (int)(nextRandom(random) % (unsigned long long)graph->numNodes);
+        }
+    }
+}
+
+/**
+ * @brief Keeps the shortest paths from one source up to date while random
+ * batches of edge updates are applied (createDynamicSSSP and
+ * applyEdgeUpdates). After every batch the repaired distances are compared
+ * with a fresh dijkstraV2 run on the updated graph, and the vertices settled
+ * again by the repair are reported against the number of nodes.
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if a repaired distance is wrong.
+ */
+int runDynamic(int argc, const char *argv[]) {
+    InstanceSelection instances;
+    int numBatches = 100;
+    int batchSize = 10;
+    int source = 0;
+    Random random = { 1 };
+    int failures = 0;
+
+    initInstanceSelection(&instances);
+    for (int i = 0; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (parseInstanceOption(argc, argv, &i, &instances)) {
+            continue;
+        } else if (strcmp(argv[i], "--batches") == 0 && value != NULL) {
+            numBatches = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--updates") == 0 && value != NULL) {
+            batchSize = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--source") == 0 && value != NULL) {
+            source = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--seed") == 0 && value != NULL) {
+            random.state = strtoull(value, NULL, 10);
+            i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (numBatches < 1 || batchSize < 1 || source < 0) {
+        fprintf(stderr, "--batches and --updates must be positive and --source non-negative.\n");
+        return EXIT_FAILURE;
+    }
+    if (!resolveInstances(&instances, 0) || instances.numPaths == 0) {
+        fprintf(stderr, "No instances to run.\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int p = 0; p < instances.numPaths; p++) {
+        printf("\n==> %s\n", instances.paths[p]);
+
+        Graph *graph = loadGraph(instances.paths[p]);
+        if (graph == NULL) {
+            fprintf(stderr, ERROR_MSG_PROCESS_FILE);
+            continue;
+        }
+        int minWeight, maxWeight;
+        edgeWeightRange(graph, &minWeight, &maxWeight);
+        if (graph->numNodes == 0 || minWeight < 0 || source >= graph->numNodes) {
+            printf("---> Skipped: %s.\n", graph->numNodes == 0 ? "the graph is empty" :
+                   minWeight < 0 ? "the graph has negative weights" : "the source is not a node of the graph");
+            freeGraph(graph);
+            continue;
+        }
+        if (maxWeight < 1)
+            maxWeight = 1;
+        int numNodes = graph->numNodes;
+        printf("---> Nodes: %d, arcs: %d\n", numNodes, graph->numEdges);
+
+        double start = wallTime();
+        DynamicSSSP *dsssp = createDynamicSSSP(graph, source);
+        printf("Initial shortest path tree in %.6f seconds.\n", wallTime() - start);
+
+        EdgeUpdate *updates = (EdgeUpdate *) trackedMalloc(MEM_BUFFERS, batchSize * sizeof(EdgeUpdate));
+        int *dist = (int *) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+        double repairTime = 0, recomputeTime = 0;
+        long long settled = 0;
+        int maxSettled = 0;
+        int wrongBatches = 0;
+
+        for (int b = 0; b < numBatches; b++) {
+            randomUpdates(graph, &random, maxWeight, updates, batchSize);
+
+            start = wallTime();
+            int batchSettled = applyEdgeUpdates(dsssp, updates, batchSize);
+            repairTime += wallTime() - start;
+            settled += batchSettled;
+            if (batchSettled > maxSettled)
+                maxSettled = batchSettled;
+
+            start = wallTime();
+            dijkstraV2Distances(graph, source, dist);
+            recomputeTime += wallTime() - start;
+
+            int wrong = 0;
+            for (int v = 0; v < numNodes; v++) {
+                wrong += dynamicDistance(dsssp, v) != dist[v];
+            }
+            if (wrong > 0) {
+                if (wrongBatches == 0)
+                    printf("Batch %d: %d distances differ from dijkstraV2.\n", b + 1, wrong);
+                wrongBatches++;
+            }
+        }
+
+        double meanSettled = (double)settled / numBatches;
+        printf("---> %d batches of %d updates, arcs now: %d\n", numBatches, batchSize, graph->numEdges);
+        printf("Vertices settled again:    %.1f per batch (%.2f%% of n), at most %d\n",
+               meanSettled, 100.0 * meanSettled / numNodes, maxSettled);
+        printf("Repair (applyEdgeUpdates): %.6f seconds, %.3f ms per batch\n",
+               repairTime, 1000.0 * repairTime / numBatches);
+        printf("Recompute (dijkstraV2):    %.6f seconds, %.3f ms per batch", recomputeTime,
+               1000.0 * recomputeTime / numBatches);
+        if (repairTime > 0)
+            printf(", %.2fx the repair", recomputeTime / repairTime);
+        printf("\n");
+
+        if (wrongBatches > 0) {
+            printf("Check FAILED: %d of %d batches left wrong distances.\n", wrongBatches, numBatches);
+            failures++;
+        } else {
+            printf("Check PASSED: the distances match dijkstraV2 after each of %d batches.\n", numBatches);
+        }
+
+        trackedFree(MEM_BUFFERS, updates);
+        trackedFree(MEM_BUFFERS, dist);
+        freeDynamicSSSP(dsssp);
+        freeGraph(graph);
+    }
+
+    freeInstanceSelection(&instances);
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
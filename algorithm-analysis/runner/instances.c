@@ -0,0 +1,134 @@
+//
+//  instances.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "instances.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "constants.h"
+#include "utils.h"
+
+/**
+ * @brief Initializes an empty selection that looks for suites in DIR_PATH.
+ *
+ * @param selection Pointer to the selection.
+ */
+void initInstanceSelection(InstanceSelection *selection) {
+    selection->dataDir = DIR_PATH;
+    selection->numSuites = 0;
+    selection->numPaths = 0;
+}
+
+/**
+ * @brief Adds an instance file to the selection, which takes ownership of the path.
+ *
+ * @param selection Pointer to the selection.
+ * @param path Dynamically allocated path of the instance.
+ */
+void addInstance(InstanceSelection *selection, char *path) {
+    if (selection->numPaths < MAX_INSTANCES) {
+        selection->paths[selection->numPaths++] = path;
+    } else {
+        fprintf(stderr, "Too many instances, ignoring %s\n", path);
+        free(path);
+    }
+}
+
+/**
+ * @brief Adds the instance files of a path (file or directory) to the selection.
+ */
+static void addInstancePath(InstanceSelection *selection, const char *path) {
+    int count;
+    char **files = listInstanceFiles(path, &count);
+    if (files == NULL) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        addInstance(selection, files[i]);
+    }
+    free(files);
+}
+
+/**
+ * @brief Adds the files of a bundled suite to the selection.
+ *
+ * @return 1 on success, 0 if the suite name is unknown.
+ */
+static int addSuite(InstanceSelection *selection, const char *suite) {
+    static const char *suites[] = { TEST_SET1, TEST_SET2, ALUE, ALUT, DMXA };
+    int found = 0;
+
+    for (int s = 0; s < (int)(sizeof(suites) / sizeof(suites[0])); s++) {
+        if (strcmp(suite, "all") == 0 || strcmp(suite, suites[s] + 1) == 0) {
+            char path[MAX_LINE_LENGTH * 2];
+            snprintf(path, sizeof(path), "%s%s", selection->dataDir, suites[s]);
+            addInstancePath(selection, path);
+            found = 1;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Consumes the instance option at argv[*i], if it is one: --suite NAME,
+ * --data-dir DIR or a path that does not start with "--".
+ *
+ * @return 1 if the argument was consumed, 0 otherwise.
+ */
+int parseInstanceOption(int argc, const char *argv[], int *i, InstanceSelection *selection) {
+    const char *value = (*i + 1 < argc) ? argv[*i + 1] : NULL;
+
+    if (strcmp(argv[*i], "--suite") == 0 && value != NULL && selection->numSuites < MAX_SUITES) {
+        selection->suites[selection->numSuites++] = value;
+        (*i)++;
+        return 1;
+    }
+    if (strcmp(argv[*i], "--data-dir") == 0 && value != NULL) {
+        selection->dataDir = value;
+        (*i)++;
+        return 1;
+    }
+    if (strncmp(argv[*i], "--", 2) != 0) {
+        addInstancePath(selection, argv[*i]);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Adds the files of the selected suites. Suites are resolved after all
+ * options are parsed, so --data-dir may come after --suite.
+ *
+ * @param selection Pointer to the selection.
+ * @param defaultToAll If nothing was selected, select every bundled suite.
+ * @return 1 on success, 0 if a suite name is unknown.
+ */
+int resolveInstances(InstanceSelection *selection, int defaultToAll) {
+    for (int s = 0; s < selection->numSuites; s++) {
+        if (!addSuite(selection, selection->suites[s])) {
+            fprintf(stderr, "Unknown suite: %s\n", selection->suites[s]);
+            return 0;
+        }
+    }
+    if (defaultToAll && selection->numPaths == 0 && selection->numSuites == 0) {
+        addSuite(selection, "all");
+    }
+    return 1;
+}
+
+/**
+ * @brief Frees the paths of the selection.
+ *
+ * @param selection Pointer to the selection.
+ */
+void freeInstanceSelection(InstanceSelection *selection) {
+    for (int p = 0; p < selection->numPaths; p++) {
+        free(selection->paths[p]);
+    }
+    selection->numPaths = 0;
+}
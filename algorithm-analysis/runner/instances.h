@@ -0,0 +1,34 @@
+//
+//  instances.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef instances_h
+#define instances_h
+
+#include <stdio.h>
+
+#define MAX_INSTANCES 1024
+#define MAX_SUITES 16
+
+/**
+ * @brief Instances selected on the command line, as explicit files or
+ * directories and as bundled suites.
+ */
+typedef struct {
+    const char *dataDir;            // Directory with the bundled suites
+    const char *suites[MAX_SUITES];
+    int numSuites;
+    char *paths[MAX_INSTANCES];     // Instance files, owned by the selection
+    int numPaths;
+} InstanceSelection;
+
+void initInstanceSelection(InstanceSelection *selection);
+int parseInstanceOption(int argc, const char *argv[], int *i, InstanceSelection *selection);
+void addInstance(InstanceSelection *selection, char *path);
+int resolveInstances(InstanceSelection *selection, int defaultToAll);
+void freeInstanceSelection(InstanceSelection *selection);
+
+#endif /* instances_h */
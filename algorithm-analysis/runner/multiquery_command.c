@@ -0,0 +1,230 @@
+//
+//  multiquery_command.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "runner.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+
+#include "constants.h"
+#include "graph.h"
+#include "utils.h"
+#include "instances.h"
+#include "generator.h"
+#include "memory_stats.h"
+#include "dijkstra_v2.h"
+#include "bellman_ford_improved.h"
+#include "interleaved_sssp.h"
+#include "report.h"
+
+typedef struct {
+    int numNodes;
+    unsigned long long *checksums;
+} ChecksumContext;
+
+static void recordChecksum(int query, const int *dist, void *context) {
+    ChecksumContext *checksums = (ChecksumContext *) context;
+    checksums->checksums[query] = distanceChecksum(dist, checksums->numNodes);
+}
+
+/**
+ * @brief Counts the queries whose checksum differs from the sequential run.
+ */
+static int countMismatches(const unsigned long long *expected, const unsigned long long *found, int numQueries) {
+    int wrong = 0;
+    for (int q = 0; q < numQueries; q++) {
+        wrong += expected[q] != found[q];
+    }
+    return wrong;
+}
+
+static void printThroughput(const char *label, int numQueries, double elapsed, double reference) {
+    printf("%-26s %d queries in %.6f seconds, %.1f queries per second", label, numQueries, elapsed,
+           elapsed > 0 ? numQueries / elapsed : 0.0);
+    if (reference > 0 && elapsed > 0)
+        printf(", %.2fx sequential", reference / elapsed);
+    printf("\n");
+}
+
+/**
+ * @brief Runs the queries one at a time with dijkstraV2, then interleaved
+ * with widths 1 and width.
+ *
+ * @return Number of queries whose distances differ from dijkstraV2.
+ */
+static int compareDijkstra(Graph *graph, const int *sources, int numQueries, int width) {
+    int numNodes = graph->numNodes;
+    unsigned long long *expected = (unsigned long long *) trackedMalloc(MEM_BUFFERS, numQueries * sizeof(unsigned long long));
+    unsigned long long *found = (unsigned long long *) trackedMalloc(MEM_BUFFERS, numQueries * sizeof(unsigned long long));
+    int *dist = (int *) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+
+    double start = wallTime();
+    for (int q = 0; q < numQueries; q++) {
+        dijkstraV2Distances(graph, sources[q], dist);
+        expected[q] = distanceChecksum(dist, numNodes);
+    }
+    double sequential = wallTime() - start;
+    trackedFree(MEM_BUFFERS, dist);
+    printThroughput("Sequential (dijkstraV2):", numQueries, sequential, 0);
+
+    ChecksumContext context = { numNodes, found };
+    int widths[2] = { 1, width };
+    int wrong = 0;
+    for (int i = 0; i < (width > 1 ? 2 : 1); i++) {
+        char label[64];
+        snprintf(label, sizeof(label), "Interleaved, width %d:", widths[i]);
+        start = wallTime();
+        interleavedDijkstra(graph, sources, numQueries, widths[i], recordChecksum, &context);
+        printThroughput(label, numQueries, wallTime() - start, sequential);
+        wrong += countMismatches(expected, found, numQueries);
+    }
+
+    trackedFree(MEM_BUFFERS, expected);
+    trackedFree(MEM_BUFFERS, found);
+    return wrong;
+}
+
+/**
+ * @brief Runs the queries one at a time with bellmanFordImprovedDistances,
+ * then width at a time with interleavedBellmanFord.
+ *
+ * @return Number of queries whose distances or negative cycle flag differ.
+ */
+static int compareBellmanFord(Graph *graph, const int *sources, int numQueries, int width) {
+    int numNodes = graph->numNodes;
+    unsigned long long *expected = (unsigned long long *) trackedMalloc(MEM_BUFFERS, numQueries * sizeof(unsigned long long));
+    unsigned long long *found = (unsigned long long *) trackedMalloc(MEM_BUFFERS, numQueries * sizeof(unsigned long long));
+    int *dist = (int *) trackedMalloc(MEM_BUFFERS, (size_t)numNodes * width * sizeof(int));
+    int *negativeCycle = (int *) trackedMalloc(MEM_BUFFERS, width * sizeof(int));
+    int cycles = 0;
+
+    double start = wallTime();
+    for (int q = 0; q < numQueries; q++) {
+        int cycle = bellmanFordImprovedDistances(graph, sources[q], dist);
+        expected[q] = distanceChecksum(dist, numNodes) + cycle;
+        cycles += cycle;
+    }
+    double sequential = wallTime() - start;
+    printThroughput("Sequential (bf):", numQueries, sequential, 0);
+
+    char label[64];
+    snprintf(label, sizeof(label), "Interleaved, width %d:", width);
+    start = wallTime();
+    for (int first = 0; first < numQueries; first += width) {
+        int count = numQueries - first < width ? numQueries - first : width;
+        interleavedBellmanFord(graph, sources + first, count, dist, negativeCycle);
+        for (int q = 0; q < count; q++) {
+            found[first + q] = stridedDistanceChecksum(dist + q, numNodes, count) + negativeCycle[q];
+        }
+    }
+    printThroughput(label, numQueries, wallTime() - start, sequential);
+    if (cycles > 0)
+        printf("---> %d of %d sources reach a negative cycle\n", cycles, numQueries);
+
+    int wrong = countMismatches(expected, found, numQueries);
+    trackedFree(MEM_BUFFERS, expected);
+    trackedFree(MEM_BUFFERS, found);
+    trackedFree(MEM_BUFFERS, dist);
+    trackedFree(MEM_BUFFERS, negativeCycle);
+    return wrong;
+}
+
+/**
+ * @brief Measures the throughput of many single-source queries on one core:
+ * N random sources run one after the other, and then interleaved W at a time
+ * so that the memory stalls of different queries overlap. Every distance
+ * vector is checked against the sequential run.
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if an interleaved query gave other distances.
+ */
+int runMultiquery(int argc, const char *argv[]) {
+    InstanceSelection instances;
+    int numQueries = 64;
+    int width = 8;
+    bool bellmanFord = false;
+    Random random = { 1 };
+    int failures = 0;
+
+    initInstanceSelection(&instances);
+    for (int i = 0; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (parseInstanceOption(argc, argv, &i, &instances)) {
+            continue;
+        } else if (strcmp(argv[i], "--queries") == 0 && value != NULL) {
+            numQueries = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--width") == 0 && value != NULL) {
+            width = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--algorithm") == 0 && value != NULL) {
+            if (strcmp(value, "d") != 0 && strcmp(value, "bf") != 0) {
+                fprintf(stderr, "Unknown algorithm: %s (d or bf)\n", value);
+                return EXIT_FAILURE;
+            }
+            bellmanFord = strcmp(value, "bf") == 0;
+            i++;
+        } else if (strcmp(argv[i], "--seed") == 0 && value != NULL) {
+            random.state = strtoull(value, NULL, 10);
+            i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (numQueries < 1 || width < 1) {
+        fprintf(stderr, "--queries and --width must be positive.\n");
+        return EXIT_FAILURE;
+    }
+    if (!resolveInstances(&instances, 0) || instances.numPaths == 0) {
+        fprintf(stderr, "No instances to run.\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int p = 0; p < instances.numPaths; p++) {
+        printf("\n==> %s\n", instances.paths[p]);
+
+        Graph *graph = loadGraph(instances.paths[p]);
+        if (graph == NULL) {
+            fprintf(stderr, ERROR_MSG_PROCESS_FILE);
+            continue;
+        }
+        int minWeight, maxWeight;
+        edgeWeightRange(graph, &minWeight, &maxWeight);
+        if (graph->numNodes == 0 || (!bellmanFord && minWeight < 0)) {
+            printf("---> Skipped: %s.\n", graph->numNodes == 0 ? "the graph is empty" : "the graph has negative weights");
+            freeGraph(graph);
+            continue;
+        }
+        printf("---> Nodes: %d, arcs: %d\n", graph->numNodes, graph->numEdges);
+
+        int *sources = (int *) trackedMalloc(MEM_BUFFERS, numQueries * sizeof(int));
+        for (int q = 0; q < numQueries; q++) {
+            sources[q] = (int)(nextRandom(&random) % (unsigned long long)graph->numNodes);
+        }
+
+        int wrong = bellmanFord ? compareBellmanFord(graph, sources, numQueries, width)
+                                : compareDijkstra(graph, sources, numQueries, width);
+        if (wrong > 0) {
+            printf("Check FAILED: %d distance vectors differ from the sequential run.\n", wrong);
+            failures++;
+        } else {
+            printf("Check PASSED: %d distance vectors match the sequential run.\n", numQueries);
+        }
+
+        trackedFree(MEM_BUFFERS, sources);
+        freeGraph(graph);
+    }
+
+    freeInstanceSelection(&instances);
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+//
+//  oracle_command.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "runner.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+
+#include "constants.h"
+#include "graph.h"
+#include "utils.h"
+#include "instances.h"
+#include "generator.h"
+#include "memory_stats.h"
+#include "dijkstra_v2.h"
+#include "hub_labels.h"
+
+/**
+ * @brief Loads the hub labels saved next to an instance, or builds and saves
+ * them when there is no saved index, when it was built for other arcs or
+ * weights (see graphFingerprint), or when rebuild is set.
+ *
+ * @param buildTime Output parameter with the preprocessing time; set to 0 when
+ * the labels were loaded from disk.
+ */
+HubLabels* obtainHubLabels(Graph *graph, const char *path, bool rebuild, double *buildTime) {
+    char *indexPath = malloc(strlen(path) + sizeof(HUB_LABELS_EXTENSION));
+    sprintf(indexPath, "%s%s", path, HUB_LABELS_EXTENSION);
+    *buildTime = 0;
+
+    HubLabels *labels = NULL;
+    if (!rebuild) {
+        double start = wallTime();
+        labels = loadHubLabels(indexPath);
+        if (labels != NULL && (labels->numNodes != graph->numNodes || labels->fingerprint != graphFingerprint(graph))) {
+            printf("Hub labels in %s were built for another version of the graph.\n", indexPath);
+            freeHubLabels(labels);
+            labels = NULL;
+        }
+        if (labels != NULL)
+            printf("Hub labels loaded from %s in %.6f seconds.\n", indexPath, wallTime() - start);
+    }
+
+    if (labels == NULL) {
+        double start = wallTime();
+        labels = buildHubLabels(graph);
+        *buildTime = wallTime() - start;
+        printf("Hub labels built in %.6f seconds.\n", *buildTime);
+        if (saveHubLabels(labels, indexPath))
+            printf("Hub labels saved to %s\n", indexPath);
+    }
+
+    free(indexPath);
+    return labels;
+}
+
+/**
+ * @brief Builds (or loads) a hub label distance oracle for the selected
+ * instances and compares its query latency with one dijkstraV2 run per query.
+ * The labels are checked against full dijkstraV2 distance vectors from a few
+ * random sources.
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if a label distance is wrong.
+ */
+int runOracle(int argc, const char *argv[]) {
+    InstanceSelection instances;
+    int numQueries = 1000000;
+    int numChecks = 10;
+    Random random = { 1 };
+    bool rebuild = false;
+    int failures = 0;
+
+    initInstanceSelection(&instances);
+    for (int i = 0; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (parseInstanceOption(argc, argv, &i, &instances)) {
+            continue;
+        } else if (strcmp(argv[i], "--queries") == 0 && value != NULL) {
+            numQueries = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--check") == 0 && value != NULL) {
+            numChecks = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--seed") == 0 && value != NULL) {
+            random.state = strtoull(value, NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "--rebuild") == 0) {
+            rebuild = true;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (numQueries < 1 || numChecks < 1) {
+        fprintf(stderr, "--queries and --check must be positive.\n");
+        return EXIT_FAILURE;
+    }
+    if (!resolveInstances(&instances, 0) || instances.numPaths == 0) {
+        fprintf(stderr, "No instances to run.\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int p = 0; p < instances.numPaths; p++) {
+        printf("\n==> %s\n", instances.paths[p]);
+
+        Graph *graph = loadGraph(instances.paths[p]);
+        if (graph == NULL) {
+            fprintf(stderr, ERROR_MSG_PROCESS_FILE);
+            continue;
+        }
+        int minWeight, maxWeight;
+        edgeWeightRange(graph, &minWeight, &maxWeight);
+        if (graph->numNodes == 0 || minWeight < 0) {
+            printf("---> Skipped: %s.\n", graph->numNodes == 0 ? "the graph is empty" : "the graph has negative weights");
+            freeGraph(graph);
+            continue;
+        }
+        printf("---> Nodes: %d, arcs: %d\n", graph->numNodes, graph->numEdges);
+
+        double buildTime;
+        HubLabels *labels = obtainHubLabels(graph, instances.paths[p], rebuild, &buildTime);
+        int numNodes = graph->numNodes;
+        long long numEntries = labels->outOffsets[numNodes] + labels->inOffsets[numNodes];
+        printf("---> Index: %.1f MB, %.1f hubs per label\n",
+               hubLabelBytes(labels) / 1048576.0, (double)numEntries / (2.0 * numNodes));
+
+        // Label queries on random pairs
+        int *pairs = (int *) trackedMalloc(MEM_BUFFERS, 2 * (size_t)numQueries * sizeof(int));
+        for (int q = 0; q < 2 * numQueries; q++) {
+            pairs[q] = (int)(nextRandom(&random) % (unsigned long long)numNodes);
+        }
+        int unreachable = 0;
+        double start = wallTime();
+        for (int q = 0; q < numQueries; q++) {
+            unreachable += hubLabelDistance(labels, pairs[2 * q], pairs[2 * q + 1]) == INT_MAX;
+        }
+        double labelTime = (wallTime() - start) / numQueries;
+        trackedFree(MEM_BUFFERS, pairs);
+
+        // Full dijkstraV2 runs from random sources: the cost of answering one
+        // query without the index, and the reference to check the labels against
+        int *dist = (int *) trackedMalloc(MEM_BUFFERS, numNodes * sizeof(int));
+        double dijkstraTime = 0;
+        int wrong = 0;
+        for (int c = 0; c < numChecks; c++) {
+            int src = (int)(nextRandom(&random) % (unsigned long long)numNodes);
+            start = wallTime();
+            dijkstraV2Distances(graph, src, dist);
+            dijkstraTime += wallTime() - start;
+            for (int v = 0; v < numNodes; v++) {
+                if (hubLabelDistance(labels, src, v) != dist[v]) {
+                    if (wrong == 0)
+                        printf("Mismatch: label distance %d -> %d is %d, Dijkstra found %d\n",
+                               src, v, hubLabelDistance(labels, src, v), dist[v]);
+                    wrong++;
+                }
+            }
+        }
+        dijkstraTime /= numChecks;
+        trackedFree(MEM_BUFFERS, dist);
+
+        printf("%d label queries: %.3f microseconds per query (%d unreachable pairs)\n",
+               numQueries, labelTime * 1e6, unreachable);
+        printf("Dijkstra (v2): %.3f microseconds per query, %.0fx slower\n",
+               dijkstraTime * 1e6, labelTime > 0 ? dijkstraTime / labelTime : 0.0);
+        if (buildTime > 0 && dijkstraTime > labelTime)
+            printf("---> Preprocessing pays off after %.0f queries\n", buildTime / (dijkstraTime - labelTime));
+        if (wrong > 0) {
+            printf("Check FAILED: %d of %lld distances differ.\n", wrong, (long long)numChecks * numNodes);
+            failures++;
+        } else {
+            printf("Check PASSED: %lld distances from %d sources.\n", (long long)numChecks * numNodes, numChecks);
+        }
+
+        freeHubLabels(labels);
+        freeGraph(graph);
+    }
+
+    freeInstanceSelection(&instances);
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,237 @@
+//
+//  pipeline.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "pipeline.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "utils.h"
+
+typedef enum {
+    ITEM_PENDING,
+    ITEM_READY,
+    ITEM_FAILED
+} ItemState;
+
+struct InstancePipeline {
+    LoadFunction load;
+    ReleaseFunction release;
+    void *context;
+    char *items;
+    size_t itemSize;
+    int numItems;
+    int depth;                  // Items loaded ahead of the consumer (0: load and release inline)
+    pthread_mutex_t lock;       // Guards everything below
+    pthread_cond_t loaded;      // An item finished loading
+    pthread_cond_t room;        // The consumer took an item, so loaders may run further ahead
+    pthread_cond_t released;    // An item was queued for release
+    ItemState *states;
+    int nextToLoad;
+    int nextToTake;
+    int *releaseQueue;          // Items waiting for the teardown thread
+    int releaseHead;
+    int releaseTail;
+    bool finishing;
+    pthread_t *loaders;
+    int numLoaders;
+    pthread_t reaper;
+    PipelineStats stats;
+};
+
+static void* loaderLoop(void *arg) {
+    InstancePipeline *pipeline = (InstancePipeline *) arg;
+
+    pthread_mutex_lock(&pipeline->lock);
+    for (;;) {
+        while (!pipeline->finishing && pipeline->nextToLoad < pipeline->numItems &&
+               pipeline->nextToLoad >= pipeline->nextToTake + pipeline->depth) {
+            pthread_cond_wait(&pipeline->room, &pipeline->lock);
+        }
+        if (pipeline->finishing || pipeline->nextToLoad >= pipeline->numItems)
+            break;
+        int index = pipeline->nextToLoad++;
+        pthread_mutex_unlock(&pipeline->lock);
+
+        double start = wallTime();
+        int ok = pipeline->load(pipeline->items + (size_t)index * pipeline->itemSize, index, pipeline->context);
+        double seconds = wallTime() - start;
+
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->states[index] = ok ? ITEM_READY : ITEM_FAILED;
+        pipeline->stats.loadSeconds += seconds;
+        pthread_cond_broadcast(&pipeline->loaded);
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+    return NULL;
+}
+
+/**
+ * @brief Teardown thread: frees released items until the pipeline finishes
+ * and its queue is empty.
+ */
+static void* reaperLoop(void *arg) {
+    InstancePipeline *pipeline = (InstancePipeline *) arg;
+
+    pthread_mutex_lock(&pipeline->lock);
+    for (;;) {
+        while (!pipeline->finishing && pipeline->releaseHead == pipeline->releaseTail) {
+            pthread_cond_wait(&pipeline->released, &pipeline->lock);
+        }
+        if (pipeline->releaseHead == pipeline->releaseTail)
+            break;
+        int index = pipeline->releaseQueue[pipeline->releaseHead++];
+        pthread_mutex_unlock(&pipeline->lock);
+
+        double start = wallTime();
+        pipeline->release(pipeline->items + (size_t)index * pipeline->itemSize, pipeline->context);
+        double seconds = wallTime() - start;
+
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->stats.releaseSeconds += seconds;
+    }
+    pthread_mutex_unlock(&pipeline->lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts loading a sequence of items on background threads.
+ *
+ * Loaders take the items in order and stay at most depth items ahead of the
+ * consumer, which bounds the memory held by loaded items. Released items are
+ * freed by a separate teardown thread. Items are stored in one array owned by
+ * the pipeline, so pointers to them stay valid until finishPipeline. With depth
+ * 0, nothing runs in the background: items are loaded by nextLoadedItem and
+ * freed by releaseItem on the calling thread.
+ *
+ * @param load Function that loads one item.
+ * @param release Function that frees one loaded item.
+ * @param context Passed to both functions.
+ * @param itemSize Size of one item.
+ * @param numItems Number of items.
+ * @param depth Items loaded ahead of the consumer.
+ * @param numLoaders Number of loader threads (at least 1 when depth > 0).
+ * @return The pipeline.
+ */
+InstancePipeline* startPipeline(LoadFunction load, ReleaseFunction release, void *context, size_t itemSize,
+                                int numItems, int depth, int numLoaders) {
+    InstancePipeline *pipeline = (InstancePipeline *) calloc(1, sizeof(InstancePipeline));
+    pipeline->load = load;
+    pipeline->release = release;
+    pipeline->context = context;
+    pipeline->items = (char *) calloc(numItems > 0 ? numItems : 1, itemSize);
+    pipeline->itemSize = itemSize;
+    pipeline->numItems = numItems;
+    pipeline->depth = depth > 0 ? depth : 0;
+    pipeline->states = (ItemState *) calloc(numItems > 0 ? numItems : 1, sizeof(ItemState));
+    pipeline->releaseQueue = (int *) malloc((numItems > 0 ? numItems : 1) * sizeof(int));
+    pthread_mutex_init(&pipeline->lock, NULL);
+    pthread_cond_init(&pipeline->loaded, NULL);
+    pthread_cond_init(&pipeline->room, NULL);
+    pthread_cond_init(&pipeline->released, NULL);
+
+    if (pipeline->depth > 0) {
+        pipeline->numLoaders = numLoaders > 0 ? numLoaders : 1;
+        pipeline->loaders = (pthread_t *) malloc(pipeline->numLoaders * sizeof(pthread_t));
+        for (int i = 0; i < pipeline->numLoaders; i++) {
+            pthread_create(&pipeline->loaders[i], NULL, loaderLoop, pipeline);
+        }
+        pthread_create(&pipeline->reaper, NULL, reaperLoop, pipeline);
+    }
+    return pipeline;
+}
+
+/**
+ * @brief Takes the next item in order, waiting for it to be loaded.
+ *
+ * @param loaded Output parameter: 1 if the item was loaded, 0 if loading failed.
+ * @return Pointer to the item, or NULL when all items were taken.
+ */
+void* nextLoadedItem(InstancePipeline *pipeline, int *loaded) {
+    if (pipeline->nextToTake >= pipeline->numItems)
+        return NULL;
+
+    int index = pipeline->nextToTake;
+    void *item = pipeline->items + (size_t)index * pipeline->itemSize;
+    double start = wallTime();
+
+    if (pipeline->depth == 0) {
+        *loaded = pipeline->load(item, index, pipeline->context);
+        pipeline->stats.loadSeconds += wallTime() - start;
+        pipeline->stats.waitSeconds += wallTime() - start;
+        pipeline->nextToTake++;
+        return item;
+    }
+
+    pthread_mutex_lock(&pipeline->lock);
+    while (pipeline->states[index] == ITEM_PENDING) {
+        pthread_cond_wait(&pipeline->loaded, &pipeline->lock);
+    }
+    *loaded = pipeline->states[index] == ITEM_READY;
+    pipeline->stats.waitSeconds += wallTime() - start;
+    pipeline->nextToTake++;
+    pthread_cond_broadcast(&pipeline->room);
+    pthread_mutex_unlock(&pipeline->lock);
+    return item;
+}
+
+/**
+ * @brief Releases an item the consumer is done with. With background threads
+ * it is freed by the teardown thread, off the consumer's critical path.
+ */
+void releaseItem(InstancePipeline *pipeline, void *item) {
+    if (pipeline->depth == 0) {
+        double start = wallTime();
+        pipeline->release(item, pipeline->context);
+        pipeline->stats.releaseSeconds += wallTime() - start;
+        return;
+    }
+
+    pthread_mutex_lock(&pipeline->lock);
+    pipeline->releaseQueue[pipeline->releaseTail++] = (int)(((char *) item - pipeline->items) / pipeline->itemSize);
+    pthread_cond_signal(&pipeline->released);
+    pthread_mutex_unlock(&pipeline->lock);
+}
+
+/**
+ * @brief Waits for the background threads, frees the items that were loaded
+ * but never taken and the pipeline itself.
+ *
+ * @param stats Output parameter with the time spent in each stage (may be NULL).
+ */
+void finishPipeline(InstancePipeline *pipeline, PipelineStats *stats) {
+    if (pipeline->depth > 0) {
+        pthread_mutex_lock(&pipeline->lock);
+        pipeline->finishing = true;
+        pthread_cond_broadcast(&pipeline->room);
+        pthread_cond_broadcast(&pipeline->released);
+        pthread_mutex_unlock(&pipeline->lock);
+        for (int i = 0; i < pipeline->numLoaders; i++) {
+            pthread_join(pipeline->loaders[i], NULL);
+        }
+        pthread_join(pipeline->reaper, NULL);
+
+        for (int i = pipeline->nextToTake; i < pipeline->nextToLoad; i++) {
+            if (pipeline->states[i] == ITEM_READY)
+                pipeline->release(pipeline->items + (size_t)i * pipeline->itemSize, pipeline->context);
+        }
+    }
+
+    if (stats != NULL)
+        *stats = pipeline->stats;
+
+    pthread_mutex_destroy(&pipeline->lock);
+    pthread_cond_destroy(&pipeline->loaded);
+    pthread_cond_destroy(&pipeline->room);
+    pthread_cond_destroy(&pipeline->released);
+    free(pipeline->items);
+    free(pipeline->states);
+    free(pipeline->releaseQueue);
+    free(pipeline->loaders);
+    free(pipeline);
+}
@@ -0,0 +1,42 @@
+//
+//  pipeline.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef pipeline_h
+#define pipeline_h
+
+#include <stdio.h>
+
+/**
+ * @brief Function that loads item number index into its slot.
+ *
+ * @return 1 if the item was loaded, 0 if it failed (and allocated nothing).
+ */
+typedef int (*LoadFunction)(void *item, int index, void *context);
+
+/**
+ * @brief Function that frees what LoadFunction allocated for an item.
+ */
+typedef void (*ReleaseFunction)(void *item, void *context);
+
+typedef struct InstancePipeline InstancePipeline;
+
+/**
+ * @brief Where the time of a pipelined run went.
+ */
+typedef struct {
+    double loadSeconds;     // Spent in LoadFunction, over all loaders
+    double waitSeconds;     // The consumer waited for an item to be loaded
+    double releaseSeconds;  // Spent in ReleaseFunction
+} PipelineStats;
+
+InstancePipeline* startPipeline(LoadFunction load, ReleaseFunction release, void *context, size_t itemSize,
+                                int numItems, int depth, int numLoaders);
+void* nextLoadedItem(InstancePipeline *pipeline, int *loaded);
+void releaseItem(InstancePipeline *pipeline, void *item);
+void finishPipeline(InstancePipeline *pipeline, PipelineStats *stats);
+
+#endif /* pipeline_h */
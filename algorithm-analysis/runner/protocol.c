@@ -0,0 +1,84 @@
+//
+//  protocol.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "protocol.h"
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * @brief Reads one message, waiting for all of its bytes.
+ *
+ * @return 1 if the message was read, 0 if the peer closed the connection
+ * before it started, -1 on error or on a truncated message.
+ */
+int readMessage(int fd, void *message, size_t size) {
+    char *p = (char *) message;
+    size_t done = 0;
+
+    while (done < size) {
+        ssize_t n = read(fd, p + done, size - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return n == 0 && done == 0 ? 0 : -1;
+        done += (size_t)n;
+    }
+    return 1;
+}
+
+/**
+ * @brief Writes one message, waiting for all of its bytes.
+ *
+ * @return 1 on success, 0 on error.
+ */
+int writeMessage(int fd, const void *message, size_t size) {
+    const char *p = (const char *) message;
+    size_t done = 0;
+
+    while (done < size) {
+        ssize_t n = write(fd, p + done, size - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 0;
+        done += (size_t)n;
+    }
+    return 1;
+}
+
+/**
+ * @brief Opens a connection to the query server.
+ *
+ * @param socketPath Path of the server's Unix domain socket.
+ * @return The connected socket, or -1 on error.
+ */
+int connectToServer(const char *socketPath) {
+    struct sockaddr_un address;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    if (connect(fd, (struct sockaddr *) &address, sizeof(address)) < 0) {
+        int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+    return fd;
+}
@@ -0,0 +1,71 @@
+//
+//  protocol.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef protocol_h
+#define protocol_h
+
+#include <stdio.h>
+#include <stdint.h>
+
+/**
+ * Binary protocol of the query server. Client and server run on the same
+ * machine (the socket is a Unix domain socket), so messages are fixed-size
+ * structs in native byte order. A connection carries any number of requests;
+ * every request gets one QueryResponse, followed by a GraphInfo for
+ * QUERY_INFO and a LatencySummary for QUERY_STATS when the status is
+ * QUERY_OK.
+ */
+
+// Request types
+#define QUERY_DISTANCE 1        // Distance from src to dest
+#define QUERY_INFO 2            // Size of a graph
+#define QUERY_STATS 3           // Latency of the distance queries served so far
+#define QUERY_SHUTDOWN 4        // Stop the server
+
+// Response status
+#define QUERY_OK 0
+#define QUERY_UNREACHABLE 1
+#define QUERY_NEGATIVE_CYCLE 2  // A negative cycle is reachable from src
+#define QUERY_BAD_REQUEST 3
+
+// Graph number of QUERY_STATS for the latency over all graphs
+#define QUERY_ALL_GRAPHS UINT32_MAX
+
+typedef struct {
+    uint32_t type;
+    uint32_t graph;             // Index of the graph, in the order the server loaded them
+    int32_t src;
+    int32_t dest;
+} QueryRequest;
+
+typedef struct {
+    uint32_t status;
+    int32_t distance;
+    uint64_t nanos;             // Time the server spent on the request
+} QueryResponse;
+
+typedef struct {
+    int32_t numNodes;
+    int32_t numEdges;
+    uint32_t numGraphs;         // Number of graphs served
+    uint32_t indexed;           // 1 if distances come from hub labels
+} GraphInfo;
+
+typedef struct {
+    uint64_t count;
+    uint64_t meanNanos;
+    uint64_t p50Nanos;
+    uint64_t p90Nanos;
+    uint64_t p99Nanos;
+    uint64_t maxNanos;
+} LatencySummary;
+
+int readMessage(int fd, void *message, size_t size);
+int writeMessage(int fd, const void *message, size_t size);
+int connectToServer(const char *socketPath);
+
+#endif /* protocol_h */
@@ -0,0 +1,265 @@
+//
+//  query_command.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "runner.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "constants.h"
+#include "utils.h"
+#include "generator.h"
+#include "statistics.h"
+#include "protocol.h"
+
+/**
+ * @brief One client connection of a random query run.
+ */
+typedef struct {
+    const char *socketPath;
+    uint32_t graph;
+    int numNodes;
+    int numQueries;
+    Random random;
+    LatencyHistogram latency;   // Round trip of every query
+    long long unreachable;
+    int failed;                 // Bad requests and connection errors
+} QueryClient;
+
+/**
+ * @brief Sends one request and reads its response and payload.
+ *
+ * @return 1 on success, 0 if the connection failed.
+ */
+static int sendRequest(int fd, const QueryRequest *request, QueryResponse *response, void *payload, size_t payloadSize) {
+    if (!writeMessage(fd, request, sizeof(*request)) || readMessage(fd, response, sizeof(*response)) != 1)
+        return 0;
+    if (payload != NULL && response->status == QUERY_OK)
+        return readMessage(fd, payload, payloadSize) == 1;
+    return 1;
+}
+
+static void* runQueryClient(void *arg) {
+    QueryClient *client = (QueryClient *) arg;
+    int fd = connectToServer(client->socketPath);
+    if (fd < 0) {
+        client->failed = client->numQueries;
+        return NULL;
+    }
+
+    for (int q = 0; q < client->numQueries; q++) {
+        QueryRequest request = { QUERY_DISTANCE, client->graph,
+                                 (int32_t)(nextRandom(&client->random) % (unsigned long long)client->numNodes),
+                                 (int32_t)(nextRandom(&client->random) % (unsigned long long)client->numNodes) };
+        QueryResponse response;
+        double start = wallTime();
+        if (!sendRequest(fd, &request, &response, NULL, 0)) {
+            client->failed += client->numQueries - q;
+            break;
+        }
+        recordLatency(&client->latency, (unsigned long long)((wallTime() - start) * 1e9));
+        client->unreachable += response.status == QUERY_UNREACHABLE;
+        client->failed += response.status == QUERY_BAD_REQUEST;
+    }
+    close(fd);
+    return NULL;
+}
+
+static void printLatencySummary(const char *label, const LatencySummary *summary) {
+    printf("%s: %llu queries, mean %.1f us, p50 %.1f us, p90 %.1f us, p99 %.1f us, max %.1f us\n",
+           label, (unsigned long long)summary->count, summary->meanNanos / 1e3, summary->p50Nanos / 1e3,
+           summary->p90Nanos / 1e3, summary->p99Nanos / 1e3, summary->maxNanos / 1e3);
+}
+
+/**
+ * @brief Sends N random distance queries to one graph of the server over C
+ * concurrent connections and prints the round-trip latency.
+ *
+ * @return 1 if every query was answered, 0 otherwise.
+ */
+static int runRandomQueries(const char *socketPath, uint32_t graph, int numQueries, int numClients, Random *random) {
+    int fd = connectToServer(socketPath);
+    if (fd < 0) {
+        perror(socketPath);
+        return 0;
+    }
+    QueryRequest request = { QUERY_INFO, graph, 0, 0 };
+    QueryResponse response;
+    GraphInfo info;
+    int ok = sendRequest(fd, &request, &response, &info, sizeof(info));
+    close(fd);
+    if (!ok || response.status != QUERY_OK) {
+        fprintf(stderr, "Graph %u is not served.\n", graph);
+        return 0;
+    }
+
+    QueryClient *clients = (QueryClient *) calloc(numClients, sizeof(QueryClient));
+    pthread_t *threads = (pthread_t *) malloc(numClients * sizeof(pthread_t));
+    double start = wallTime();
+    for (int c = 0; c < numClients; c++) {
+        clients[c].socketPath = socketPath;
+        clients[c].graph = graph;
+        clients[c].numNodes = info.numNodes;
+        clients[c].numQueries = numQueries / numClients + (c < numQueries % numClients);
+        clients[c].random.state = nextRandom(random);
+        initLatencyHistogram(&clients[c].latency);
+        pthread_create(&threads[c], NULL, runQueryClient, &clients[c]);
+    }
+
+    LatencyHistogram *latency = (LatencyHistogram *) malloc(sizeof(LatencyHistogram));
+    initLatencyHistogram(latency);
+    long long unreachable = 0;
+    int failed = 0;
+    for (int c = 0; c < numClients; c++) {
+        pthread_join(threads[c], NULL);
+        mergeLatency(latency, &clients[c].latency);
+        unreachable += clients[c].unreachable;
+        failed += clients[c].failed;
+    }
+    double elapsed = wallTime() - start;
+
+    printf("Graph %u: %d nodes, %d arcs%s\n", graph, info.numNodes, info.numEdges, info.indexed ? ", hub labels" : "");
+    LatencySummary summary = { latency->count, latency->count > 0 ? latency->totalNanos / latency->count : 0,
+                               latencyPercentile(latency, 0.50), latencyPercentile(latency, 0.90),
+                               latencyPercentile(latency, 0.99), latency->maxNanos };
+    printLatencySummary("Round trip", &summary);
+    printf("Throughput: %.0f queries per second over %d connection%s (%lld unreachable pairs)\n",
+           elapsed > 0 ? latency->count / elapsed : 0.0, numClients, numClients == 1 ? "" : "s", unreachable);
+    if (failed > 0)
+        printf("%d queries FAILED.\n", failed);
+
+    free(latency);
+    free(clients);
+    free(threads);
+    return failed == 0;
+}
+
+/**
+ * @brief Client of the query server: answers one distance query, runs random
+ * queries to measure latency, prints the server's latency statistics or
+ * stops it.
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if a request failed.
+ */
+int runQuery(int argc, const char *argv[]) {
+    const char *socketPath = SERVER_SOCKET_PATH;
+    uint32_t graph = 0;
+    bool graphGiven = false;
+    int numRandom = 0;
+    int numClients = 1;
+    Random random = { 1 };
+    bool stats = false;
+    bool stop = false;
+    int endpoints[2];
+    int numEndpoints = 0;
+
+    for (int i = 0; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(argv[i], "--socket") == 0 && value != NULL) {
+            socketPath = value;
+            i++;
+        } else if (strcmp(argv[i], "--graph") == 0 && value != NULL) {
+            graph = (uint32_t)atoi(value);
+            graphGiven = true;
+            i++;
+        } else if (strcmp(argv[i], "--random") == 0 && value != NULL) {
+            numRandom = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--clients") == 0 && value != NULL) {
+            numClients = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--seed") == 0 && value != NULL) {
+            random.state = strtoull(value, NULL, 10);
+            i++;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            stats = true;
+        } else if (strcmp(argv[i], "--shutdown") == 0) {
+            stop = true;
+        } else if (argv[i][0] != '-' && numEndpoints < 2) {
+            endpoints[numEndpoints++] = atoi(argv[i]);
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (numEndpoints == 1 || numRandom < 0 || numClients < 1) {
+        fprintf(stderr, "Usage: algorithm-analysis query [--graph G] SRC DEST, or --random N [--clients C].\n");
+        return EXIT_FAILURE;
+    }
+    if (numEndpoints == 0 && numRandom == 0 && !stats && !stop)
+        stats = true;
+
+    int failures = 0;
+    if (numEndpoints == 2) {
+        int fd = connectToServer(socketPath);
+        if (fd < 0) {
+            perror(socketPath);
+            return EXIT_FAILURE;
+        }
+        QueryRequest request = { QUERY_DISTANCE, graph, endpoints[0], endpoints[1] };
+        QueryResponse response;
+        if (!sendRequest(fd, &request, &response, NULL, 0)) {
+            fprintf(stderr, "Connection to the server failed.\n");
+            failures++;
+        } else if (response.status == QUERY_OK) {
+            printf("Distance %d -> %d: %d (%.1f us on the server)\n", endpoints[0], endpoints[1],
+                   response.distance, response.nanos / 1e3);
+        } else if (response.status == QUERY_UNREACHABLE) {
+            printf("Distance %d -> %d: unreachable (%.1f us on the server)\n", endpoints[0], endpoints[1],
+                   response.nanos / 1e3);
+        } else if (response.status == QUERY_NEGATIVE_CYCLE) {
+            printf("Distance %d -> %d: undefined, a negative cycle is reachable from %d\n",
+                   endpoints[0], endpoints[1], endpoints[0]);
+        } else {
+            fprintf(stderr, "Bad request: graph %u has no nodes %d and %d.\n", graph, endpoints[0], endpoints[1]);
+            failures++;
+        }
+        close(fd);
+    }
+
+    if (numRandom > 0 && !runRandomQueries(socketPath, graph, numRandom, numClients, &random))
+        failures++;
+
+    if (stats || stop) {
+        int fd = connectToServer(socketPath);
+        if (fd < 0) {
+            perror(socketPath);
+            return EXIT_FAILURE;
+        }
+        QueryResponse response;
+        if (stats) {
+            QueryRequest request = { QUERY_STATS, graphGiven ? graph : QUERY_ALL_GRAPHS, 0, 0 };
+            LatencySummary summary;
+            if (!sendRequest(fd, &request, &response, &summary, sizeof(summary)) || response.status != QUERY_OK) {
+                fprintf(stderr, "Latency statistics are not available.\n");
+                failures++;
+            } else {
+                printLatencySummary("Server", &summary);
+            }
+        }
+        if (stop) {
+            QueryRequest request = { QUERY_SHUTDOWN, 0, 0, 0 };
+            if (!sendRequest(fd, &request, &response, NULL, 0)) {
+                fprintf(stderr, "Connection to the server failed.\n");
+                failures++;
+            } else {
+                printf("Server stopping.\n");
+            }
+        }
+        close(fd);
+    }
+
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
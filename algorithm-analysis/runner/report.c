@@ -0,0 +1,136 @@
+//
+//  report.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "report.h"
+
+#include <limits.h>
+#include <time.h>
+
+/**
+ * @brief Prints a shortest path result in the console format of the runs.
+ */
+void printShortestPathResult(const ShortestPathResult *result) {
+    if (result->negativeCycle) {
+        printf("Graph contains a negative weight cycle\n");
+    } else if (result->distance == INT_MAX) {
+        printf("Shortest distance from node %d to node %d: Infinity (no path)\n", result->src, result->dest);
+    } else {
+        printf("Shortest distance from node %d to node %d: %d\n", result->src, result->dest, result->distance);
+    }
+}
+
+/**
+ * @brief 64-bit FNV-1a hash of a distance vector. Two runs that found the
+ * same distances have the same checksum, so results can be compared across
+ * algorithms, machines and commits without storing the vectors.
+ */
+unsigned long long distanceChecksum(const int *dist, int numNodes) {
+    return stridedDistanceChecksum(dist, numNodes, 1);
+}
+
+/**
+ * @brief distanceChecksum of a vector whose entries are stride ints apart, such
+ * as one query of the node-major results of interleavedBellmanFord.
+ */
+unsigned long long stridedDistanceChecksum(const int *dist, int numNodes, int stride) {
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    for (int v = 0; v < numNodes; v++) {
+        unsigned int value = (unsigned int)dist[(size_t)v * stride];
+        for (int b = 0; b < 4; b++) {
+            hash = (hash ^ ((value >> (8 * b)) & 0xFF)) * 0x100000001B3ULL;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Returns the number of nodes with a finite distance.
+ */
+int countReachable(const int *dist, int numNodes) {
+    int count = 0;
+    for (int v = 0; v < numNodes; v++) {
+        count += dist[v] != INT_MAX;
+    }
+    return count;
+}
+
+/**
+ * @brief Writes a string as a JSON string literal.
+ */
+static void writeJsonString(FILE *fp, const char *text) {
+    fputc('"', fp);
+    for (const unsigned char *c = (const unsigned char *) text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(fp, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(fp, "\\u%04x", *c);
+        } else {
+            fputc(*c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+static void writeMemoryCounters(FILE *fp, const char *name, const MemoryCounters *counters) {
+    fprintf(fp, "\"%s\":{\"bytes\":%lld,\"allocations\":%lld,\"peak_bytes\":%lld}",
+            name, counters->bytesAllocated, counters->allocations, counters->peakBytes);
+}
+
+/**
+ * @brief Writes one run as a single line of JSON (JSON Lines). Unreachable
+ * distances are written as null. The record is formatted with one fprintf
+ * per group of fields and no allocation, so it can be left on for every run.
+ *
+ * @param fp Output stream.
+ * @param record The run.
+ */
+void writeRunRecord(FILE *fp, const RunRecord *record) {
+    fprintf(fp, "{\"version\":%d,\"time\":%lld,\"instance\":", RUN_RECORD_VERSION, (long long)time(NULL));
+    writeJsonString(fp, record->instance);
+    fprintf(fp, ",\"nodes\":%d,\"arcs\":%d,\"min_weight\":%d,\"max_weight\":%d,\"load_seconds\":%.9f,\"graph_bytes\":%lld",
+            record->numNodes, record->numArcs, record->minWeight, record->maxWeight, record->loadSeconds,
+            record->graphBytes);
+    fprintf(fp, ",\"algorithm\":");
+    writeJsonString(fp, record->algorithm);
+    fprintf(fp, ",\"source\":%d,\"target\":%d,\"repetition\":%d,\"threads\":%d,\"jobs\":%d",
+            record->result.src, record->result.dest, record->repetition, record->numThreads, record->numWorkers);
+
+    if (record->skipped) {
+        fprintf(fp, ",\"skipped\":true}\n");
+        return;
+    }
+
+    fprintf(fp, ",\"skipped\":false,\"seconds\":%.9f,\"negative_cycle\":%s,\"distance\":",
+            record->seconds, record->result.negativeCycle ? "true" : "false");
+    if (record->result.negativeCycle || record->result.distance == INT_MAX) {
+        fprintf(fp, "null");
+    } else {
+        fprintf(fp, "%d", record->result.distance);
+    }
+    fprintf(fp, ",\"reachable\":%d,\"checksum\":\"%016llx\",\"certificate\":", record->reachable, record->checksum);
+    if (record->certificate != NULL) {
+        writeJsonString(fp, record->certificate);
+    } else {
+        fprintf(fp, "null");
+    }
+
+    fprintf(fp, ",\"memory\":{");
+    writeMemoryCounters(fp, "heap", &record->memory.categories[MEM_HEAP]);
+    fputc(',', fp);
+    writeMemoryCounters(fp, "buffers", &record->memory.categories[MEM_BUFFERS]);
+    fprintf(fp, ",\"peak_bytes\":%lld,\"max_rss_bytes\":%lld}",
+            record->memory.totalPeakBytes, record->memory.maxResidentBytes);
+
+    if (record->operations != NULL) {
+        fprintf(fp, ",\"operations\":{");
+        for (int c = 0; c < OP_NUM_COUNTERS; c++) {
+            fprintf(fp, "%s\"%s\":%lld", c > 0 ? "," : "", operationCounterName(c), record->operations->counts[c]);
+        }
+        fputc('}', fp);
+    }
+    fprintf(fp, "}\n");
+}
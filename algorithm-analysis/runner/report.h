@@ -0,0 +1,55 @@
+//
+//  report.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef report_h
+#define report_h
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "sssp_result.h"
+#include "memory_stats.h"
+#include "operation_stats.h"
+
+#define RUN_RECORD_VERSION 1
+
+/**
+ * @brief Everything known about one timed run, written as one JSON object per
+ * line by writeRunRecord. All strings are borrowed.
+ */
+typedef struct {
+    // Instance
+    const char *instance;
+    int numNodes;
+    int numArcs;
+    int minWeight;
+    int maxWeight;
+    double loadSeconds;
+    long long graphBytes;
+    // Algorithm and parameters
+    const char *algorithm;
+    int repetition;             // 1-based
+    int numThreads;             // Threads of the parallel algorithms (0: one per processor)
+    int numWorkers;             // Batch jobs run at a time
+    bool skipped;               // The algorithm cannot run on the instance; only the fields above are written
+    // Timing and memory
+    double seconds;
+    MemoryStats memory;
+    const OperationStats *operations;   // NULL when the build has no counters
+    // Result
+    ShortestPathResult result;
+    int reachable;              // Nodes with a finite distance
+    unsigned long long checksum;
+    const char *certificate;    // "ok", "failed" or NULL when not verified
+} RunRecord;
+
+void printShortestPathResult(const ShortestPathResult *result);
+unsigned long long distanceChecksum(const int *dist, int numNodes);
+unsigned long long stridedDistanceChecksum(const int *dist, int numNodes, int stride);
+int countReachable(const int *dist, int numNodes);
+void writeRunRecord(FILE *fp, const RunRecord *record);
+
+#endif /* report_h */
@@ -0,0 +1,1428 @@
+//
+//  runner.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "runner.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "constants.h"
+#include "graph.h"
+#include "utils.h"
+#include "generator.h"
+#include "bellman_ford_improved.h"
+#include "bellman_ford_sorted.h"
+#include "negative_cycle.h"
+#include "dijkstra_v1.h"
+#include "dijkstra_v2.h"
+#include "compressed_graph.h"
+#include "compressed_sssp.h"
+#include "undirected_graph.h"
+#include "undirected_sssp.h"
+#include "dense_graph.h"
+#include "dense_sssp.h"
+#include "integer_dijkstra.h"
+#include "parallel_sssp.h"
+#include "sharded_graph.h"
+#include "sharded_sssp.h"
+#include "certificate.h"
+#include "memory_stats.h"
+#include "operation_stats.h"
+#include "instances.h"
+#include "scheduler.h"
+#include "report.h"
+#include "baseline.h"
+#include "graph_features.h"
+#include "graph_reduction.h"
+#include "cost_model.h"
+#include "pipeline.h"
+
+#define MAX_SIZES 64
+
+/**
+ * @brief Graph representation an algorithm runs on. Batch runs build the
+ * representations needed by the selected algorithms when an instance is loaded.
+ */
+typedef enum {
+    REPR_LISTS,             // Graph with linked adjacency lists
+    REPR_COMPRESSED,        // CompressedGraph
+    REPR_UNDIRECTED,        // UndirectedGraph (symmetric graphs only)
+    REPR_SHARDED            // ShardedGraph
+} GraphRepresentation;
+
+/**
+ * @brief An instance loaded for a batch run, shared by all its jobs.
+ */
+typedef struct {
+    const char *path;
+    Graph *graph;                   // The graph the algorithms run on: the reduced one with --reduce
+    Graph *original;                // The graph as loaded; distances are checked against it
+    GraphReduction *reduction;      // Built with --reduce, or NULL
+    double reduceTime;
+    double loadTime;
+    MemoryCounters graphMemory;     // Graph memory, measured while loading
+    CompressedGraph *compressed;    // Built only if a selected algorithm needs it
+    double compressTime;
+    UndirectedGraph *undirected;    // Built only if a selected algorithm needs it and the graph is symmetric
+    double undirectedTime;
+    DenseGraph *dense;              // Built for dense graphs if a selected algorithm uses it
+    double denseTime;
+    ShardedGraph *sharded;          // Built only if a selected algorithm needs it
+    double shardTime;
+    int minWeight;                  // Range of the edge weights
+    int maxWeight;
+    GraphFeatures features;         // Inputs of the cost model
+    int numThreads;                 // Threads of the parallel algorithms (--threads)
+    int autoAlgorithm;              // Algorithm picked by the cost model (--algorithms auto), or -1
+    double autoPredicted;           // Its predicted running time (0 without a calibrated candidate)
+} BatchInstance;
+
+/**
+ * @brief An algorithm that can be selected in batch runs.
+ */
+typedef struct {
+    const char *name;       // Name used on the command line and in the CSV output
+    const char *label;      // Name used in the console output
+    GraphRepresentation representation;
+    int (*distances)(BatchInstance *instance, int src, int *dist);  // Returns 1 on a negative cycle, -1 if the run failed
+    int selectedByDefault;  // Run when --algorithms is not given
+    int nonNegativeWeights; // Skipped on graphs with negative weights
+    int negativeWeights;    // Exact on graphs with negative weights (auto only picks these for them)
+} BatchAlgorithm;
+
+static int runBellmanFord(BatchInstance *instance, int src, int *dist) {
+    if (instance->dense != NULL) {
+        return bellmanFordDenseDistances(instance->dense, src, dist);
+    }
+    return bellmanFordImprovedDistances(instance->graph, src, dist);
+}
+
+static int runBellmanFordSorted(BatchInstance *instance, int src, int *dist) {
+    return bellmanFordSortedDistances(instance->graph, src, dist);
+}
+
+static int runBellmanFordTarjan(BatchInstance *instance, int src, int *dist) {
+    return bellmanFordTarjanDistances(instance->graph, src, dist, NULL);
+}
+
+static int runDijkstraV1(BatchInstance *instance, int src, int *dist) {
+    if (instance->dense != NULL) {
+        dijkstraDenseDistances(instance->dense, src, dist);
+    } else {
+        dijkstraV1Distances(instance->graph, src, dist);
+    }
+    return 0;
+}
+
+static int runDijkstraV2(BatchInstance *instance, int src, int *dist) {
+    dijkstraV2Distances(instance->graph, src, dist);
+    return 0;
+}
+
+static int runBellmanFordCompressed(BatchInstance *instance, int src, int *dist) {
+    return bellmanFordCompressedDistances(instance->compressed, src, dist);
+}
+
+static int runDijkstraCompressed(BatchInstance *instance, int src, int *dist) {
+    dijkstraCompressedDistances(instance->compressed, src, dist);
+    return 0;
+}
+
+static int runBellmanFordUndirected(BatchInstance *instance, int src, int *dist) {
+    return bellmanFordUndirectedDistances(instance->undirected, src, dist);
+}
+
+static int runDijkstraUndirected(BatchInstance *instance, int src, int *dist) {
+    dijkstraUndirectedDistances(instance->undirected, src, dist);
+    return 0;
+}
+
+static int runIntegerDijkstra(BatchInstance *instance, int src, int *dist) {
+    integerDijkstraDistances(instance->graph, src, instance->maxWeight, dist);
+    return 0;
+}
+
+static int runDial(BatchInstance *instance, int src, int *dist) {
+    dialDistances(instance->graph, src, instance->maxWeight, dist);
+    return 0;
+}
+
+static int runRadixHeap(BatchInstance *instance, int src, int *dist) {
+    radixHeapDistances(instance->graph, src, dist);
+    return 0;
+}
+
+static int runMultiQueue(BatchInstance *instance, int src, int *dist) {
+    multiQueueDistances(instance->graph, src, instance->numThreads, dist);
+    return 0;
+}
+
+static int runShardedBellmanFord(BatchInstance *instance, int src, int *dist) {
+    return shardedBellmanFordDistances(instance->sharded, src, dist);
+}
+
+static const BatchAlgorithm batchAlgorithms[] = {
+    { "bf", "Bellman-Ford", REPR_LISTS, runBellmanFord, 1, 0, 1 },
+    { "bfd", "Bellman-Ford (by destination)", REPR_LISTS, runBellmanFordSorted, 0, 0, 1 },
+    { "bft", "Bellman-Ford (Tarjan)", REPR_LISTS, runBellmanFordTarjan, 0, 0, 1 },
+    { "d1", "Dijkstra (v1)", REPR_LISTS, runDijkstraV1, 1, 0, 0 },
+    { "d2", "Dijkstra (v2)", REPR_LISTS, runDijkstraV2, 1, 0, 0 },
+    { "bfc", "Bellman-Ford (compressed)", REPR_COMPRESSED, runBellmanFordCompressed, 0, 0, 1 },
+    { "dc", "Dijkstra (compressed)", REPR_COMPRESSED, runDijkstraCompressed, 0, 1, 0 },
+    { "bfu", "Bellman-Ford (undirected)", REPR_UNDIRECTED, runBellmanFordUndirected, 0, 0, 1 },
+    { "du", "Dijkstra (undirected)", REPR_UNDIRECTED, runDijkstraUndirected, 0, 1, 0 },
+    { "di", "Dijkstra (integer)", REPR_LISTS, runIntegerDijkstra, 0, 1, 0 },
+    { "dial", "Dial", REPR_LISTS, runDial, 0, 1, 0 },
+    { "radix", "Radix heap", REPR_LISTS, runRadixHeap, 0, 1, 0 },
+    { "mq", "MultiQueue (parallel)", REPR_LISTS, runMultiQueue, 0, 1, 0 },
+    { "sbf", "Bellman-Ford (sharded)", REPR_SHARDED, runShardedBellmanFord, 0, 0, 1 },
+};
+
+#define NUM_BATCH_ALGORITHMS ((int)(sizeof(batchAlgorithms) / sizeof(batchAlgorithms[0])))
+
+/**
+ * @brief Options shared by the generate command and the synthetic instances of
+ * the batch command.
+ */
+typedef struct {
+    GeneratorOptions generator;
+    GraphFileFormat format;
+    int sizes[MAX_SIZES];
+    int numSizes;
+    const char *outDir;
+} SyntheticOptions;
+
+static void printUsage(void) {
+    printf("Usage:\n");
+    printf("  algorithm-analysis                     interactive mode\n");
+    printf("  algorithm-analysis batch [options] [PATH...]\n");
+    printf("      --algorithms LIST     comma-separated list of bf, bfd, bft, d1, d2, bfc, dc,\n");
+    printf("                            bfu, du, di, dial, radix, mq, sbf (default: bf, d1, d2);\n");
+    printf("                            auto picks one per instance with the cost model\n");
+    printf("      --repeat N            repetitions of each run (default: 1)\n");
+    printf("      --source S            source node (default: 0)\n");
+    printf("      --suite NAME          ALUE, ALUT, DMXA, test_set1, test_set2 or all\n");
+    printf("      --data-dir DIR        directory with the suites (default: DIR_PATH)\n");
+    printf("      --csv FILE            write one CSV row per run to FILE\n");
+    printf("      --jsonl FILE          append one JSON record per run to FILE (- for stdout,\n");
+    printf("                            the report then goes to stderr)\n");
+    printf("      --save-baseline FILE  save the running times of every run to FILE\n");
+    printf("      --baseline FILE       compare the running times with a saved baseline and\n");
+    printf("                            exit with an error if some run got slower\n");
+    printf("      --alpha A             significance level of the comparison (default: 0.05)\n");
+    printf("      --threshold PCT       smallest change of the median time reported (default: 5)\n");
+    printf("      --min-delta S         smallest change in seconds reported (default: 0.001)\n");
+    printf("      --calibrate FILE      fit a cost model of each algorithm to the running times\n");
+    printf("                            and save it to FILE\n");
+    printf("      --model FILE          cost model of auto (default: DIR/cost_model.txt)\n");
+    printf("      --verify              check every distance vector with a shortest path\n");
+    printf("                            certificate and compare the algorithms' results\n");
+    printf("      --reduce              drop the nodes the source does not reach and remove the\n");
+    printf("                            nodes of degree 1 and 2 before running the algorithms\n");
+    printf("      --jobs N              run N jobs at a time (default: 1, 0 for one per processor)\n");
+    printf("      --pin                 pin each worker to its own processor (Linux only)\n");
+    printf("      --threads T           threads of each parallel run (mq; default: 0, one per processor)\n");
+    printf("      --shards P            processes of each sharded run, one per range of nodes\n");
+    printf("                            (sbf; default: 0, one per processor)\n");
+    printf("      --dense-threshold D   run bf and d1 on a weight matrix for graphs of density\n");
+    printf("                            D or more (arcs / n(n - 1); default: 0.25, above 1 never)\n");
+    printf("      --pipeline N          load up to N instances ahead on background threads while\n");
+    printf("                            the runs go on, and free them in the background\n");
+    printf("      --trace DIR           write the frontier and updates of every iteration of the\n");
+    printf("                            first repetition to DIR/INSTANCE.ALGORITHM.csv (needs a\n");
+    printf("                            build with -DOPERATION_COUNTERS, which also prints the\n");
+    printf("                            operation counts of every run)\n");
+    printf("      --synthetic TYPE      also generate and run synthetic instances\n");
+    printf("                            (accepts the generator options below)\n");
+    printf("  algorithm-analysis verify [options] [PATH...]   same as batch --verify\n");
+    printf("  algorithm-analysis terminals [--k K] [--source S] [PATH...]\n");
+    printf("      multi-source Dijkstra from the .stp terminals (graph Voronoi diagram);\n");
+    printf("      with --k, the K terminals nearest to S from a single early-stopping run\n");
+    printf("  algorithm-analysis steiner [--heuristic tm|mehlhorn|all] [--roots R] [--threads T] [PATH...]\n");
+    printf("      Steiner trees for the .stp terminals: shortest path heuristic started from R\n");
+    printf("      terminals (16 by default, 0 for all) in parallel, and the Mehlhorn heuristic\n");
+    printf("  algorithm-analysis oracle [--queries N] [--check C] [--seed S] [--rebuild] [PATH...]\n");
+    printf("      hub label distance oracle, saved next to each instance as PATH.hl: N random\n");
+    printf("      queries timed against dijkstraV2 and checked against C full Dijkstra runs\n");
+    printf("  algorithm-analysis serve [--socket PATH] [--threads T] [--index] [--rebuild] [PATH...]\n");
+    printf("      keep the instances loaded and answer distance queries on a Unix socket\n");
+    printf("      (default: %s) with T workers; --index answers them from hub labels\n", SERVER_SOCKET_PATH);
+    printf("  algorithm-analysis query [--socket PATH] [--graph G] [SRC DEST] [--random N]\n");
+    printf("                           [--clients C] [--seed S] [--stats] [--shutdown]\n");
+    printf("      client of serve: one distance, N random queries over C connections with\n");
+    printf("      their round-trip latency, the server's latency statistics, or stop it\n");
+    printf("  algorithm-analysis multiquery [--algorithm d|bf] [--queries N] [--width W] [--seed S] [PATH...]\n");
+    printf("      throughput of N random single-source queries on one core, one at a time and\n");
+    printf("      interleaved W at a time (default: 64 queries, width 8, Dijkstra)\n");
+    printf("  algorithm-analysis dynamic [--batches B] [--updates U] [--source S] [--seed S] [PATH...]\n");
+    printf("      shortest paths from S repaired after each of B random batches of U edge\n");
+    printf("      insertions, deletions and weight changes, checked against dijkstraV2\n");
+    printf("      (default: 100 batches of 10 updates)\n");
+    printf("  algorithm-analysis generate --type TYPE --nodes LIST [options]\n");
+    printf("      --type TYPE           gnp, grid, rmat or complete\n");
+    printf("      --nodes LIST          comma-separated list of node counts\n");
+    printf("      --degree D            expected average degree (default: 8)\n");
+    printf("      --max-weight W        weights are drawn from [1, W] (default: 100)\n");
+    printf("      --seed S              random seed (default: 1)\n");
+    printf("      --format FORMAT       stp, dat or bin (default: bin)\n");
+    printf("      --out DIR             output directory (default: DIR_PATH/synthetic)\n");
+}
+
+/**
+ * @brief Parses a comma-separated list of positive integers.
+ *
+ * @return Number of values parsed, or -1 if the list is invalid.
+ */
+static int parseIntList(const char *list, int *values, int maxValues) {
+    int count = 0;
+    const char *p = list;
+    while (*p != '\0') {
+        char *end;
+        long value = strtol(p, &end, 10);
+        if (end == p || value <= 0 || count == maxValues) {
+            return -1;
+        }
+        values[count++] = (int)value;
+        p = (*end == ',') ? end + 1 : end;
+        if (*end != ',' && *end != '\0') {
+            return -1;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Consumes one generator option at argv[*i], if it is one.
+ *
+ * @return 1 if the option was consumed, 0 if it is not a generator option and
+ *         -1 if it is invalid.
+ */
+static int parseSyntheticOption(int argc, const char *argv[], int *i, SyntheticOptions *options) {
+    const char *option = argv[*i];
+    const char *value = (*i + 1 < argc) ? argv[*i + 1] : NULL;
+    int ok = 1;
+
+    if (strcmp(option, "--type") == 0 || strcmp(option, "--synthetic") == 0) {
+        ok = value != NULL && parseGraphType(value, &options->generator.type);
+    } else if (strcmp(option, "--nodes") == 0) {
+        ok = value != NULL && (options->numSizes = parseIntList(value, options->sizes, MAX_SIZES)) > 0;
+    } else if (strcmp(option, "--degree") == 0) {
+        ok = value != NULL && (options->generator.avgDegree = atof(value)) > 0;
+    } else if (strcmp(option, "--max-weight") == 0) {
+        ok = value != NULL && (options->generator.maxWeight = atoi(value)) > 0;
+    } else if (strcmp(option, "--seed") == 0) {
+        ok = value != NULL;
+        if (ok) {
+            options->generator.seed = strtoull(value, NULL, 10);
+        }
+    } else if (strcmp(option, "--format") == 0) {
+        ok = value != NULL && parseGraphFileFormat(value, &options->format);
+    } else if (strcmp(option, "--out") == 0) {
+        ok = value != NULL;
+        options->outDir = value;
+    } else {
+        return 0;
+    }
+
+    if (!ok) {
+        fprintf(stderr, "Invalid value for %s\n", option);
+        return -1;
+    }
+    (*i)++;
+    return 1;
+}
+
+static void initSyntheticOptions(SyntheticOptions *options) {
+    options->generator.type = GRAPH_GNP;
+    options->generator.numNodes = 0;
+    options->generator.avgDegree = 8.0;
+    options->generator.maxWeight = 100;
+    options->generator.seed = 1;
+    options->format = FORMAT_BIN;
+    options->numSizes = 0;
+    options->outDir = NULL;
+}
+
+/**
+ * @brief Generates one instance per requested size. Files that already exist
+ * are reused, since the same parameters always produce the same file.
+ *
+ * @param options Generator options.
+ * @param selection Selection that receives the instances (may be NULL).
+ * @return 1 on success, 0 on error.
+ */
+static int generateSyntheticInstances(SyntheticOptions *options, InstanceSelection *selection) {
+    if (options->numSizes == 0) {
+        fprintf(stderr, "No node counts given (use --nodes).\n");
+        return 0;
+    }
+    if (mkdir(options->outDir, 0755) != 0 && errno != EEXIST) {
+        perror(options->outDir);
+        return 0;
+    }
+
+    for (int s = 0; s < options->numSizes; s++) {
+        char name[MAX_LINE_LENGTH];
+        char *path = malloc(strlen(options->outDir) + MAX_LINE_LENGTH + 2);
+        struct stat path_stat;
+
+        options->generator.numNodes = options->sizes[s];
+        syntheticFileName(&options->generator, options->format, name, sizeof(name));
+        sprintf(path, "%s/%s", options->outDir, name);
+
+        if (stat(path, &path_stat) == 0) {
+            printf("Reusing %s\n", path);
+        } else {
+            double start = wallTime();
+            long long count = generateGraphFile(&options->generator, options->format, path);
+            if (count < 0) {
+                free(path);
+                return 0;
+            }
+            printf("Generated %s (%lld %s) in %.3f seconds.\n", path, count,
+                   options->format == FORMAT_STP ? "edges" : "arcs", wallTime() - start);
+        }
+
+        if (selection != NULL) {
+            addInstance(selection, path);
+        } else {
+            free(path);
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Generates synthetic instances.
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int runGenerate(int argc, const char *argv[]) {
+    SyntheticOptions options;
+    initSyntheticOptions(&options);
+
+    for (int i = 0; i < argc; i++) {
+        int consumed = parseSyntheticOption(argc, argv, &i, &options);
+        if (consumed <= 0) {
+            if (consumed == 0) {
+                fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            }
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (options.outDir == NULL) {
+        options.outDir = DIR_PATH SYNTHETIC;
+    }
+
+    return generateSyntheticInstances(&options, NULL) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief One run of one algorithm on one instance, and its results.
+ */
+typedef struct {
+    BatchInstance *instance;
+    int algorithm;                  // Index in batchAlgorithms
+    int repetition;
+    int src;
+    int verify;                     // Check the distance vector (first repetition only)
+    double seconds;
+    ShortestPathResult result;      // Distance to the last node
+    int reachable;
+    unsigned long long checksum;    // distanceChecksum of the distance vector
+    MemoryStats memory;
+    OperationStats operations;      // All zero in builds without OPERATION_COUNTERS
+    const char *traceDir;           // Write the iteration trace of the run to this directory (or NULL)
+    char tracePath[MAX_LINE_LENGTH * 2];    // Set when the trace was written
+    CertificateReport report;
+    NegativeCycle cycle;            // Found when verify is set and the algorithm reported a negative cycle
+    int cycleValid;                 // checkNegativeCycle of the cycle
+    int *dist;                      // Kept only when verify is set, for the comparison
+    int skipped;                    // The algorithm cannot run on the instance (see skipReason), or failed
+    int failed;                     // The run could not complete; reported as skipped
+    int automatic;                  // Picked by the cost model (--algorithms auto)
+} BatchJob;
+
+/**
+ * @brief Tells why an algorithm cannot run on an instance.
+ *
+ * @return The reason, or NULL if the algorithm can run.
+ */
+static const char *skipReason(const BatchAlgorithm *algorithm, const BatchInstance *instance) {
+    if (algorithm->representation == REPR_UNDIRECTED && instance->undirected == NULL) {
+        return "the graph is not undirected";
+    }
+    if (algorithm->nonNegativeWeights && instance->minWeight < 0) {
+        return "the graph has negative weights";
+    }
+    if (algorithm->distances == runDial && instance->maxWeight > DIAL_MAX_WEIGHT) {
+        return "the weights are too large for Dial's buckets (run radix or di)";
+    }
+    return NULL;
+}
+
+/**
+ * @brief Picks the algorithm with the smallest predicted running time among
+ * the calibrated ones that run on the adjacency lists and give exact distances
+ * on the instance. The other representations are left out, since building
+ * them costs more than a single run saves. Without a calibrated candidate it
+ * falls back to Dijkstra (v2), or to Bellman-Ford (Tarjan) for negative weights.
+ *
+ * @param predicted Output parameter with the predicted time (0 on fallback).
+ * @return Index in batchAlgorithms.
+ */
+static int chooseAlgorithm(const CostModel *model, const BatchInstance *instance, double *predicted) {
+    int best = -1;
+    *predicted = 0;
+
+    for (int a = 0; a < NUM_BATCH_ALGORITHMS; a++) {
+        const BatchAlgorithm *algorithm = &batchAlgorithms[a];
+        const AlgorithmCost *cost = findAlgorithmCost(model, algorithm->name);
+        if (cost == NULL || algorithm->representation != REPR_LISTS || skipReason(algorithm, instance) != NULL ||
+            (instance->features.negativeWeights && !algorithm->negativeWeights))
+            continue;
+        double seconds = predictSeconds(cost, &instance->features);
+        if (best < 0 || seconds < *predicted) {
+            best = a;
+            *predicted = seconds;
+        }
+    }
+
+    if (best < 0) {
+        const char *fallback = instance->features.negativeWeights ? "bft" : "d2";
+        for (best = 0; strcmp(batchAlgorithms[best].name, fallback) != 0; best++) {
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Prints the features of an instance and the predicted running time of
+ * every calibrated algorithm, marking the one picked.
+ */
+static void reportAutomaticChoice(const BatchInstance *instance, const CostModel *model) {
+    const GraphFeatures *features = &instance->features;
+    printf("---> Features: density %.2e, degree %.1f average and %d max (skew %.1f), weights in [%d, %d]\n",
+           features->density, features->averageDegree, features->maxDegree, features->degreeSkew,
+           features->minWeight, features->maxWeight);
+    if (instance->autoPredicted == 0) {
+        printf("---> Auto: %s (no calibrated algorithm can run on this instance)\n",
+               batchAlgorithms[instance->autoAlgorithm].label);
+        return;
+    }
+
+    printf("---> Auto: %s, predicted %.6f seconds; other candidates:", batchAlgorithms[instance->autoAlgorithm].label,
+           instance->autoPredicted);
+    for (int a = 0; a < NUM_BATCH_ALGORITHMS; a++) {
+        const AlgorithmCost *cost = findAlgorithmCost(model, batchAlgorithms[a].name);
+        if (a != instance->autoAlgorithm && cost != NULL && batchAlgorithms[a].representation == REPR_LISTS &&
+            skipReason(&batchAlgorithms[a], instance) == NULL &&
+            (!features->negativeWeights || batchAlgorithms[a].negativeWeights))
+            printf(" %s %.6f", batchAlgorithms[a].name, predictSeconds(cost, features));
+    }
+    printf("\n");
+}
+
+/**
+ * @brief Writes the iteration trace of a job as DIR/INSTANCE.ALGORITHM.csv,
+ * where INSTANCE is the file name of the instance.
+ */
+static void saveJobTrace(BatchJob *job) {
+    const char *name = strrchr(job->instance->path, '/');
+    name = name != NULL ? name + 1 : job->instance->path;
+    char path[sizeof(job->tracePath)];
+    snprintf(path, sizeof(path), "%s/%s.%s.csv", job->traceDir, name, batchAlgorithms[job->algorithm].name);
+    if (saveOperationTrace(path)) {
+        snprintf(job->tracePath, sizeof(job->tracePath), "%s", path);
+    } else {
+        perror(path);
+    }
+}
+
+/**
+ * @brief Prints the operation counts of a job that are not zero, and compares
+ * them with the complexity functions of utils.c for the algorithms they
+ * describe.
+ */
+static void reportOperations(const BatchJob *job) {
+    const long long *counts = job->operations.counts;
+    int (*distances)(BatchInstance *, int, int *) = batchAlgorithms[job->algorithm].distances;
+    int n = job->instance->graph->numNodes, m = job->instance->graph->numEdges;
+    if (counts[OP_RELAXATIONS] == 0)
+        return;
+
+    printf("Operations:");
+    for (int c = 0; c < OP_NUM_COUNTERS; c++) {
+        if (counts[c] != 0)
+            printf(" %s %lld", operationCounterName(c), counts[c]);
+    }
+    printf("\n");
+
+    if (distances == runBellmanFord || distances == runBellmanFordSorted || distances == runBellmanFordCompressed ||
+        distances == runBellmanFordUndirected || distances == runShardedBellmanFord) {
+        double bound = calculateBellmanFordComplexity(n, m);
+        printf("Relaxations: %lld, %.1f%% of the n x m bound (%.0f)\n", counts[OP_RELAXATIONS],
+               bound > 0 ? 100 * counts[OP_RELAXATIONS] / bound : 0.0, bound);
+    } else if (distances == runDijkstraV1) {
+        double bound = calculateDijkstraV1Complexity(n);
+        double scans = (double)counts[OP_EXTRACT_MINS] * n;
+        printf("Minimum scans: %.0f entries, %.1f%% of the n^2 bound (%.0f)\n", scans,
+               bound > 0 ? 100 * scans / bound : 0.0, bound);
+    } else if (distances == runDijkstraV2 || distances == runDijkstraCompressed || distances == runDijkstraUndirected) {
+        double bound = calculateDijkstraV2Complexity(n, m);
+        long long work = counts[OP_RELAXATIONS] + counts[OP_SIFT_STEPS];
+        printf("Relaxations and sift steps: %lld, %.1f%% of the m log n bound (%.0f)\n", work,
+               bound > 0 ? 100 * work / bound : 0.0, bound);
+    }
+}
+
+/**
+ * @brief Runs one batch job. Memory counters are per thread, so the numbers of
+ * the job are not mixed with those of jobs running on other workers.
+ */
+static void runBatchJob(void *arg, int worker) {
+    (void)worker;
+    BatchJob *job = (BatchJob *) arg;
+    Graph *graph = job->instance->graph;
+    if (skipReason(&batchAlgorithms[job->algorithm], job->instance) != NULL) {
+        job->skipped = 1;
+        return;
+    }
+    resetMemoryStats();
+    resetOperationStats();
+
+    // On a reduced graph the algorithm fills runDist, and the distances of the
+    // removed nodes are restored within the measured time. Both vectors are
+    // allocated after the reset so that the buffers of the run include them.
+    GraphReduction *reduction = job->instance->reduction;
+    int *dist = (int *) trackedMalloc(MEM_BUFFERS, graph->numNodes * sizeof(int));
+    int *runDist = NULL;
+    if (reduction != NULL) {
+        graph = job->instance->original;
+        runDist = dist;
+        dist = (int *) trackedMalloc(MEM_BUFFERS, graph->numNodes * sizeof(int));
+    }
+
+    if (job->traceDir != NULL)
+        startOperationTrace();
+    double start = wallTime();
+    int negativeCycle;
+    if (reduction != NULL) {
+        negativeCycle = batchAlgorithms[job->algorithm].distances(job->instance, reduction->source, runDist);
+        if (negativeCycle >= 0)
+            expandDistances(reduction, runDist, dist);
+    } else {
+        negativeCycle = batchAlgorithms[job->algorithm].distances(job->instance, job->src, dist);
+    }
+    job->seconds = wallTime() - start;
+    job->memory = getMemoryStats();
+    job->operations = getOperationStats();
+    if (job->traceDir != NULL)
+        saveJobTrace(job);
+    if (runDist != NULL)
+        trackedFree(MEM_BUFFERS, runDist);
+    if (negativeCycle < 0) {
+        // The kernel printed why; the other jobs of the batch go on
+        job->skipped = 1;
+        job->failed = 1;
+        trackedFree(MEM_BUFFERS, dist);
+        return;
+    }
+
+    int target = graph->numNodes - 1;
+    job->result = (ShortestPathResult) { job->src, target, negativeCycle ? INT_MAX : dist[target], negativeCycle };
+    job->reachable = countReachable(dist, graph->numNodes);
+    job->checksum = distanceChecksum(dist, graph->numNodes);
+
+    if (job->verify && !negativeCycle) {
+        job->report = checkShortestPathCertificate(graph, job->src, dist);
+        job->dist = dist;
+    } else if (job->verify) {
+        // The certificate of a negative cycle answer is the cycle itself
+        job->cycleValid = bellmanFordTarjanDistances(graph, job->src, dist, &job->cycle) &&
+                          checkNegativeCycle(graph, &job->cycle);
+        trackedFree(MEM_BUFFERS, dist);
+    } else {
+        trackedFree(MEM_BUFFERS, dist);
+    }
+}
+
+/**
+ * @brief Prints the outcome of a distance vector check and compares the vector
+ * with the one of the first verified algorithm.
+ *
+ * @return 1 if all checks passed.
+ */
+static int reportVerification(const BatchJob *job, const BatchJob *reference) {
+    const CertificateReport *report = &job->report;
+    int numNodes = job->instance->original->numNodes;
+    int ok = report->valid;
+
+    if (report->valid) {
+        printf("---> Certificate: OK\n");
+    } else {
+        printf("---> Certificate: FAILED (source %s, %d triangle violations, %d unsupported vertices, first at node %d)\n",
+               report->sourceError ? "wrong" : "ok", report->triangleViolations,
+               report->unsupportedVertices, report->firstBadVertex);
+    }
+
+    if (reference != NULL) {
+        int firstMismatch;
+        int mismatches = compareDistances(reference->dist, job->dist, numNodes, &firstMismatch);
+        if (mismatches > 0) {
+            printf("---> Mismatch with %s: %d nodes differ, first at node %d (%d vs %d)\n",
+                   batchAlgorithms[reference->algorithm].label, mismatches, firstMismatch,
+                   reference->dist[firstMismatch], job->dist[firstMismatch]);
+            ok = 0;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Prints the negative cycle found for a job that reported one, and
+ * whether it checked out.
+ */
+static void reportNegativeCycle(const BatchJob *job) {
+    const NegativeCycle *cycle = &job->cycle;
+    if (cycle->length == 0) {
+        printf("---> Certificate: FAILED (no negative cycle found from node %d)\n", job->src);
+        return;
+    }
+
+    printf("---> Negative cycle: %d vertices, weight %lld:", cycle->length, cycle->weight);
+    for (int i = 0; i < cycle->length && i < 10; i++) {
+        printf(" %d ->", cycle->vertices[i]);
+    }
+    printf(cycle->length > 10 ? " ... -> %d\n" : " %d\n", cycle->vertices[0]);
+    printf("---> Certificate: %s\n", job->cycleValid ? "OK" : "FAILED (not a negative cycle of the graph)");
+}
+
+/**
+ * @brief Prints the results of the jobs of one instance, in the order of the
+ * job array, and writes their CSV rows and JSON-lines records.
+ *
+ * @return Number of failed verifications.
+ */
+static int reportInstance(BatchInstance *instance, BatchJob *jobs, int numJobs, int src, FILE *csv,
+                          FILE *jsonl, int numWorkers, const CostModel *model) {
+    Graph *graph = instance->original;
+    const BatchJob *reference = NULL;
+    int failures = 0;
+
+    printf("\n==> %s\n", instance->path);
+    printf("---> Nodes: %d, arcs: %d, loaded in %.6f seconds.\n", graph->numNodes, graph->numEdges, instance->loadTime);
+    printf("---> Graph memory: %lld bytes in %lld allocations (%.1f bytes per arc)\n",
+           instance->graphMemory.currentBytes, instance->graphMemory.allocations,
+           graph->numEdges > 0 ? (double)instance->graphMemory.currentBytes / graph->numEdges : 0.0);
+    if (instance->reduction != NULL) {
+        const GraphReduction *reduction = instance->reduction;
+        printf("---> Reduction: %d -> %d nodes, %d -> %d arcs (%d unreachable, %d of degree 1 and %d of degree 2 "
+               "removed) in %.6f seconds.\n", reduction->originalNodes, reduction->graph->numNodes,
+               reduction->originalArcs, reduction->graph->numEdges, reduction->numUnreachable, reduction->numLeaves,
+               reduction->numChains, instance->reduceTime);
+    }
+    if (instance->compressed != NULL) {
+        long long bytes = compressedGraphBytes(instance->compressed);
+        printf("---> Compressed adjacency: %lld bytes (%.1f bytes per arc, %d-byte weights), built in %.6f seconds.\n",
+               bytes, graph->numEdges > 0 ? (double)bytes / graph->numEdges : 0.0,
+               instance->compressed->weightBytes, instance->compressTime);
+    }
+    for (int j = 0; j < numJobs; j++) {
+        if (batchAlgorithms[jobs[j].algorithm].distances == runIntegerDijkstra) {
+            printf("---> Weights in [%d, %d]: the integer Dijkstra uses %s.\n", instance->minWeight,
+                   instance->maxWeight, instance->maxWeight <= DIAL_MAX_WEIGHT ? "Dial's buckets" : "the radix heap");
+            break;
+        }
+    }
+    if (instance->dense != NULL) {
+        printf("---> Density %.2f: Bellman-Ford and Dijkstra (v1) run on a %lld-byte weight matrix, built in %.6f seconds.\n",
+               instance->features.density, denseGraphBytes(instance->dense), instance->denseTime);
+    }
+    if (instance->undirected != NULL) {
+        UndirectedGraph *undirected = instance->undirected;
+        printf("---> Undirected storage: %d edges, %lld bytes of edges and %lld bytes of incidence lists, built in %.6f seconds.\n",
+               undirected->numEdges, undirectedEdgeBytes(undirected), undirectedIncidenceBytes(undirected),
+               instance->undirectedTime);
+    }
+    if (instance->sharded != NULL) {
+        const ShardedGraph *sharded = instance->sharded;
+        printf("---> Shards: %d processes, %lld of %d arcs between shards (%.1f%%), %lld bytes, built in %.6f seconds.\n",
+               sharded->numShards, sharded->cutArcs, sharded->numEdges,
+               sharded->numEdges > 0 ? 100.0 * sharded->cutArcs / sharded->numEdges : 0.0,
+               shardedGraphBytes(sharded), instance->shardTime);
+    }
+
+    if (instance->autoAlgorithm >= 0) {
+        reportAutomaticChoice(instance, model);
+    }
+
+    if (numJobs == 0) {
+        fprintf(stderr, "Source node %d is out of range, skipping.\n", src);
+        return 0;
+    }
+
+    for (int j = 0; j < numJobs; j++) {
+        BatchJob *job = &jobs[j];
+        const BatchAlgorithm *algorithm = &batchAlgorithms[job->algorithm];
+        const MemoryCounters *heap = &job->memory.categories[MEM_HEAP];
+        const MemoryCounters *buffers = &job->memory.categories[MEM_BUFFERS];
+
+        RunRecord record = { .instance = instance->path, .numNodes = graph->numNodes, .numArcs = graph->numEdges,
+                             .minWeight = instance->minWeight, .maxWeight = instance->maxWeight,
+                             .loadSeconds = instance->loadTime, .graphBytes = instance->graphMemory.currentBytes,
+                             .algorithm = algorithm->name, .repetition = job->repetition + 1,
+                             .numThreads = instance->numThreads, .numWorkers = numWorkers,
+                             .result = { src, graph->numNodes - 1, INT_MAX, 0 } };
+
+        printf("\nRunning %s algorithm from source node %d%s...\n", algorithm->label, src,
+               job->automatic ? " (picked by the cost model)" : "");
+        if (job->skipped) {
+            printf("Skipped: %s.\n", job->failed ? "the run failed" : skipReason(algorithm, instance));
+            if (jsonl != NULL) {
+                record.skipped = true;
+                writeRunRecord(jsonl, &record);
+            }
+            continue;
+        }
+        printShortestPathResult(&job->result);
+        printf("%s algorithm executed in %.6f seconds.\n", algorithm->label, job->seconds);
+        if (job->automatic && instance->autoPredicted > 0) {
+            printf("Predicted %.6f seconds (%.2fx the measured time).\n", instance->autoPredicted,
+                   job->seconds > 0 ? instance->autoPredicted / job->seconds : 0.0);
+        }
+        printf("Memory: heap %lld bytes (%lld allocations), buffers %lld bytes (%lld allocations), "
+               "peak %lld bytes, max RSS %lld bytes\n", heap->bytesAllocated, heap->allocations,
+               buffers->bytesAllocated, buffers->allocations, job->memory.totalPeakBytes,
+               job->memory.maxResidentBytes);
+        reportOperations(job);
+        if (job->tracePath[0] != '\0')
+            printf("Trace: %lld iterations written to %s\n", job->operations.traceLength, job->tracePath);
+
+        const char *certificate = "-";
+        if (job->dist != NULL) {
+            int ok = reportVerification(job, reference);
+            certificate = ok ? "ok" : "failed";
+            failures += !ok;
+            if (reference == NULL) {
+                reference = job;
+            }
+        } else if (job->verify && job->result.negativeCycle) {
+            reportNegativeCycle(job);
+            certificate = job->cycleValid ? "ok" : "failed";
+            failures += !job->cycleValid;
+        }
+
+        if (csv != NULL) {
+            fprintf(csv, "%s,%d,%d,%s,%d,%.9f,%d,%s,%lld,%lld,%lld,%lld,%lld,%lld,%lld\n", instance->path,
+                    graph->numNodes, graph->numEdges, algorithm->name, job->repetition + 1, job->seconds,
+                    job->result.negativeCycle ? INT_MIN : job->result.distance, certificate,
+                    instance->graphMemory.currentBytes, heap->bytesAllocated, heap->allocations,
+                    buffers->bytesAllocated, buffers->allocations, job->memory.totalPeakBytes,
+                    job->memory.maxResidentBytes);
+            fflush(csv);
+        }
+
+        if (jsonl != NULL) {
+            record.seconds = job->seconds;
+            record.memory = job->memory;
+            record.operations = OPERATION_COUNTERS_ENABLED ? &job->operations : NULL;
+            record.result = job->result;
+            record.reachable = job->reachable;
+            record.checksum = job->checksum;
+            record.certificate = strcmp(certificate, "-") != 0 ? certificate : NULL;
+            writeRunRecord(jsonl, &record);
+            fflush(jsonl);
+        }
+    }
+
+    for (int j = 0; j < numJobs; j++) {
+        trackedFree(MEM_BUFFERS, jobs[j].dist);
+        freeNegativeCycle(&jobs[j].cycle);
+    }
+    return failures;
+}
+
+/**
+ * @brief What is built for every instance of a batch run.
+ */
+typedef struct {
+    char **paths;
+    int numThreads;
+    int needsCompressed;
+    int needsUndirected;
+    int needsDense;                 // A selected algorithm runs on the matrix of dense graphs
+    int needsSharded;
+    int numShards;                  // Resolved --shards
+    double denseThreshold;
+    int autoSelect;
+    const CostModel *model;
+    int src;
+    int reduce;                     // Reduce the graph for the shortest paths from src (--reduce)
+} BatchLoadOptions;
+
+/**
+ * @brief Loads one instance with the representations the selected algorithms
+ * need, its features and, for auto runs, the algorithm picked for it. With
+ * --reduce all of them are built from the reduced graph. Runs on
+ * the pipeline's loader threads; memory counters are per thread, so the graph
+ * memory is measured as the difference before and after loading.
+ *
+ * @return 1 on success, 0 if the instance cannot be loaded.
+ */
+static int loadBatchInstance(void *item, int index, void *context) {
+    BatchInstance *instance = (BatchInstance *) item;
+    const BatchLoadOptions *options = (const BatchLoadOptions *) context;
+    instance->path = options->paths[index];
+    instance->numThreads = options->numThreads;
+
+    // Graphs loaded before it on this thread may still be allocated
+    resetMemoryStats();
+    long long graphBytesBefore = getMemoryStats().categories[MEM_GRAPH].currentBytes;
+    double loadStart = wallTime();
+    instance->graph = loadGraph(instance->path);
+    if (instance->graph == NULL) {
+        fprintf(stderr, ERROR_MSG_PROCESS_FILE);
+        return 0;
+    }
+    instance->loadTime = wallTime() - loadStart;
+    instance->graphMemory = getMemoryStats().categories[MEM_GRAPH];
+    instance->graphMemory.currentBytes -= graphBytesBefore;
+
+    instance->original = instance->graph;
+    instance->reduction = NULL;
+    if (options->reduce && options->src >= 0 && options->src < instance->graph->numNodes) {
+        double reduceStart = wallTime();
+        instance->reduction = reduceGraph(instance->original, options->src);
+        instance->reduceTime = wallTime() - reduceStart;
+        instance->graph = instance->reduction->graph;
+    }
+
+    instance->compressed = NULL;
+    if (options->needsCompressed) {
+        double compressStart = wallTime();
+        instance->compressed = compressGraph(instance->graph);
+        instance->compressTime = wallTime() - compressStart;
+        if (instance->compressed == NULL) {
+            if (instance->reduction != NULL) {
+                freeGraphReduction(instance->reduction);
+            }
+            freeGraph(instance->original);
+            return 0;
+        }
+    }
+
+    computeGraphFeatures(instance->graph, &instance->features);
+    instance->minWeight = instance->features.minWeight;
+    instance->maxWeight = instance->features.maxWeight;
+    instance->autoAlgorithm = options->autoSelect ?
+        chooseAlgorithm(options->model, instance, &instance->autoPredicted) : -1;
+
+    instance->undirected = NULL;
+    if (options->needsUndirected) {
+        double undirectedStart = wallTime();
+        instance->undirected = createUndirectedGraph(instance->graph);
+        instance->undirectedTime = wallTime() - undirectedStart;
+    }
+
+    instance->dense = NULL;
+    if (options->needsDense && instance->features.density >= options->denseThreshold) {
+        double denseStart = wallTime();
+        instance->dense = createDenseGraph(instance->graph);
+        instance->denseTime = wallTime() - denseStart;
+    }
+
+    instance->sharded = NULL;
+    if (options->needsSharded) {
+        double shardStart = wallTime();
+        instance->sharded = createShardedGraph(instance->graph, options->numShards);
+        instance->shardTime = wallTime() - shardStart;
+    }
+    return 1;
+}
+
+static void releaseBatchInstance(void *item, void *context) {
+    BatchInstance *instance = (BatchInstance *) item;
+    (void)context;
+    freeGraph(instance->original);
+    if (instance->reduction != NULL) {
+        freeGraphReduction(instance->reduction);
+    }
+    if (instance->compressed != NULL) {
+        freeCompressedGraph(instance->compressed);
+    }
+    if (instance->undirected != NULL) {
+        freeUndirectedGraph(instance->undirected);
+    }
+    if (instance->dense != NULL) {
+        freeDenseGraph(instance->dense);
+    }
+    if (instance->sharded != NULL) {
+        freeShardedGraph(instance->sharded);
+    }
+}
+
+/**
+ * @brief Fits the cost model to the running times of a batch run, prints it
+ * and saves it.
+ *
+ * @return 1 on success, 0 if no algorithm could be fitted or the file cannot
+ * be written.
+ */
+static int calibrateCostModel(CostModel *model, const char *path) {
+    if (fitCostModel(model) == 0) {
+        fprintf(stderr, "Calibration failed: every algorithm needs at least %d runs.\n", COST_MODEL_TERMS);
+        return 0;
+    }
+
+    printf("\nCost model (seconds = exp(c + a ln n + b ln m + s ln skew + w ln weight range)):\n");
+    printf("%-8s %8s %10s %10s %8s %8s %8s %8s\n", "Name", "Samples", "c", "a", "b", "s", "w", "Error");
+    for (int c = 0; c < model->numCosts; c++) {
+        const AlgorithmCost *cost = &model->costs[c];
+        printf("%-8s %8d %10.3f %10.3f %8.3f %8.3f %8.3f %7.0f%%\n", cost->algorithm, cost->numSamples,
+               cost->coefficients[0], cost->coefficients[1], cost->coefficients[2], cost->coefficients[3],
+               cost->coefficients[4], (exp(cost->rmsError) - 1) * 100);
+    }
+    if (!saveCostModel(model, path)) {
+        return 0;
+    }
+    printf("Cost model saved to %s\n", path);
+    return 1;
+}
+
+/**
+ * @brief Runs the selected algorithms on a list of instances and reports the
+ * execution times. With --verify, every distance vector is also checked.
+ *
+ * With --pipeline, the instances are loaded by background threads while the
+ * jobs run, up to N instances ahead, and freed by a teardown thread, so that
+ * the wall time of a sweep approaches the time of the runs alone.
+ *
+ * With --calibrate, the running times are also fitted to a cost model of each
+ * algorithm over the features of the instances, which --algorithms auto then
+ * uses to pick one algorithm per instance.
+ *
+ * Every (instance, algorithm, repetition) run is an independent job. With
+ * --jobs, the jobs run concurrently on the scheduler's workers: instances are
+ * loaded in windows of one instance per worker, all jobs of a window run
+ * together, and the results are printed in the same order as a serial run.
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE on invalid options or failed verification.
+ */
+int runBatch(int argc, const char *argv[]) {
+    int selected[NUM_BATCH_ALGORITHMS];
+    int repetitions = 1;
+    int src = 0;
+    int verify = 0;
+    int reduce = 0;
+    int failures = 0;
+    const char *csvPath = NULL;
+    const char *jsonlPath = NULL;
+    const char *saveBaselinePath = NULL;
+    const char *baselinePath = NULL;
+    const char *calibratePath = NULL;
+    const char *modelPath = NULL;
+    const char *traceDir = NULL;
+    int autoSelect = 0;
+    RegressionOptions regression = { 0.05, 0.05, 0.001 };
+    int synthetic = 0;
+    SyntheticOptions syntheticOptions;
+    InstanceSelection instances;
+    SchedulerOptions scheduler = { 1, false };
+    int numThreads = 0;
+    int numShards = 0;
+    int pipelineDepth = 0;
+    double denseThreshold = DENSE_GRAPH_MIN_DENSITY;
+
+    initSyntheticOptions(&syntheticOptions);
+    initInstanceSelection(&instances);
+    for (int a = 0; a < NUM_BATCH_ALGORITHMS; a++) {
+        selected[a] = batchAlgorithms[a].selectedByDefault;
+    }
+
+    for (int i = 0; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (parseInstanceOption(argc, argv, &i, &instances)) {
+            continue;
+        } else if (strcmp(argv[i], "--algorithms") == 0 && value != NULL) {
+            for (int a = 0; a < NUM_BATCH_ALGORITHMS; a++) {
+                selected[a] = 0;
+            }
+            char list[MAX_LINE_LENGTH];
+            snprintf(list, sizeof(list), "%s", value);
+            for (char *name = strtok(list, ","); name != NULL; name = strtok(NULL, ",")) {
+                if (strcmp(name, "auto") == 0) {
+                    autoSelect = 1;
+                    continue;
+                }
+                int a = 0;
+                while (a < NUM_BATCH_ALGORITHMS && strcmp(name, batchAlgorithms[a].name) != 0) {
+                    a++;
+                }
+                if (a == NUM_BATCH_ALGORITHMS) {
+                    fprintf(stderr, "Unknown algorithm: %s\n", name);
+                    return EXIT_FAILURE;
+                }
+                selected[a] = 1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--repeat") == 0 && value != NULL) {
+            repetitions = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--source") == 0 && value != NULL) {
+            src = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--csv") == 0 && value != NULL) {
+            csvPath = value;
+            i++;
+        } else if (strcmp(argv[i], "--jsonl") == 0 && value != NULL) {
+            jsonlPath = value;
+            i++;
+        } else if (strcmp(argv[i], "--save-baseline") == 0 && value != NULL) {
+            saveBaselinePath = value;
+            i++;
+        } else if (strcmp(argv[i], "--baseline") == 0 && value != NULL) {
+            baselinePath = value;
+            i++;
+        } else if (strcmp(argv[i], "--calibrate") == 0 && value != NULL) {
+            calibratePath = value;
+            i++;
+        } else if (strcmp(argv[i], "--model") == 0 && value != NULL) {
+            modelPath = value;
+            i++;
+        } else if (strcmp(argv[i], "--alpha") == 0 && value != NULL) {
+            regression.alpha = atof(value);
+            i++;
+        } else if (strcmp(argv[i], "--threshold") == 0 && value != NULL) {
+            regression.threshold = atof(value) / 100;
+            i++;
+        } else if (strcmp(argv[i], "--min-delta") == 0 && value != NULL) {
+            regression.minDelta = atof(value);
+            i++;
+        } else if (strcmp(argv[i], "--verify") == 0) {
+            verify = 1;
+        } else if (strcmp(argv[i], "--reduce") == 0) {
+            reduce = 1;
+        } else if (strcmp(argv[i], "--jobs") == 0 && value != NULL) {
+            scheduler.numWorkers = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--pin") == 0) {
+            scheduler.pinThreads = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && value != NULL) {
+            numThreads = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--shards") == 0 && value != NULL) {
+            numShards = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--dense-threshold") == 0 && value != NULL) {
+            denseThreshold = atof(value);
+            i++;
+        } else if (strcmp(argv[i], "--pipeline") == 0 && value != NULL) {
+            pipelineDepth = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--trace") == 0 && value != NULL) {
+            traceDir = value;
+            i++;
+        } else {
+            if (strcmp(argv[i], "--synthetic") == 0) {
+                synthetic = 1;
+            }
+            int consumed = parseSyntheticOption(argc, argv, &i, &syntheticOptions);
+            if (consumed <= 0) {
+                if (consumed == 0) {
+                    fprintf(stderr, "Unknown option: %s\n", argv[i]);
+                }
+                printUsage();
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (repetitions < 1) {
+        repetitions = 1;
+    }
+    if (traceDir != NULL && !OPERATION_COUNTERS_ENABLED) {
+        fprintf(stderr, "--trace needs a build with -DOPERATION_COUNTERS.\n");
+        return EXIT_FAILURE;
+    }
+    if (traceDir != NULL && mkdir(traceDir, 0755) != 0 && errno != EEXIST) {
+        perror(traceDir);
+        return EXIT_FAILURE;
+    }
+
+    if (!resolveInstances(&instances, !synthetic)) {
+        return EXIT_FAILURE;
+    }
+
+    char syntheticDir[MAX_LINE_LENGTH * 2];
+    if (synthetic) {
+        if (syntheticOptions.outDir == NULL) {
+            snprintf(syntheticDir, sizeof(syntheticDir), "%s%s", instances.dataDir, SYNTHETIC);
+            syntheticOptions.outDir = syntheticDir;
+        }
+        if (!generateSyntheticInstances(&syntheticOptions, &instances)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (instances.numPaths == 0) {
+        fprintf(stderr, "No instances to run.\n");
+        return EXIT_FAILURE;
+    }
+
+    TimingSet baseline, timings;
+    initTimingSet(&baseline);
+    initTimingSet(&timings);
+    if (baselinePath != NULL && !loadTimingSet(&baseline, baselinePath)) {
+        return EXIT_FAILURE;
+    }
+
+    // The model picks the algorithms of auto runs; a calibration refits it
+    // with the new running times and keeps the algorithms it did not run
+    char defaultModelPath[MAX_LINE_LENGTH * 2];
+    if (modelPath == NULL) {
+        snprintf(defaultModelPath, sizeof(defaultModelPath), "%s%s", instances.dataDir, COST_MODEL_FILE);
+        modelPath = defaultModelPath;
+    }
+    CostModel model;
+    initCostModel(&model);
+    struct stat modelStat;
+    if (autoSelect && !loadCostModel(&model, modelPath)) {
+        fprintf(stderr, "No cost model: calibrate one first with batch --calibrate %s\n", modelPath);
+        return EXIT_FAILURE;
+    }
+    if (calibratePath != NULL && !autoSelect && stat(calibratePath, &modelStat) == 0 &&
+        !loadCostModel(&model, calibratePath)) {
+        return EXIT_FAILURE;
+    }
+
+    FILE *csv = NULL;
+    if (csvPath != NULL) {
+        csv = fopen(csvPath, "w");
+        if (csv == NULL) {
+            perror(ERROR_MSG_OUTPUT_FILE);
+            return EXIT_FAILURE;
+        }
+        fprintf(csv, "instance,nodes,arcs,algorithm,repetition,seconds,target_distance,certificate,"
+                     "graph_bytes,heap_bytes,heap_allocations,buffer_bytes,buffer_allocations,"
+                     "peak_bytes,max_rss_bytes\n");
+    }
+
+    FILE *jsonl = NULL;
+    if (jsonlPath != NULL) {
+        if (strcmp(jsonlPath, "-") == 0) {
+            // The records get the real stdout; everything else printed from here
+            // on (the report, progress of the loaders) is moved to stderr
+            fflush(stdout);
+            int fd = dup(STDOUT_FILENO);
+            jsonl = fd >= 0 ? fdopen(fd, "w") : NULL;
+            if (jsonl != NULL) {
+                dup2(STDERR_FILENO, STDOUT_FILENO);
+            }
+        } else {
+            jsonl = fopen(jsonlPath, "a");
+        }
+        if (jsonl == NULL) {
+            perror(ERROR_MSG_OUTPUT_FILE);
+            if (csv != NULL) {
+                fclose(csv);
+            }
+            return EXIT_FAILURE;
+        }
+    }
+
+    int numSelected = 0;
+    int needsCompressed = 0;
+    int needsUndirected = 0;
+    int needsSharded = 0;
+    int needsDense = autoSelect;
+    for (int a = 0; a < NUM_BATCH_ALGORITHMS; a++) {
+        needsDense |= selected[a] && (batchAlgorithms[a].distances == runBellmanFord ||
+                                      batchAlgorithms[a].distances == runDijkstraV1);
+        numSelected += selected[a];
+        needsCompressed |= selected[a] && batchAlgorithms[a].representation == REPR_COMPRESSED;
+        needsUndirected |= selected[a] && batchAlgorithms[a].representation == REPR_UNDIRECTED;
+        needsSharded |= selected[a] && batchAlgorithms[a].representation == REPR_SHARDED;
+    }
+    int jobsPerInstance = (numSelected + autoSelect) * repetitions;
+    int window = resolveWorkerCount(&scheduler);
+    BatchInstance **loaded = (BatchInstance **) malloc(window * sizeof(BatchInstance *));
+    BatchJob *jobs = (BatchJob *) calloc((size_t)window * jobsPerInstance, sizeof(BatchJob));
+    int *instanceJobs = (int *) malloc(window * sizeof(int));
+
+    // The pipeline must run at least a window ahead, or the loaders would
+    // wait for a window that waits for them
+    if (pipelineDepth > 0 && pipelineDepth < window) {
+        pipelineDepth = window;
+    }
+    int numLoaders = pipelineDepth < availableProcessors() ? pipelineDepth : availableProcessors();
+    BatchLoadOptions loadOptions = { instances.paths, numThreads, needsCompressed, needsUndirected, needsDense,
+                                     needsSharded, numShards > 0 ? numShards : availableProcessors(),
+                                     denseThreshold, autoSelect, &model, src, reduce };
+    InstancePipeline *pipeline = startPipeline(loadBatchInstance, releaseBatchInstance, &loadOptions,
+                                               sizeof(BatchInstance), instances.numPaths, pipelineDepth, numLoaders);
+    double sweepStart = wallTime();
+    double computeSeconds = 0;
+
+    for (int first = 0; first < instances.numPaths; first += window) {
+        int numLoaded = 0, numJobs = 0;
+
+        for (int p = first; p < instances.numPaths && p < first + window; p++) {
+            int ok;
+            BatchInstance *instance = (BatchInstance *) nextLoadedItem(pipeline, &ok);
+            if (!ok) {
+                continue;
+            }
+            loaded[numLoaded] = instance;
+
+            instanceJobs[numLoaded] = 0;
+            if (src >= 0 && src < instance->original->numNodes) {
+                for (int a = 0; a < NUM_BATCH_ALGORITHMS; a++) {
+                    for (int r = 0; selected[a] && r < repetitions; r++) {
+                        jobs[numJobs++] = (BatchJob) { .instance = instance, .algorithm = a, .repetition = r,
+                                                       .src = src, .verify = verify && r == 0,
+                                                       .traceDir = r == 0 ? traceDir : NULL };
+                    }
+                }
+                for (int r = 0; autoSelect && r < repetitions; r++) {
+                    jobs[numJobs++] = (BatchJob) { .instance = instance, .algorithm = instance->autoAlgorithm,
+                                                   .repetition = r, .src = src, .verify = verify && r == 0,
+                                                   .traceDir = r == 0 ? traceDir : NULL, .automatic = 1 };
+                }
+                instanceJobs[numLoaded] = jobsPerInstance;
+            }
+            numLoaded++;
+        }
+
+        double computeStart = wallTime();
+        runJobs(runBatchJob, jobs, sizeof(BatchJob), numJobs, &scheduler);
+        computeSeconds += wallTime() - computeStart;
+
+        for (int j = 0; j < numJobs; j++) {
+            if (!jobs[j].skipped) {
+                addTiming(&timings, jobs[j].instance->path, batchAlgorithms[jobs[j].algorithm].name, jobs[j].seconds);
+            }
+            if (!jobs[j].skipped && calibratePath != NULL) {
+                addCostSample(&model, batchAlgorithms[jobs[j].algorithm].name, &jobs[j].instance->features,
+                              jobs[j].seconds);
+            }
+        }
+        for (int l = 0, j = 0; l < numLoaded; j += instanceJobs[l], l++) {
+            failures += reportInstance(loaded[l], &jobs[j], instanceJobs[l], src, csv, jsonl, window, &model);
+            releaseItem(pipeline, loaded[l]);
+        }
+    }
+
+    PipelineStats pipelineStats;
+    finishPipeline(pipeline, &pipelineStats);
+    printf("\nSweep: %.6f seconds, of which runs %.6f, waiting for instances to load %.6f and freeing them %.6f",
+           wallTime() - sweepStart, computeSeconds, pipelineStats.waitSeconds,
+           pipelineDepth > 0 ? 0.0 : pipelineStats.releaseSeconds);
+    if (pipelineDepth > 0) {
+        printf("\n       (pipeline of %d instances: loading took %.6f seconds on %d thread%s, "
+               "freeing %.6f seconds in the background)", pipelineDepth, pipelineStats.loadSeconds, numLoaders,
+               numLoaders == 1 ? "" : "s", pipelineStats.releaseSeconds);
+    }
+    printf("\n");
+
+    free(loaded);
+    free(jobs);
+    free(instanceJobs);
+    if (csv != NULL) {
+        fclose(csv);
+    }
+    if (jsonl != NULL) {
+        fclose(jsonl);
+    }
+    freeInstanceSelection(&instances);
+
+    if (verify) {
+        printf("\nVerification: %s (%d failed checks)\n", failures == 0 ? "PASSED" : "FAILED", failures);
+    }
+    if (saveBaselinePath != NULL) {
+        if (saveTimingSet(&timings, saveBaselinePath)) {
+            printf("\nRunning times saved to %s\n", saveBaselinePath);
+        } else {
+            failures++;
+        }
+    }
+    if (baselinePath != NULL) {
+        failures += compareWithBaseline(&baseline, &timings, &regression);
+    }
+    if (calibratePath != NULL) {
+        failures += !calibrateCostModel(&model, calibratePath);
+    }
+    freeTimingSet(&baseline);
+    freeTimingSet(&timings);
+    freeCostModel(&model);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Dispatches a non-interactive command.
+ *
+ * @param argc Number of arguments, starting at the command name.
+ * @param argv Arguments, starting at the command name.
+ * @return Exit status of the command.
+ */
+int runCommand(int argc, const char *argv[]) {
+    if (strcmp(argv[0], "batch") == 0) {
+        return runBatch(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[0], "verify") == 0) {
+        const char *batchArgv[MAX_INSTANCES];
+        int batchArgc = 0;
+        batchArgv[batchArgc++] = "--verify";
+        for (int i = 1; i < argc && batchArgc < MAX_INSTANCES; i++) {
+            batchArgv[batchArgc++] = argv[i];
+        }
+        return runBatch(batchArgc, batchArgv);
+    }
+    if (strcmp(argv[0], "generate") == 0) {
+        return runGenerate(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[0], "terminals") == 0) {
+        return runTerminals(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[0], "steiner") == 0) {
+        return runSteiner(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[0], "oracle") == 0) {
+        return runOracle(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[0], "serve") == 0) {
+        return runServe(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[0], "query") == 0) {
+        return runQuery(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[0], "multiquery") == 0) {
+        return runMultiquery(argc - 1, argv + 1);
+    }
+    if (strcmp(argv[0], "dynamic") == 0) {
+        return runDynamic(argc - 1, argv + 1);
+    }
+
+    if (strcmp(argv[0], "help") != 0 && strcmp(argv[0], "--help") != 0) {
+        fprintf(stderr, "Unknown command: %s\n", argv[0]);
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    printUsage();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,29 @@
+//
+//  runner.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef runner_h
+#define runner_h
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "graph.h"
+#include "hub_labels.h"
+
+int runCommand(int argc, const char *argv[]);
+int runBatch(int argc, const char *argv[]);
+int runGenerate(int argc, const char *argv[]);
+int runTerminals(int argc, const char *argv[]);
+int runSteiner(int argc, const char *argv[]);
+int runOracle(int argc, const char *argv[]);
+int runServe(int argc, const char *argv[]);
+int runQuery(int argc, const char *argv[]);
+int runMultiquery(int argc, const char *argv[]);
+int runDynamic(int argc, const char *argv[]);
+
+HubLabels* obtainHubLabels(Graph *graph, const char *path, bool rebuild, double *buildTime);
+
+#endif /* runner_h */
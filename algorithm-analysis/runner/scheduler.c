@@ -0,0 +1,224 @@
+//
+//  scheduler.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "scheduler.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * @brief Jobs still to be run by one worker. Job numbers are handed out in
+ * contiguous blocks, so a queue is just a range of job numbers.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    int head;               // Next job the owner runs
+    int tail;               // One past the last job; thieves take from this end
+} WorkQueue;
+
+typedef struct {
+    JobFunction run;
+    char *jobs;
+    size_t jobSize;
+    int numWorkers;
+    WorkQueue *queues;
+    bool pinThreads;
+    int *cpus;              // Processors the process may run on
+    int numCpus;
+} Scheduler;
+
+typedef struct {
+    Scheduler *scheduler;
+    int id;
+} WorkerContext;
+
+/**
+ * @brief Lists the processors the process is allowed to run on.
+ *
+ * @param cpus Array that receives the processor numbers, or NULL to only count them.
+ * @return Number of processors.
+ */
+static int listProcessors(int *cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        int count = 0;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                if (cpus != NULL)
+                    cpus[count] = cpu;
+                count++;
+            }
+        }
+        if (count > 0)
+            return count;
+    }
+#endif
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1)
+        count = 1;
+    for (int i = 0; cpus != NULL && i < count; i++) {
+        cpus[i] = i;
+    }
+    return (int)count;
+}
+
+/**
+ * @brief Returns the number of processors available to the process.
+ */
+int availableProcessors(void) {
+    return listProcessors(NULL);
+}
+
+/**
+ * @brief Returns the number of workers the options ask for.
+ *
+ * @param options Scheduler options.
+ * @return The number of workers (at least 1).
+ */
+int resolveWorkerCount(const SchedulerOptions *options) {
+    return options->numWorkers < 1 ? availableProcessors() : options->numWorkers;
+}
+
+/**
+ * @brief Pins the calling thread to one processor. Pinning is only available
+ * on Linux; elsewhere the thread is left to the operating system.
+ */
+static void pinThread(Scheduler *scheduler, int id) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(scheduler->cpus[id % scheduler->numCpus], &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)scheduler;
+    (void)id;
+#endif
+}
+
+/**
+ * @brief Takes the next job of a worker. When its own queue is empty, the
+ * worker steals the second half of the first non-empty queue it finds.
+ *
+ * @return 1 if a job was taken, 0 if no jobs are left.
+ */
+static int takeJob(Scheduler *scheduler, int id, int *job) {
+    WorkQueue *own = &scheduler->queues[id];
+
+    pthread_mutex_lock(&own->lock);
+    if (own->head < own->tail) {
+        *job = own->head++;
+        pthread_mutex_unlock(&own->lock);
+        return 1;
+    }
+    pthread_mutex_unlock(&own->lock);
+
+    for (int k = 1; k < scheduler->numWorkers; k++) {
+        WorkQueue *victim = &scheduler->queues[(id + k) % scheduler->numWorkers];
+
+        pthread_mutex_lock(&victim->lock);
+        int remaining = victim->tail - victim->head;
+        if (remaining <= 0) {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+        int stolen = (remaining + 1) / 2;
+        int first = victim->tail - stolen;
+        victim->tail = first;
+        pthread_mutex_unlock(&victim->lock);
+
+        pthread_mutex_lock(&own->lock);
+        own->head = first + 1;
+        own->tail = first + stolen;
+        pthread_mutex_unlock(&own->lock);
+
+        *job = first;
+        return 1;
+    }
+    return 0;
+}
+
+static void* workerLoop(void *arg) {
+    WorkerContext *context = (WorkerContext *) arg;
+    Scheduler *scheduler = context->scheduler;
+    int job;
+
+    if (scheduler->pinThreads)
+        pinThread(scheduler, context->id);
+
+    while (takeJob(scheduler, context->id, &job)) {
+        scheduler->run(scheduler->jobs + (size_t)job * scheduler->jobSize, context->id);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Runs a set of independent jobs on a pool of worker threads and waits
+ * for all of them.
+ *
+ * Each worker starts with a contiguous block of jobs and, once it is done,
+ * steals half of the remaining jobs of another worker. Jobs must write their
+ * results into their own element of the jobs array; the caller then reports
+ * them in array order, so the output does not depend on the scheduling. With
+ * one worker and no pinning, the jobs run in order on the calling thread.
+ *
+ * @param run Function that runs one job.
+ * @param jobs Array of jobs.
+ * @param jobSize Size of each element of the array.
+ * @param numJobs Number of jobs.
+ * @param options Number of workers and pinning.
+ * @return Number of workers used.
+ */
+int runJobs(JobFunction run, void *jobs, size_t jobSize, int numJobs, const SchedulerOptions *options) {
+    int numWorkers = resolveWorkerCount(options);
+    if (numWorkers > numJobs)
+        numWorkers = numJobs > 0 ? numJobs : 1;
+
+    if (numWorkers == 1 && !options->pinThreads) {
+        for (int i = 0; i < numJobs; i++) {
+            run((char *) jobs + (size_t)i * jobSize, 0);
+        }
+        return 1;
+    }
+
+    Scheduler scheduler = { run, (char *) jobs, jobSize, numWorkers, NULL, options->pinThreads, NULL, 0 };
+    scheduler.queues = (WorkQueue *) malloc(numWorkers * sizeof(WorkQueue));
+    scheduler.numCpus = listProcessors(NULL);
+    scheduler.cpus = (int *) malloc(scheduler.numCpus * sizeof(int));
+    listProcessors(scheduler.cpus);
+
+    for (int i = 0; i < numWorkers; i++) {
+        pthread_mutex_init(&scheduler.queues[i].lock, NULL);
+        scheduler.queues[i].head = (int)((long long)i * numJobs / numWorkers);
+        scheduler.queues[i].tail = (int)((long long)(i + 1) * numJobs / numWorkers);
+    }
+
+    pthread_t *threads = (pthread_t *) malloc(numWorkers * sizeof(pthread_t));
+    WorkerContext *contexts = (WorkerContext *) malloc(numWorkers * sizeof(WorkerContext));
+    for (int i = 0; i < numWorkers; i++) {
+        contexts[i] = (WorkerContext) { &scheduler, i };
+        pthread_create(&threads[i], NULL, workerLoop, &contexts[i]);
+    }
+    for (int i = 0; i < numWorkers; i++) {
+        pthread_join(threads[i], NULL);
+        pthread_mutex_destroy(&scheduler.queues[i].lock);
+    }
+
+    free(threads);
+    free(contexts);
+    free(scheduler.queues);
+    free(scheduler.cpus);
+    return numWorkers;
+}
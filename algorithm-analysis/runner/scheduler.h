@@ -0,0 +1,32 @@
+//
+//  scheduler.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef scheduler_h
+#define scheduler_h
+
+#include <stdio.h>
+#include <stdbool.h>
+
+/**
+ * @brief Function that runs one job. The worker number goes from 0 to
+ * numWorkers - 1 and can be used to index per-worker scratch data.
+ */
+typedef void (*JobFunction)(void *job, int worker);
+
+/**
+ * @brief How jobs are spread over the processors.
+ */
+typedef struct {
+    int numWorkers;         // Number of worker threads (one per available processor if < 1)
+    bool pinThreads;        // Pin each worker to its own processor (Linux only)
+} SchedulerOptions;
+
+int availableProcessors(void);
+int resolveWorkerCount(const SchedulerOptions *options);
+int runJobs(JobFunction run, void *jobs, size_t jobSize, int numJobs, const SchedulerOptions *options);
+
+#endif /* scheduler_h */
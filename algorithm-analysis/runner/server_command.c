@@ -0,0 +1,434 @@
+//
+//  server_command.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "runner.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "constants.h"
+#include "graph.h"
+#include "utils.h"
+#include "instances.h"
+#include "scheduler.h"
+#include "statistics.h"
+#include "protocol.h"
+#include "multi_source.h"
+#include "negative_cycle.h"
+#include "hub_labels.h"
+
+// Connections accepted but not yet taken by a worker
+#define SERVER_BACKLOG 64
+
+/**
+ * @brief A graph kept in memory by the server, with its index.
+ */
+typedef struct {
+    char *path;
+    Graph *graph;
+    HubLabels *labels;          // NULL without --index or with negative weights
+    bool nonNegative;
+    LatencyHistogram latency;   // Distance queries served, guarded by the server lock
+} ServedGraph;
+
+typedef struct {
+    ServedGraph *graphs;
+    int numGraphs;
+    pthread_mutex_t lock;       // Guards everything below and the latency histograms
+    pthread_cond_t ready;
+    int pending[SERVER_BACKLOG];
+    int head;
+    int numPending;
+    int *active;                // Connection served by each worker, or -1
+    bool stopping;
+} Server;
+
+typedef struct {
+    Server *server;
+    int id;
+} ServerWorker;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void requestStop(int signal) {
+    (void)signal;
+    stopRequested = 1;
+}
+
+static unsigned long long monotonicNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+}
+
+/**
+ * @brief Answers a distance query from the hub labels when the graph has
+ * them, with a Dijkstra run that stops at the target when the weights are
+ * non-negative, and with a full Bellman-Ford (Tarjan) run otherwise.
+ */
+static void answerDistance(const ServedGraph *served, int src, int dest, QueryResponse *response) {
+    Graph *graph = served->graph;
+    int distance;
+
+    if (served->labels != NULL) {
+        distance = hubLabelDistance(served->labels, src, dest);
+    } else if (served->nonNegative) {
+        int found;
+        if (nearestTargets(graph, src, &dest, 1, 1, &found, &distance) == 0)
+            distance = INT_MAX;
+    } else {
+        int *dist = (int *) malloc(graph->numNodes * sizeof(int));
+        int negativeCycle = bellmanFordTarjanDistances(graph, src, dist, NULL);
+        distance = dist[dest];
+        free(dist);
+        if (negativeCycle) {
+            response->status = QUERY_NEGATIVE_CYCLE;
+            return;
+        }
+    }
+
+    response->status = distance == INT_MAX ? QUERY_UNREACHABLE : QUERY_OK;
+    response->distance = distance == INT_MAX ? 0 : distance;
+}
+
+static void summarizeLatency(const LatencyHistogram *latency, LatencySummary *summary) {
+    summary->count = latency->count;
+    summary->meanNanos = latency->count > 0 ? latency->totalNanos / latency->count : 0;
+    summary->p50Nanos = latencyPercentile(latency, 0.50);
+    summary->p90Nanos = latencyPercentile(latency, 0.90);
+    summary->p99Nanos = latencyPercentile(latency, 0.99);
+    summary->maxNanos = latency->maxNanos;
+}
+
+/**
+ * @brief Answers the requests of one connection until the client closes it.
+ */
+static void serveConnection(Server *server, int fd) {
+    QueryRequest request;
+
+    while (readMessage(fd, &request, sizeof(request)) == 1) {
+        unsigned long long start = monotonicNanos();
+        QueryResponse response = { QUERY_BAD_REQUEST, 0, 0 };
+        bool validGraph = request.graph < (uint32_t)server->numGraphs;
+        ServedGraph *served = validGraph ? &server->graphs[request.graph] : NULL;
+        GraphInfo info;
+        LatencySummary summary;
+        const void *payload = NULL;
+        size_t payloadSize = 0;
+
+        switch (request.type) {
+            case QUERY_DISTANCE:
+                if (validGraph && request.src >= 0 && request.src < served->graph->numNodes &&
+                    request.dest >= 0 && request.dest < served->graph->numNodes) {
+                    answerDistance(served, request.src, request.dest, &response);
+                }
+                break;
+            case QUERY_INFO:
+                if (validGraph) {
+                    info = (GraphInfo) { served->graph->numNodes, served->graph->numEdges,
+                                         (uint32_t)server->numGraphs, served->labels != NULL };
+                    response.status = QUERY_OK;
+                    payload = &info;
+                    payloadSize = sizeof(info);
+                }
+                break;
+            case QUERY_STATS:
+                if (validGraph || request.graph == QUERY_ALL_GRAPHS) {
+                    LatencyHistogram *latency = (LatencyHistogram *) malloc(sizeof(LatencyHistogram));
+                    initLatencyHistogram(latency);
+                    pthread_mutex_lock(&server->lock);
+                    for (int g = 0; g < server->numGraphs; g++) {
+                        if (!validGraph || g == (int)request.graph)
+                            mergeLatency(latency, &server->graphs[g].latency);
+                    }
+                    pthread_mutex_unlock(&server->lock);
+                    summarizeLatency(latency, &summary);
+                    free(latency);
+                    response.status = QUERY_OK;
+                    payload = &summary;
+                    payloadSize = sizeof(summary);
+                }
+                break;
+            case QUERY_SHUTDOWN:
+                stopRequested = 1;
+                response.status = QUERY_OK;
+                break;
+        }
+
+        response.nanos = monotonicNanos() - start;
+        if (request.type == QUERY_DISTANCE && response.status != QUERY_BAD_REQUEST) {
+            pthread_mutex_lock(&server->lock);
+            recordLatency(&served->latency, response.nanos);
+            pthread_mutex_unlock(&server->lock);
+        }
+
+        if (!writeMessage(fd, &response, sizeof(response)))
+            break;
+        if (payload != NULL && !writeMessage(fd, payload, payloadSize))
+            break;
+    }
+}
+
+/**
+ * @brief Takes accepted connections off the pending queue and serves them,
+ * one at a time, until the server stops.
+ */
+static void* serverWorkerLoop(void *arg) {
+    ServerWorker *worker = (ServerWorker *) arg;
+    Server *server = worker->server;
+
+    for (;;) {
+        pthread_mutex_lock(&server->lock);
+        while (server->numPending == 0 && !server->stopping) {
+            pthread_cond_wait(&server->ready, &server->lock);
+        }
+        if (server->stopping) {
+            pthread_mutex_unlock(&server->lock);
+            break;
+        }
+        int fd = server->pending[server->head];
+        server->head = (server->head + 1) % SERVER_BACKLOG;
+        server->numPending--;
+        server->active[worker->id] = fd;
+        pthread_mutex_unlock(&server->lock);
+
+        serveConnection(server, fd);
+
+        // Cleared before closing, so the main thread never shuts down a
+        // descriptor number that has been reused
+        pthread_mutex_lock(&server->lock);
+        server->active[worker->id] = -1;
+        pthread_mutex_unlock(&server->lock);
+        close(fd);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Creates the listening socket. A stale socket file left by a server
+ * that did not exit cleanly is removed; a live server is left alone.
+ *
+ * @return The socket, or -1 on error.
+ */
+static int listenOnSocket(const char *socketPath) {
+    struct sockaddr_un address;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Socket path is too long: %s\n", socketPath);
+        return -1;
+    }
+
+    int existing = connectToServer(socketPath);
+    if (existing >= 0) {
+        close(existing);
+        fprintf(stderr, "A server is already listening on %s\n", socketPath);
+        return -1;
+    }
+    unlink(socketPath);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    if (bind(fd, (struct sockaddr *) &address, sizeof(address)) < 0 || listen(fd, SERVER_BACKLOG) < 0) {
+        perror(socketPath);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void printLatencyTable(const Server *server) {
+    printf("\n%-40s %10s %10s %10s %10s %10s\n", "Graph", "Queries", "Mean us", "p50 us", "p99 us", "Max us");
+    for (int g = 0; g < server->numGraphs; g++) {
+        LatencySummary summary;
+        summarizeLatency(&server->graphs[g].latency, &summary);
+        const char *name = strrchr(server->graphs[g].path, '/');
+        printf("%-40s %10llu %10.1f %10.1f %10.1f %10.1f\n", name != NULL ? name + 1 : server->graphs[g].path,
+               (unsigned long long)summary.count, summary.meanNanos / 1e3, summary.p50Nanos / 1e3,
+               summary.p99Nanos / 1e3, summary.maxNanos / 1e3);
+    }
+}
+
+/**
+ * @brief Loads the selected instances once and answers distance queries on
+ * a Unix domain socket until it receives SIGINT, SIGTERM or a shutdown
+ * request, then prints the latency of the queries served.
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if the server could not start.
+ */
+int runServe(int argc, const char *argv[]) {
+    InstanceSelection instances;
+    const char *socketPath = SERVER_SOCKET_PATH;
+    SchedulerOptions scheduling = { 0, false };
+    bool index = false;
+    bool rebuild = false;
+
+    initInstanceSelection(&instances);
+    for (int i = 0; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (parseInstanceOption(argc, argv, &i, &instances)) {
+            continue;
+        } else if (strcmp(argv[i], "--socket") == 0 && value != NULL) {
+            socketPath = value;
+            i++;
+        } else if (strcmp(argv[i], "--threads") == 0 && value != NULL) {
+            scheduling.numWorkers = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--index") == 0) {
+            index = true;
+        } else if (strcmp(argv[i], "--rebuild") == 0) {
+            index = true;
+            rebuild = true;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!resolveInstances(&instances, 0) || instances.numPaths == 0) {
+        fprintf(stderr, "No instances to serve.\n");
+        return EXIT_FAILURE;
+    }
+
+    Server server;
+    memset(&server, 0, sizeof(server));
+    server.graphs = (ServedGraph *) calloc(instances.numPaths, sizeof(ServedGraph));
+    for (int p = 0; p < instances.numPaths; p++) {
+        Graph *graph = loadGraph(instances.paths[p]);
+        if (graph == NULL || graph->numNodes == 0) {
+            fprintf(stderr, "%s: %s", instances.paths[p], graph == NULL ? ERROR_MSG_PROCESS_FILE : "the graph is empty\n");
+            if (graph != NULL)
+                freeGraph(graph);
+            continue;
+        }
+
+        ServedGraph *served = &server.graphs[server.numGraphs];
+        int minWeight, maxWeight;
+        edgeWeightRange(graph, &minWeight, &maxWeight);
+        served->path = instances.paths[p];
+        served->graph = graph;
+        served->nonNegative = minWeight >= 0;
+        initLatencyHistogram(&served->latency);
+        if (index && served->nonNegative) {
+            double buildTime;
+            served->labels = obtainHubLabels(graph, served->path, rebuild, &buildTime);
+        }
+        printf("Graph %d: %s (%d nodes, %d arcs%s)\n", server.numGraphs, served->path, graph->numNodes,
+               graph->numEdges, served->labels != NULL ? ", hub labels" : "");
+        server.numGraphs++;
+    }
+
+    int listenFd = server.numGraphs > 0 ? listenOnSocket(socketPath) : -1;
+    if (listenFd < 0) {
+        if (server.numGraphs == 0)
+            fprintf(stderr, "No instances to serve.\n");
+        for (int g = 0; g < server.numGraphs; g++) {
+            freeGraph(server.graphs[g].graph);
+            if (server.graphs[g].labels != NULL)
+                freeHubLabels(server.graphs[g].labels);
+        }
+        free(server.graphs);
+        freeInstanceSelection(&instances);
+        return EXIT_FAILURE;
+    }
+
+    // Writes to a client that went away fail with EPIPE instead of killing the server
+    signal(SIGPIPE, SIG_IGN);
+    stopRequested = 0;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    int numWorkers = resolveWorkerCount(&scheduling);
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_cond_init(&server.ready, NULL);
+    server.active = (int *) malloc(numWorkers * sizeof(int));
+    pthread_t *threads = (pthread_t *) malloc(numWorkers * sizeof(pthread_t));
+    ServerWorker *workers = (ServerWorker *) malloc(numWorkers * sizeof(ServerWorker));
+    for (int w = 0; w < numWorkers; w++) {
+        server.active[w] = -1;
+        workers[w] = (ServerWorker) { &server, w };
+        pthread_create(&threads[w], NULL, serverWorkerLoop, &workers[w]);
+    }
+    printf("Listening on %s with %d worker%s.\n", socketPath, numWorkers, numWorkers == 1 ? "" : "s");
+    fflush(stdout);
+
+    // The accept loop wakes up regularly to notice stop requests
+    struct pollfd listening = { listenFd, POLLIN, 0 };
+    while (!stopRequested) {
+        if (poll(&listening, 1, 100) <= 0 || !(listening.revents & POLLIN))
+            continue;
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0)
+            continue;
+
+        pthread_mutex_lock(&server.lock);
+        if (server.numPending == SERVER_BACKLOG) {
+            pthread_mutex_unlock(&server.lock);
+            close(fd);
+            continue;
+        }
+        server.pending[(server.head + server.numPending) % SERVER_BACKLOG] = fd;
+        server.numPending++;
+        pthread_cond_signal(&server.ready);
+        pthread_mutex_unlock(&server.lock);
+    }
+
+    // Wake up the workers, including the ones waiting for an idle client
+    pthread_mutex_lock(&server.lock);
+    server.stopping = true;
+    for (int w = 0; w < numWorkers; w++) {
+        if (server.active[w] >= 0)
+            shutdown(server.active[w], SHUT_RDWR);
+    }
+    pthread_cond_broadcast(&server.ready);
+    pthread_mutex_unlock(&server.lock);
+    for (int w = 0; w < numWorkers; w++) {
+        pthread_join(threads[w], NULL);
+    }
+    for (int i = 0; i < server.numPending; i++) {
+        close(server.pending[(server.head + i) % SERVER_BACKLOG]);
+    }
+    close(listenFd);
+    unlink(socketPath);
+
+    printLatencyTable(&server);
+
+    pthread_mutex_destroy(&server.lock);
+    pthread_cond_destroy(&server.ready);
+    for (int g = 0; g < server.numGraphs; g++) {
+        freeGraph(server.graphs[g].graph);
+        if (server.graphs[g].labels != NULL)
+            freeHubLabels(server.graphs[g].labels);
+    }
+    free(server.graphs);
+    free(server.active);
+    free(threads);
+    free(workers);
+    freeInstanceSelection(&instances);
+    return EXIT_SUCCESS;
+}
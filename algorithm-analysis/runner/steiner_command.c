@@ -0,0 +1,119 @@
+//
+//  steiner_command.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "runner.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "constants.h"
+#include "graph.h"
+#include "utils.h"
+#include "instances.h"
+#include "steiner.h"
+
+/**
+ * @brief Prints the cost, size and running time of a tree, and the result of
+ * checking it against the graph.
+ */
+static void printSteinerTree(const char *label, Graph *graph, const SteinerTree *tree, double seconds) {
+    bool valid = checkSteinerTree(graph, graph->terminals, graph->numTerminals, tree);
+
+    printf("%s: cost %lld, %d edges, executed in %.6f seconds.%s%s\n", label, tree->cost, tree->numEdges, seconds,
+           tree->spansTerminals ? "" : " Some terminals are unreachable.", valid ? "" : " INVALID TREE");
+}
+
+/**
+ * @brief Builds Steiner trees for the terminals of the selected instances with
+ * the shortest path heuristic (Takahashi-Matsuyama, started from several
+ * terminals in parallel) and the distance network heuristic (Mehlhorn).
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if an option is invalid or a tree fails the check.
+ */
+int runSteiner(int argc, const char *argv[]) {
+    InstanceSelection instances;
+    const char *heuristic = "all";
+    int numRoots = 16;
+    int numThreads = 0;
+    int failed = 0;
+
+    initInstanceSelection(&instances);
+    for (int i = 0; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (parseInstanceOption(argc, argv, &i, &instances)) {
+            continue;
+        } else if (strcmp(argv[i], "--heuristic") == 0 && value != NULL) {
+            heuristic = value;
+            i++;
+        } else if (strcmp(argv[i], "--roots") == 0 && value != NULL) {
+            numRoots = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--threads") == 0 && value != NULL) {
+            numThreads = atoi(value);
+            i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    bool runShortestPath = strcmp(heuristic, "all") == 0 || strcmp(heuristic, "tm") == 0;
+    bool runMehlhorn = strcmp(heuristic, "all") == 0 || strcmp(heuristic, "mehlhorn") == 0;
+    if (!runShortestPath && !runMehlhorn) {
+        fprintf(stderr, "Unknown heuristic: %s (use tm, mehlhorn or all)\n", heuristic);
+        return EXIT_FAILURE;
+    }
+
+    if (!resolveInstances(&instances, 0) || instances.numPaths == 0) {
+        fprintf(stderr, "No instances to run.\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int p = 0; p < instances.numPaths; p++) {
+        printf("\n==> %s\n", instances.paths[p]);
+
+        Graph *graph = loadGraph(instances.paths[p]);
+        if (graph == NULL) {
+            fprintf(stderr, ERROR_MSG_PROCESS_FILE);
+            continue;
+        }
+        if (graph->numTerminals == 0) {
+            printf("---> No terminals, skipping.\n");
+            freeGraph(graph);
+            continue;
+        }
+        printf("---> Nodes: %d, arcs: %d, terminals: %d\n", graph->numNodes, graph->numEdges, graph->numTerminals);
+
+        SteinerTree tree;
+        double start;
+
+        if (runShortestPath) {
+            start = wallTime();
+            steinerShortestPathMultiStart(graph, graph->terminals, graph->numTerminals, numRoots, numThreads, &tree);
+            printSteinerTree("Shortest path heuristic", graph, &tree, wallTime() - start);
+            failed += !checkSteinerTree(graph, graph->terminals, graph->numTerminals, &tree);
+            printf("---> Best root: node %d\n", tree.root);
+            freeSteinerTree(&tree);
+        }
+
+        if (runMehlhorn) {
+            start = wallTime();
+            steinerMehlhorn(graph, graph->terminals, graph->numTerminals, numThreads, &tree);
+            printSteinerTree("Mehlhorn heuristic", graph, &tree, wallTime() - start);
+            failed += !checkSteinerTree(graph, graph->terminals, graph->numTerminals, &tree);
+            freeSteinerTree(&tree);
+        }
+
+        freeGraph(graph);
+    }
+
+    freeInstanceSelection(&instances);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+//
+//  terminals_command.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "runner.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "constants.h"
+#include "graph.h"
+#include "utils.h"
+#include "instances.h"
+#include "memory_stats.h"
+#include "multi_source.h"
+
+/**
+ * @brief Prints the size of the graph Voronoi cells of the terminals.
+ */
+static void printVoronoiSummary(Graph *graph, const int *dist, const int *nearest) {
+    int *cellSize = (int *) calloc(graph->numNodes, sizeof(int));
+    int unreached = 0, maxDist = 0;
+
+    for (int v = 0; v < graph->numNodes; v++) {
+        if (nearest[v] < 0) {
+            unreached++;
+            continue;
+        }
+        cellSize[nearest[v]]++;
+        if (dist[v] > maxDist) {
+            maxDist = dist[v];
+        }
+    }
+
+    int minCell = INT_MAX, maxCell = 0;
+    for (int t = 0; t < graph->numTerminals; t++) {
+        int size = cellSize[graph->terminals[t]];
+        minCell = size < minCell ? size : minCell;
+        maxCell = size > maxCell ? size : maxCell;
+    }
+
+    printf("---> Voronoi cells: min %d, avg %.1f, max %d nodes; farthest node at distance %d; %d unreached\n",
+           minCell, (double)(graph->numNodes - unreached) / graph->numTerminals, maxCell, maxDist, unreached);
+    free(cellSize);
+}
+
+/**
+ * @brief Runs the terminal-based searches on the selected instances: a
+ * multi-source Dijkstra from all terminals (graph Voronoi diagram) and, with
+ * --k, a search from one source that stops after the k nearest terminals.
+ *
+ * @param argc Number of arguments after the command name.
+ * @param argv Arguments after the command name.
+ * @return EXIT_SUCCESS or EXIT_FAILURE.
+ */
+int runTerminals(int argc, const char *argv[]) {
+    InstanceSelection instances;
+    int k = 0;
+    int src = 0;
+
+    initInstanceSelection(&instances);
+    for (int i = 0; i < argc; i++) {
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (parseInstanceOption(argc, argv, &i, &instances)) {
+            continue;
+        } else if (strcmp(argv[i], "--k") == 0 && value != NULL) {
+            k = atoi(value);
+            i++;
+        } else if (strcmp(argv[i], "--source") == 0 && value != NULL) {
+            src = atoi(value);
+            i++;
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!resolveInstances(&instances, 0) || instances.numPaths == 0) {
+        fprintf(stderr, "No instances to run.\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int p = 0; p < instances.numPaths; p++) {
+        printf("\n==> %s\n", instances.paths[p]);
+
+        Graph *graph = loadGraph(instances.paths[p]);
+        if (graph == NULL) {
+            fprintf(stderr, ERROR_MSG_PROCESS_FILE);
+            continue;
+        }
+        if (graph->numTerminals == 0) {
+            printf("---> No terminals, skipping.\n");
+            freeGraph(graph);
+            continue;
+        }
+        printf("---> Nodes: %d, arcs: %d, terminals: %d\n", graph->numNodes, graph->numEdges, graph->numTerminals);
+
+        int *dist = (int *) trackedMalloc(MEM_BUFFERS, graph->numNodes * sizeof(int));
+        int *nearest = (int *) trackedMalloc(MEM_BUFFERS, graph->numNodes * sizeof(int));
+
+        double start = wallTime();
+        multiSourceDijkstra(graph, graph->terminals, graph->numTerminals, NULL, 0, dist, NULL, nearest, NULL);
+        printf("Multi-source Dijkstra from all terminals executed in %.6f seconds.\n", wallTime() - start);
+        printVoronoiSummary(graph, dist, nearest);
+
+        if (k > 0 && src >= 0 && src < graph->numNodes) {
+            int *found = (int *) malloc(k * sizeof(int));
+            int *foundDist = (int *) malloc(k * sizeof(int));
+
+            start = wallTime();
+            int count = nearestTargets(graph, src, graph->terminals, graph->numTerminals, k, found, foundDist);
+            double targetTime = wallTime() - start;
+
+            start = wallTime();
+            multiSourceDijkstra(graph, &src, 1, NULL, 0, dist, NULL, NULL, NULL);
+            double fullTime = wallTime() - start;
+
+            printf("\n%d nearest terminals from node %d found in %.6f seconds (full run: %.6f seconds):\n",
+                   count, src, targetTime, fullTime);
+            for (int i = 0; i < count; i++) {
+                printf("  node %d at distance %d\n", found[i], foundDist[i]);
+            }
+
+            free(found);
+            free(foundDist);
+        }
+
+        trackedFree(MEM_BUFFERS, dist);
+        trackedFree(MEM_BUFFERS, nearest);
+        freeGraph(graph);
+    }
+
+    freeInstanceSelection(&instances);
+    return EXIT_SUCCESS;
+}
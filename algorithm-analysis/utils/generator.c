@@ -0,0 +1,416 @@
+//
+//  generator.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "generator.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+
+#include "constants.h"
+#include "utils.h"
+
+/**
+ * @brief Destination of the generated edges. The edge count in the header is
+ * written as a placeholder and patched once all edges are known.
+ */
+typedef struct {
+    FILE *fp;
+    GraphFileFormat format;
+    long countOffset;           // Position of the edge count placeholder
+    long long count;            // Number of edges (stp) or arcs (dat, bin) written
+    const char *error;          // First write error (NULL if none); later edges are not written
+} EdgeWriter;
+
+/**
+ * @brief Returns the next value of a splitmix64 generator. It is used instead
+ * of rand() so that the instances do not depend on the C library of the machine.
+ */
+unsigned long long nextRandom(Random *random) {
+    unsigned long long z = (random->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static double nextUniform(Random *random) {
+    return (nextRandom(random) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int nextWeight(Random *random, int maxWeight) {
+    return 1 + (int)(nextRandom(random) % (unsigned long long)maxWeight);
+}
+
+/**
+ * @brief Parses the name of a graph family.
+ *
+ * @param name One of "gnp", "grid", "rmat" or "complete".
+ * @param type Output parameter with the parsed type.
+ * @return 1 on success, 0 if the name is unknown.
+ */
+int parseGraphType(const char *name, SyntheticGraphType *type) {
+    for (int t = GRAPH_GNP; t <= GRAPH_COMPLETE; t++) {
+        if (strcmp(name, graphTypeName(t)) == 0) {
+            *type = t;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Parses the name of an output format.
+ *
+ * @param name One of "stp", "dat" or "bin".
+ * @param format Output parameter with the parsed format.
+ * @return 1 on success, 0 if the name is unknown.
+ */
+int parseGraphFileFormat(const char *name, GraphFileFormat *format) {
+    for (int f = FORMAT_STP; f <= FORMAT_BIN; f++) {
+        if (strcmp(name, graphFileExtension(f) + 1) == 0) {
+            *format = f;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char* graphTypeName(SyntheticGraphType type) {
+    switch (type) {
+        case GRAPH_GNP: return "gnp";
+        case GRAPH_GRID: return "grid";
+        case GRAPH_RMAT: return "rmat";
+        case GRAPH_COMPLETE: return "complete";
+    }
+    return "unknown";
+}
+
+const char* graphFileExtension(GraphFileFormat format) {
+    switch (format) {
+        case FORMAT_STP: return ".stp";
+        case FORMAT_DAT: return ".dat";
+        case FORMAT_BIN: return BINARY_GRAPH_EXTENSION;
+    }
+    return "";
+}
+
+/**
+ * @brief Builds the canonical file name of a synthetic instance, e.g.
+ * "gnp_n100000_d8_w100_s1.bin".
+ *
+ * @param options Generator parameters.
+ * @param format Output format.
+ * @param buffer Buffer that receives the name.
+ * @param size Size of the buffer.
+ */
+void syntheticFileName(const GeneratorOptions *options, GraphFileFormat format, char *buffer, size_t size) {
+    if (options->type == GRAPH_COMPLETE) {
+        snprintf(buffer, size, "%s_n%d_w%d_s%llu%s", graphTypeName(options->type), options->numNodes,
+                 options->maxWeight, options->seed, graphFileExtension(format));
+    } else {
+        snprintf(buffer, size, "%s_n%d_d%g_w%d_s%llu%s", graphTypeName(options->type), options->numNodes,
+                 options->avgDegree, options->maxWeight, options->seed, graphFileExtension(format));
+    }
+}
+
+/**
+ * @brief Records the first failed write of a writer.
+ */
+static void checkWrite(EdgeWriter *writer, int ok) {
+    if (!ok && writer->error == NULL) {
+        writer->error = strerror(errno);
+    }
+}
+
+static void writeHeader(EdgeWriter *writer, const GeneratorOptions *options) {
+    FILE *fp = writer->fp;
+    switch (writer->format) {
+        case FORMAT_STP:
+            checkWrite(writer, fprintf(fp, "33D32945 STP File, STP Format Version  1.00\n") >= 0);
+            checkWrite(writer, fprintf(fp, "Section Comment\n") >= 0);
+            checkWrite(writer, fprintf(fp, "Name    \"%s\"\n", graphTypeName(options->type)) >= 0);
+            checkWrite(writer, fprintf(fp, "Creator \"algorithm-analysis generator\"\n") >= 0);
+            checkWrite(writer, fprintf(fp, "Remark  \"seed %llu, average degree %g, max weight %d\"\n",
+                                       options->seed, options->avgDegree, options->maxWeight) >= 0);
+            checkWrite(writer, fprintf(fp, "End\n\nSection Graph\n") >= 0);
+            checkWrite(writer, fprintf(fp, "Nodes %d\n", options->numNodes) >= 0);
+            checkWrite(writer, fprintf(fp, "Edges ") >= 0);
+            writer->countOffset = ftell(fp);
+            checkWrite(writer, fprintf(fp, "%12d\n", 0) >= 0);
+            break;
+        case FORMAT_DAT:
+            checkWrite(writer, fprintf(fp, "NB_NODES \t\t %d\n", options->numNodes) >= 0);
+            checkWrite(writer, fprintf(fp, "NB_ARCS  \t\t ") >= 0);
+            writer->countOffset = ftell(fp);
+            checkWrite(writer, fprintf(fp, "%12d\n", 0) >= 0);
+            checkWrite(writer, fprintf(fp, "LIST_OF_ARCS \t COSTS \n") >= 0);
+            break;
+        case FORMAT_BIN: {
+            unsigned char header[8];
+            encodeInt32(header, options->numNodes);
+            encodeInt32(header + 4, 0);
+            checkWrite(writer, fwrite(BINARY_GRAPH_MAGIC, 1, sizeof(BINARY_GRAPH_MAGIC) - 1, fp) ==
+                               sizeof(BINARY_GRAPH_MAGIC) - 1);
+            checkWrite(writer, fwrite(header, 1, 4, fp) == 4);
+            writer->countOffset = ftell(fp);
+            checkWrite(writer, fwrite(header + 4, 1, 4, fp) == 4);
+            break;
+        }
+    }
+    checkWrite(writer, writer->countOffset >= 0);
+}
+
+/**
+ * @brief Writes the end of the file and patches the edge count in the header.
+ * Counts above INT_MAX do not fit the header and make the file invalid.
+ */
+static void writeFooter(EdgeWriter *writer) {
+    FILE *fp = writer->fp;
+    if (writer->error != NULL)
+        return;
+    if (writer->count > INT_MAX) {
+        writer->error = "too many edges for the 32-bit count of the header";
+        return;
+    }
+    int count = (int)writer->count;
+
+    if (writer->format == FORMAT_STP) {
+        checkWrite(writer, fprintf(fp, "End\n\nEOF\n") >= 0);
+    } else if (writer->format == FORMAT_DAT) {
+        checkWrite(writer, fprintf(fp, "END\n") >= 0);
+    }
+
+    checkWrite(writer, fseek(fp, writer->countOffset, SEEK_SET) == 0);
+    if (writer->format == FORMAT_BIN) {
+        unsigned char bytes[4];
+        encodeInt32(bytes, count);
+        checkWrite(writer, fwrite(bytes, 1, 4, fp) == 4);
+    } else {
+        checkWrite(writer, fprintf(fp, "%12d", count) >= 0);
+    }
+}
+
+/**
+ * @brief Writes an undirected edge in the writer's format.
+ */
+static void writeEdge(EdgeWriter *writer, int u, int v, int weight) {
+    if (writer->error != NULL)
+        return;
+    switch (writer->format) {
+        case FORMAT_STP:
+            checkWrite(writer, fprintf(writer->fp, "E %d %d %d\n", u + 1, v + 1, weight) >= 0);
+            writer->count++;
+            break;
+        case FORMAT_DAT:
+            checkWrite(writer, fprintf(writer->fp, "%d \t %d \t %d \n", u, v, weight) >= 0);
+            checkWrite(writer, fprintf(writer->fp, "%d \t %d \t %d \n", v, u, weight) >= 0);
+            writer->count += 2;
+            break;
+        case FORMAT_BIN: {
+            int arcs[6] = { u, v, weight, v, u, weight };
+            unsigned char bytes[24];
+            for (int i = 0; i < 6; i++) {
+                encodeInt32(bytes + 4 * i, arcs[i]);
+            }
+            checkWrite(writer, fwrite(bytes, 1, sizeof(bytes), writer->fp) == sizeof(bytes));
+            writer->count += 2;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief G(n, p) graph. Non-edges are skipped with geometric jumps (Batagelj
+ * and Brandes), so the running time is proportional to n + m.
+ */
+static void generateGnp(EdgeWriter *writer, const GeneratorOptions *options, Random *random) {
+    int n = options->numNodes;
+    double p = n > 1 ? options->avgDegree / (n - 1) : 0.0;
+    if (p <= 0.0) {
+        return;
+    }
+
+    double logq = log(1.0 - p);
+    long long v = 1, w = -1;
+    while (v < n) {
+        if (p >= 1.0) {
+            w++;
+        } else {
+            w += 1 + (long long)floor(log(1.0 - nextUniform(random)) / logq);
+        }
+        while (w >= v && v < n) {
+            w -= v;
+            v++;
+        }
+        if (v < n) {
+            writeEdge(writer, (int)v, (int)w, nextWeight(random, options->maxWeight));
+        }
+    }
+}
+
+/**
+ * @brief Neighbours of node u after it in a grid of the given width: right
+ * and down, and with diagonals also down-right and down-left.
+ *
+ * @param neighbours Array of 4 entries that receives them.
+ * @return Number of neighbours.
+ */
+static int gridNeighbours(int u, int n, int cols, int diagonals, int *neighbours) {
+    int count = 0;
+    int first = u % cols == 0, last = (u + 1) % cols == 0;
+    if (!last && u + 1 < n)
+        neighbours[count++] = u + 1;
+    if (u + cols < n)
+        neighbours[count++] = u + cols;
+    if (diagonals && !last && u + cols + 1 < n)
+        neighbours[count++] = u + cols + 1;
+    if (diagonals && !first && u + cols - 1 < n)
+        neighbours[count++] = u + cols - 1;
+    return count;
+}
+
+/**
+ * @brief Grid graph, similar to the VLSI instances. The lattice links every
+ * node to its horizontal and vertical neighbours, and also to its diagonal
+ * ones when the requested degree is above what that lattice has (about 4).
+ * Each lattice edge is kept with probability avgDegree / lattice degree, so
+ * the expected average degree is avgDegree up to the degree of the lattice.
+ */
+static void generateGrid(EdgeWriter *writer, const GeneratorOptions *options, Random *random) {
+    int n = options->numNodes;
+    int cols = (int)ceil(sqrt((double)n));
+    int neighbours[4];
+    if (n < 2) {
+        return;
+    }
+
+    long long latticeEdges = 0;
+    for (int u = 0; u < n; u++) {
+        latticeEdges += gridNeighbours(u, n, cols, 0, neighbours);
+    }
+    int diagonals = options->avgDegree > 2.0 * latticeEdges / n;
+    if (diagonals) {
+        latticeEdges = 0;
+        for (int u = 0; u < n; u++) {
+            latticeEdges += gridNeighbours(u, n, cols, 1, neighbours);
+        }
+    }
+    double keep = latticeEdges > 0 ? options->avgDegree * n / (2.0 * latticeEdges) : 0.0;
+
+    for (int u = 0; u < n; u++) {
+        int count = gridNeighbours(u, n, cols, diagonals, neighbours);
+        for (int k = 0; k < count; k++) {
+            if (nextUniform(random) < keep) {
+                writeEdge(writer, u, neighbours[k], nextWeight(random, options->maxWeight));
+            }
+        }
+    }
+}
+
+/**
+ * @brief R-MAT graph with the usual (0.57, 0.19, 0.19, 0.05) probabilities.
+ * Self loops and endpoints beyond numNodes are drawn again; parallel edges are kept.
+ */
+static void generateRmat(EdgeWriter *writer, const GeneratorOptions *options, Random *random) {
+    int n = options->numNodes;
+    long long numEdges = (long long)(n * options->avgDegree / 2.0);
+    int scale = 0;
+    while ((1LL << scale) < n) {
+        scale++;
+    }
+    if (n < 2) {
+        return;
+    }
+
+    for (long long e = 0; e < numEdges; e++) {
+        long long u, v;
+        do {
+            u = 0;
+            v = 0;
+            for (int level = 0; level < scale; level++) {
+                double r = nextUniform(random);
+                u <<= 1;
+                v <<= 1;
+                if (r < 0.57) {
+                    // top-left quadrant
+                } else if (r < 0.76) {
+                    v |= 1;
+                } else if (r < 0.95) {
+                    u |= 1;
+                } else {
+                    u |= 1;
+                    v |= 1;
+                }
+            }
+        } while (u >= n || v >= n || u == v);
+        writeEdge(writer, (int)u, (int)v, nextWeight(random, options->maxWeight));
+    }
+}
+
+static void generateComplete(EdgeWriter *writer, const GeneratorOptions *options, Random *random) {
+    for (int u = 0; u < options->numNodes; u++) {
+        for (int v = u + 1; v < options->numNodes; v++) {
+            writeEdge(writer, u, v, nextWeight(random, options->maxWeight));
+        }
+    }
+}
+
+/**
+ * @brief Generates a synthetic instance and writes it to a file. Edges are
+ * streamed to the file as they are generated, so large instances do not need
+ * to fit in memory. They go to PATH.tmp first, which is renamed to path only
+ * once the whole file is written, so an interrupted run leaves no file that a
+ * later run would reuse.
+ *
+ * @param options Generator parameters.
+ * @param format Output format.
+ * @param path Path of the file to be written.
+ * @return Number of edges (stp) or arcs (dat, bin) written, or -1 on error.
+ */
+long long generateGraphFile(const GeneratorOptions *options, GraphFileFormat format, const char *path) {
+    char *tempPath = malloc(strlen(path) + sizeof(".tmp"));
+    sprintf(tempPath, "%s.tmp", path);
+    FILE *fp = fopen(tempPath, format == FORMAT_BIN ? "wb" : "w");
+    if (fp == NULL) {
+        perror(ERROR_MSG_OUTPUT_FILE);
+        free(tempPath);
+        return -1;
+    }
+
+    EdgeWriter writer = { fp, format, 0, 0, NULL };
+    Random random = { options->seed };
+
+    writeHeader(&writer, options);
+    switch (options->type) {
+        case GRAPH_GNP:
+            generateGnp(&writer, options, &random);
+            break;
+        case GRAPH_GRID:
+            generateGrid(&writer, options, &random);
+            break;
+        case GRAPH_RMAT:
+            generateRmat(&writer, options, &random);
+            break;
+        case GRAPH_COMPLETE:
+            generateComplete(&writer, options, &random);
+            break;
+    }
+    writeFooter(&writer);
+
+    checkWrite(&writer, fclose(fp) == 0);
+    checkWrite(&writer, writer.error != NULL || rename(tempPath, path) == 0);
+    if (writer.error != NULL) {
+        fprintf(stderr, "Failed to write %s: %s\n", path, writer.error);
+        remove(tempPath);
+        free(tempPath);
+        return -1;
+    }
+    free(tempPath);
+    return writer.count;
+}
@@ -0,0 +1,59 @@
+//
+//  generator.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef generator_h
+#define generator_h
+
+#include <stdio.h>
+
+/**
+ * @brief Families of synthetic graphs that can be generated.
+ */
+typedef enum {
+    GRAPH_GNP,       // Random G(n, p) graph
+    GRAPH_GRID,      // VLSI-like grid with missing edges
+    GRAPH_RMAT,      // Power-law graph from the R-MAT recursive model
+    GRAPH_COMPLETE   // Complete graph
+} SyntheticGraphType;
+
+/**
+ * @brief Output formats, matching the formats the loader understands.
+ */
+typedef enum {
+    FORMAT_STP,      // SteinLib .stp file (undirected edges, 1-based)
+    FORMAT_DAT,      // .dat file with both arc directions (0-based)
+    FORMAT_BIN       // Binary arc list (both arc directions)
+} GraphFileFormat;
+
+/**
+ * @brief State of the splitmix64 pseudo-random generator.
+ */
+typedef struct {
+    unsigned long long state;
+} Random;
+
+/**
+ * @brief Parameters of a synthetic instance. The same parameters always
+ * produce the same file, on any machine.
+ */
+typedef struct {
+    SyntheticGraphType type;
+    int numNodes;
+    double avgDegree;           // Expected average degree (ignored by complete graphs)
+    int maxWeight;              // Weights are drawn uniformly from [1, maxWeight]
+    unsigned long long seed;
+} GeneratorOptions;
+
+unsigned long long nextRandom(Random *random);
+int parseGraphType(const char *name, SyntheticGraphType *type);
+int parseGraphFileFormat(const char *name, GraphFileFormat *format);
+const char* graphTypeName(SyntheticGraphType type);
+const char* graphFileExtension(GraphFileFormat format);
+void syntheticFileName(const GeneratorOptions *options, GraphFileFormat format, char *buffer, size_t size);
+long long generateGraphFile(const GeneratorOptions *options, GraphFileFormat format, const char *path);
+
+#endif /* generator_h */
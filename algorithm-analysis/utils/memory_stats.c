@@ -0,0 +1,171 @@
+//
+//  memory_stats.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "memory_stats.h"
+
+#include <sys/resource.h>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#define usableSize(ptr) malloc_size(ptr)
+#elif defined(__linux__)
+#include <malloc.h>
+#define usableSize(ptr) malloc_usable_size(ptr)
+#else
+#define usableSize(ptr) ((size_t)0)
+#endif
+
+// Counters are per thread, so concurrent runs do not mix their numbers
+static _Thread_local MemoryCounters counters[MEM_NUM_CATEGORIES];
+static _Thread_local long long totalCurrentBytes;
+static _Thread_local long long totalPeakBytes;
+// Bytes in use at the last reset; peaks are reported above them
+static _Thread_local long long baseBytes[MEM_NUM_CATEGORIES];
+static _Thread_local long long totalBaseBytes;
+
+#ifndef DISABLE_MEMORY_STATS
+
+static void countBytes(MemoryCategory category, long long size) {
+    MemoryCounters* c = &counters[category];
+
+    c->bytesAllocated += size;
+    c->allocations++;
+    c->currentBytes += size;
+    if (c->currentBytes > c->peakBytes) {
+        c->peakBytes = c->currentBytes;
+    }
+
+    totalCurrentBytes += size;
+    if (totalCurrentBytes > totalPeakBytes) {
+        totalPeakBytes = totalCurrentBytes;
+    }
+}
+
+static void countAllocation(MemoryCategory category, void* ptr) {
+    if (ptr != NULL) {
+        countBytes(category, (long long)usableSize(ptr));
+    }
+}
+
+static void countRelease(MemoryCategory category, void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    long long size = (long long)usableSize(ptr);
+    counters[category].currentBytes -= size;
+    totalCurrentBytes -= size;
+}
+
+/**
+ * @brief malloc that accounts the block in the given category.
+ */
+void* trackedMalloc(MemoryCategory category, size_t size) {
+    void* ptr = malloc(size);
+    countAllocation(category, ptr);
+    return ptr;
+}
+
+/**
+ * @brief calloc that accounts the block in the given category.
+ */
+void* trackedCalloc(MemoryCategory category, size_t count, size_t size) {
+    void* ptr = calloc(count, size);
+    countAllocation(category, ptr);
+    return ptr;
+}
+
+/**
+ * @brief realloc that accounts the block in the given category.
+ */
+void* trackedRealloc(MemoryCategory category, void* ptr, size_t size) {
+    long long oldSize = ptr != NULL ? (long long)usableSize(ptr) : 0;
+    void* newPtr = realloc(ptr, size);
+    if (newPtr == NULL) {
+        return NULL;
+    }
+    counters[category].currentBytes -= oldSize;
+    totalCurrentBytes -= oldSize;
+    countAllocation(category, newPtr);
+    return newPtr;
+}
+
+/**
+ * @brief free for blocks allocated with the tracked functions.
+ */
+void trackedFree(MemoryCategory category, void* ptr) {
+    countRelease(category, ptr);
+    free(ptr);
+}
+
+/**
+ * @brief Accounts memory that the tracked functions do not see, such as shared
+ * mappings or blocks grown by other threads, as one allocation of the calling
+ * thread. Release it with untrackMemory.
+ */
+void trackMemory(MemoryCategory category, size_t size) {
+    countBytes(category, (long long)size);
+}
+
+/**
+ * @brief Releases memory accounted with trackMemory.
+ */
+void untrackMemory(MemoryCategory category, size_t size) {
+    counters[category].currentBytes -= (long long)size;
+    totalCurrentBytes -= (long long)size;
+}
+
+#endif
+
+/**
+ * @brief Starts a new measurement window for the calling thread: allocation
+ * counts restart at zero and peaks are measured from the memory currently in
+ * use, so that they do not depend on what the thread allocated before (such as
+ * a graph loaded on the same thread).
+ */
+void resetMemoryStats(void) {
+    for (int i = 0; i < MEM_NUM_CATEGORIES; i++) {
+        counters[i].bytesAllocated = 0;
+        counters[i].allocations = 0;
+        counters[i].peakBytes = counters[i].currentBytes;
+        baseBytes[i] = counters[i].currentBytes;
+    }
+    totalPeakBytes = totalCurrentBytes;
+    totalBaseBytes = totalCurrentBytes;
+}
+
+/**
+ * @brief Returns the counters of the calling thread and the peak resident
+ * memory of the process. Peaks count only the bytes allocated on top of those
+ * in use at the last reset; currentBytes is the total in use.
+ */
+MemoryStats getMemoryStats(void) {
+    MemoryStats stats;
+    struct rusage usage;
+
+    for (int i = 0; i < MEM_NUM_CATEGORIES; i++) {
+        stats.categories[i] = counters[i];
+        stats.categories[i].peakBytes -= baseBytes[i];
+    }
+    stats.totalPeakBytes = totalPeakBytes - totalBaseBytes;
+
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    stats.maxResidentBytes = usage.ru_maxrss;           // bytes on macOS
+#else
+    stats.maxResidentBytes = usage.ru_maxrss * 1024LL;  // kilobytes on Linux
+#endif
+    return stats;
+}
+
+const char* memoryCategoryName(MemoryCategory category) {
+    switch (category) {
+        case MEM_GRAPH: return "graph";
+        case MEM_HEAP: return "heap";
+        case MEM_BUFFERS: return "buffers";
+        default: return "unknown";
+    }
+}
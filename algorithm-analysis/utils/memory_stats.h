@@ -0,0 +1,68 @@
+//
+//  memory_stats.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef memory_stats_h
+#define memory_stats_h
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief What an allocation is used for. Every category is accounted separately.
+ */
+typedef enum {
+    MEM_GRAPH,          // Graph structure and adjacency nodes
+    MEM_HEAP,           // Priority queues (MinHeap and heap nodes)
+    MEM_BUFFERS,        // dist, pred, newDist and other per-node arrays
+    MEM_NUM_CATEGORIES
+} MemoryCategory;
+
+/**
+ * @brief Counters of one category. Bytes are the sizes reserved by the allocator,
+ * which include its rounding and per-block overhead.
+ */
+typedef struct {
+    long long bytesAllocated;   // Bytes allocated since the last reset
+    long long allocations;      // Number of allocations since the last reset
+    long long currentBytes;     // Bytes currently allocated
+    long long peakBytes;        // Highest value of currentBytes since the last reset, minus its value at the reset
+} MemoryCounters;
+
+/**
+ * @brief Snapshot of the counters of the calling thread.
+ */
+typedef struct {
+    MemoryCounters categories[MEM_NUM_CATEGORIES];
+    long long totalPeakBytes;   // Highest sum of currentBytes over all categories, minus the sum at the reset
+    long long maxResidentBytes; // Peak resident set size of the process (getrusage)
+} MemoryStats;
+
+#ifndef DISABLE_MEMORY_STATS
+
+void* trackedMalloc(MemoryCategory category, size_t size);
+void* trackedCalloc(MemoryCategory category, size_t count, size_t size);
+void* trackedRealloc(MemoryCategory category, void* ptr, size_t size);
+void trackedFree(MemoryCategory category, void* ptr);
+void trackMemory(MemoryCategory category, size_t size);
+void untrackMemory(MemoryCategory category, size_t size);
+
+#else
+
+#define trackedMalloc(category, size) malloc(size)
+#define trackedCalloc(category, count, size) calloc(count, size)
+#define trackedRealloc(category, ptr, size) realloc(ptr, size)
+#define trackedFree(category, ptr) free(ptr)
+#define trackMemory(category, size) ((void)0)
+#define untrackMemory(category, size) ((void)0)
+
+#endif
+
+void resetMemoryStats(void);
+MemoryStats getMemoryStats(void);
+const char* memoryCategoryName(MemoryCategory category);
+
+#endif /* memory_stats_h */
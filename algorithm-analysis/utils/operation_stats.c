@@ -0,0 +1,177 @@
+//
+//  operation_stats.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "operation_stats.h"
+
+#include <stdlib.h>
+
+/**
+ * @brief One iteration of the trace: a settled node of Dijkstra, or a round
+ * of Bellman-Ford.
+ */
+typedef struct {
+    int frontier;       // Open nodes after the iteration (see END_ROUND and END_SETTLE)
+    int updates;        // Distances lowered during the iteration
+} TraceEntry;
+
+#ifdef OPERATION_COUNTERS
+
+// Counters are per thread, like the memory counters, so concurrent runs do not mix their numbers
+_Thread_local long long operationCounts[OP_NUM_COUNTERS];
+_Thread_local bool operationTraceActive;
+
+// The trace is kept in memory while the algorithm runs; malloc is not
+// tracked, so it does not show in the memory statistics of the run.
+static _Thread_local TraceEntry* trace;
+static _Thread_local long long traceLength;
+static _Thread_local long long traceCapacity;
+static _Thread_local long long improvementsAtLastTrace;
+static _Thread_local long long improvementsAtLastRound;
+
+/**
+ * @brief Counts a finished Bellman-Ford round, and remembers it as the last
+ * improving round if some distance was lowered since the previous one.
+ */
+void countRound(void) {
+    operationCounts[OP_ROUNDS]++;
+    if (operationCounts[OP_IMPROVEMENTS] != improvementsAtLastRound)
+        operationCounts[OP_LAST_IMPROVING_ROUND] = operationCounts[OP_ROUNDS];
+    improvementsAtLastRound = operationCounts[OP_IMPROVEMENTS];
+}
+
+/**
+ * @brief Appends an iteration to the trace, with the distances lowered since
+ * the previous one.
+ */
+void traceIteration(long long frontier) {
+    if (traceLength == traceCapacity) {
+        long long capacity = traceCapacity ? 2 * traceCapacity : 1024;
+        TraceEntry* entries = (TraceEntry*) realloc(trace, capacity * sizeof(TraceEntry));
+        if (entries == NULL) {
+            operationTraceActive = false;
+            return;
+        }
+        trace = entries;
+        traceCapacity = capacity;
+    }
+    trace[traceLength].frontier = (int)frontier;
+    trace[traceLength].updates = (int)(operationCounts[OP_IMPROVEMENTS] - improvementsAtLastTrace);
+    traceLength++;
+    improvementsAtLastTrace = operationCounts[OP_IMPROVEMENTS];
+}
+
+/**
+ * @brief Nodes reached and not settled yet, when a Dijkstra iteration ends.
+ * Every iteration settles one node, the source counts as reached, and the
+ * counters start with the trace.
+ */
+long long dijkstraFrontier(void) {
+    long long frontier = 1 + operationCounts[OP_NODES_REACHED] - (traceLength + 1);
+    return frontier > 0 ? frontier : 0;
+}
+
+#endif
+
+/**
+ * @brief Starts a new measurement window for the calling thread: every
+ * counter restarts at zero.
+ */
+void resetOperationStats(void) {
+#ifdef OPERATION_COUNTERS
+    for (int i = 0; i < OP_NUM_COUNTERS; i++) {
+        operationCounts[i] = 0;
+    }
+    improvementsAtLastTrace = 0;
+    improvementsAtLastRound = 0;
+#endif
+}
+
+/**
+ * @brief Returns the counters of the calling thread (all zero in builds
+ * without OPERATION_COUNTERS).
+ */
+OperationStats getOperationStats(void) {
+    OperationStats stats = { { 0 }, 0 };
+#ifdef OPERATION_COUNTERS
+    for (int i = 0; i < OP_NUM_COUNTERS; i++) {
+        stats.counts[i] = operationCounts[i];
+    }
+    stats.traceLength = traceLength;
+#endif
+    return stats;
+}
+
+const char* operationCounterName(OperationCounter counter) {
+    switch (counter) {
+        case OP_RELAXATIONS: return "relaxations";
+        case OP_IMPROVEMENTS: return "improvements";
+        case OP_NODES_REACHED: return "nodes_reached";
+        case OP_HEAP_INSERTS: return "heap_inserts";
+        case OP_EXTRACT_MINS: return "extract_mins";
+        case OP_DECREASE_KEYS: return "decrease_keys";
+        case OP_SIFT_STEPS: return "sift_steps";
+        case OP_ROUNDS: return "rounds";
+        case OP_LAST_IMPROVING_ROUND: return "last_improving_round";
+        case OP_MESSAGES: return "messages";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Starts recording one entry per iteration of the algorithms run by
+ * the calling thread. Call it after resetOperationStats, right before the run.
+ */
+void startOperationTrace(void) {
+#ifdef OPERATION_COUNTERS
+    traceLength = 0;
+    improvementsAtLastTrace = operationCounts[OP_IMPROVEMENTS];
+    operationTraceActive = true;
+#endif
+}
+
+/**
+ * @brief Stops the trace of the calling thread and writes it as CSV, one row
+ * per iteration (iteration, frontier, updates). The recorded entries are
+ * freed.
+ *
+ * @param path Output file.
+ * @return true if the trace was written, false if the file cannot be created
+ * or the build has no counters.
+ */
+bool saveOperationTrace(const char* path) {
+#ifdef OPERATION_COUNTERS
+    operationTraceActive = false;
+    FILE* fp = fopen(path, "w");
+    if (fp != NULL) {
+        fprintf(fp, "iteration,frontier,updates\n");
+        for (long long i = 0; i < traceLength; i++) {
+            fprintf(fp, "%lld,%d,%d\n", i + 1, trace[i].frontier, trace[i].updates);
+        }
+        fclose(fp);
+    }
+    free(trace);
+    trace = NULL;
+    traceLength = 0;
+    traceCapacity = 0;
+    return fp != NULL;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+/**
+ * @brief Number of nodes whose distance differs between two vectors: the
+ * frontier of a Bellman-Ford round computed from the previous distances.
+ */
+int countChangedDistances(const int* before, const int* after, int numNodes) {
+    int changed = 0;
+    for (int v = 0; v < numNodes; v++) {
+        changed += before[v] != after[v];
+    }
+    return changed;
+}
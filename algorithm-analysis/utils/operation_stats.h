@@ -0,0 +1,82 @@
+//
+//  operation_stats.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef operation_stats_h
+#define operation_stats_h
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <limits.h>
+
+/**
+ * @brief Operations counted by the instrumented algorithms.
+ */
+typedef enum {
+    OP_RELAXATIONS,     // Arcs examined
+    OP_IMPROVEMENTS,    // Relaxations that lowered a distance
+    OP_NODES_REACHED,   // Improvements of an infinite distance
+    OP_HEAP_INSERTS,
+    OP_EXTRACT_MINS,    // Includes the outdated entries of lazy queues and the linear scans of Dijkstra (v1)
+    OP_DECREASE_KEYS,
+    OP_SIFT_STEPS,      // Levels moved by sift-down (minHeapify) and sift-up
+    OP_ROUNDS,          // Bellman-Ford rounds, or passes over the FIFO queue
+    OP_LAST_IMPROVING_ROUND,  // Last round that lowered a distance: the rounds until convergence
+    OP_MESSAGES,        // Relaxations sent to another shard (sharded Bellman-Ford)
+    OP_NUM_COUNTERS
+} OperationCounter;
+
+/**
+ * @brief Snapshot of the counters of the calling thread.
+ */
+typedef struct {
+    long long counts[OP_NUM_COUNTERS];
+    long long traceLength;      // Iterations recorded since startOperationTrace
+} OperationStats;
+
+// The counters cost a few instructions in the innermost loops, so they are
+// only compiled in builds with -DOPERATION_COUNTERS (the Debug configuration
+// of the Xcode project). Elsewhere the macros expand to nothing.
+#ifdef OPERATION_COUNTERS
+
+#define OPERATION_COUNTERS_ENABLED 1
+
+extern _Thread_local long long operationCounts[OP_NUM_COUNTERS];
+extern _Thread_local bool operationTraceActive;
+
+void countRound(void);
+void traceIteration(long long frontier);
+long long dijkstraFrontier(void);
+
+#define COUNT_OPERATION(counter) (operationCounts[counter]++)
+#define COUNT_OPERATIONS(counter, n) (operationCounts[counter] += (n))
+#define COUNT_IMPROVEMENT(oldDistance) \
+    (operationCounts[OP_IMPROVEMENTS]++, operationCounts[OP_NODES_REACHED] += (oldDistance) == INT_MAX)
+// Ends a Bellman-Ford round; frontier is only evaluated while a trace is recorded
+#define END_ROUND(frontier) (countRound(), operationTraceActive ? traceIteration(frontier) : (void)0)
+// Ends a Dijkstra iteration (one settled node); the frontier is the reached, unsettled nodes
+#define END_SETTLE() (operationTraceActive ? traceIteration(dijkstraFrontier()) : (void)0)
+
+#else
+
+#define OPERATION_COUNTERS_ENABLED 0
+
+#define COUNT_OPERATION(counter) ((void)0)
+#define COUNT_OPERATIONS(counter, n) ((void)0)
+#define COUNT_IMPROVEMENT(oldDistance) ((void)0)
+#define END_ROUND(frontier) ((void)0)
+#define END_SETTLE() ((void)0)
+
+#endif
+
+void resetOperationStats(void);
+OperationStats getOperationStats(void);
+const char* operationCounterName(OperationCounter counter);
+void startOperationTrace(void);
+bool saveOperationTrace(const char* path);
+int countChangedDistances(const int* before, const int* after, int numNodes);
+
+#endif /* operation_stats_h */
@@ -0,0 +1,216 @@
+//
+//  statistics.c
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#include "statistics.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * @brief Value of a sample, with the sample it comes from, for ranking.
+ */
+typedef struct {
+    double value;
+    int first;              // 1 if it comes from the first sample
+} RankedValue;
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+static int compareRanked(const void *a, const void *b) {
+    return compareDoubles(&((const RankedValue *) a)->value, &((const RankedValue *) b)->value);
+}
+
+/**
+ * @brief Returns the median of a sample (0 if it is empty).
+ */
+double median(const double *values, int count) {
+    if (count <= 0)
+        return 0;
+
+    double *sorted = (double *) malloc(count * sizeof(double));
+    memcpy(sorted, values, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), compareDoubles);
+    double result = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+    free(sorted);
+    return result;
+}
+
+/**
+ * @brief Probability that U <= u under the null hypothesis, from the exact
+ * distribution of U: with f(u; m, n) the number of orderings of m + n values
+ * with statistic u, f(u; m, n) = f(u - n; m - 1, n) + f(u; m, n - 1).
+ */
+static double exactLowerTail(int n1, int n2, int u) {
+    int maxU = n1 * n2;
+    // counts[m][n][k], flattened
+    double *counts = (double *) calloc((size_t)(n1 + 1) * (n2 + 1) * (maxU + 1), sizeof(double));
+    #define COUNT(m, n, k) counts[((size_t)(m) * (n2 + 1) + (n)) * (maxU + 1) + (k)]
+
+    for (int m = 0; m <= n1; m++) {
+        for (int n = 0; n <= n2; n++) {
+            if (m == 0 || n == 0) {
+                COUNT(m, n, 0) = 1;
+                continue;
+            }
+            for (int k = 0; k <= m * n; k++) {
+                COUNT(m, n, k) = (k >= n ? COUNT(m - 1, n, k - n) : 0) + COUNT(m, n - 1, k);
+            }
+        }
+    }
+
+    double below = 0, total = 0;
+    for (int k = 0; k <= maxU; k++) {
+        total += COUNT(n1, n2, k);
+        if (k <= u)
+            below += COUNT(n1, n2, k);
+    }
+    #undef COUNT
+    free(counts);
+    return below / total;
+}
+
+/**
+ * @brief Two-sided Mann-Whitney U test: the probability of a difference in
+ * ranks at least as large as the observed one if both samples come from the
+ * same distribution. It only compares ranks, so a few outlier timings do not
+ * dominate it. Without ties and with both samples of at most
+ * MANN_WHITNEY_EXACT_LIMIT values the exact distribution is used; otherwise
+ * the normal approximation with tie and continuity corrections.
+ *
+ * @param a First sample.
+ * @param n1 Size of the first sample.
+ * @param b Second sample.
+ * @param n2 Size of the second sample.
+ * @return The p-value (1 if a sample is empty).
+ */
+double mannWhitneyPValue(const double *a, int n1, const double *b, int n2) {
+    if (n1 < 1 || n2 < 1)
+        return 1;
+
+    int total = n1 + n2;
+    RankedValue *values = (RankedValue *) malloc(total * sizeof(RankedValue));
+    for (int i = 0; i < n1; i++) {
+        values[i] = (RankedValue) { a[i], 1 };
+    }
+    for (int i = 0; i < n2; i++) {
+        values[n1 + i] = (RankedValue) { b[i], 0 };
+    }
+    qsort(values, total, sizeof(RankedValue), compareRanked);
+
+    // Sum of the ranks of the first sample, with tied values sharing their average rank
+    double rankSum = 0, tieTerm = 0;
+    for (int i = 0; i < total;) {
+        int j = i;
+        while (j < total && values[j].value == values[i].value) {
+            j++;
+        }
+        double rank = (i + 1 + j) / 2.0;
+        for (int k = i; k < j; k++) {
+            rankSum += values[k].first ? rank : 0;
+        }
+        double ties = j - i;
+        tieTerm += ties * ties * ties - ties;
+        i = j;
+    }
+    free(values);
+
+    double u = rankSum - n1 * (n1 + 1) / 2.0;
+    double mean = n1 * (double)n2 / 2.0;
+    double p;
+
+    if (tieTerm == 0 && n1 <= MANN_WHITNEY_EXACT_LIMIT && n2 <= MANN_WHITNEY_EXACT_LIMIT) {
+        // U is symmetric around its mean, so the smaller tail is the one of min(U, n1 n2 - U)
+        int smaller = (int)fmin(u, n1 * n2 - u);
+        p = 2 * exactLowerTail(n1, n2, smaller);
+    } else {
+        double variance = n1 * (double)n2 / 12.0 * ((total + 1) - tieTerm / (total * (double)(total - 1)));
+        if (variance <= 0)
+            return 1;
+        double z = (fabs(u - mean) - 0.5) / sqrt(variance);
+        p = z <= 0 ? 1 : erfc(z / sqrt(2.0));
+    }
+    return p > 1 ? 1 : p;
+}
+
+/**
+ * @brief Empties a latency histogram.
+ */
+void initLatencyHistogram(LatencyHistogram *histogram) {
+    memset(histogram, 0, sizeof(LatencyHistogram));
+}
+
+static int latencyBucket(unsigned long long nanos) {
+    if (nanos < LATENCY_SUB_BUCKETS)
+        return (int)nanos;
+    int shift = 63 - __builtin_clzll(nanos) - LATENCY_SUB_BITS;
+    return (shift + 1) * LATENCY_SUB_BUCKETS + (int)((nanos >> shift) - LATENCY_SUB_BUCKETS);
+}
+
+/**
+ * @brief Returns the largest latency that falls in a bucket.
+ */
+static unsigned long long latencyBucketLimit(int bucket) {
+    if (bucket < LATENCY_SUB_BUCKETS)
+        return (unsigned long long)bucket;
+    int shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    unsigned long long low = (unsigned long long)(LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS) << shift;
+    return low + ((1ULL << shift) - 1);
+}
+
+/**
+ * @brief Adds one latency to a histogram.
+ */
+void recordLatency(LatencyHistogram *histogram, unsigned long long nanos) {
+    histogram->count++;
+    histogram->totalNanos += nanos;
+    if (nanos > histogram->maxNanos)
+        histogram->maxNanos = nanos;
+    histogram->buckets[latencyBucket(nanos)]++;
+}
+
+/**
+ * @brief Adds every latency of one histogram to another.
+ */
+void mergeLatency(LatencyHistogram *into, const LatencyHistogram *from) {
+    into->count += from->count;
+    into->totalNanos += from->totalNanos;
+    if (from->maxNanos > into->maxNanos)
+        into->maxNanos = from->maxNanos;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        into->buckets[b] += from->buckets[b];
+    }
+}
+
+/**
+ * @brief Returns an upper bound of a latency percentile, within the width of
+ * its bucket.
+ *
+ * @param histogram The histogram.
+ * @param fraction Percentile as a fraction, e.g. 0.99.
+ * @return The latency in nanoseconds (0 if the histogram is empty).
+ */
+unsigned long long latencyPercentile(const LatencyHistogram *histogram, double fraction) {
+    if (histogram->count == 0)
+        return 0;
+
+    unsigned long long rank = (unsigned long long)ceil(fraction * histogram->count);
+    if (rank < 1)
+        rank = 1;
+    unsigned long long seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += histogram->buckets[b];
+        if (seen >= rank) {
+            unsigned long long limit = latencyBucketLimit(b);
+            return limit < histogram->maxNanos ? limit : histogram->maxNanos;
+        }
+    }
+    return histogram->maxNanos;
+}
@@ -0,0 +1,42 @@
+//
+//  statistics.h
+//  algorithm-analysis
+//
+//  Created by Erika Matesz Bueno on 19/10/26.
+//
+
+#ifndef statistics_h
+#define statistics_h
+
+#include <stdio.h>
+
+// Largest sample size for which the exact distribution of the Mann-Whitney U
+// statistic is used; larger samples use the normal approximation
+#define MANN_WHITNEY_EXACT_LIMIT 20
+
+// Latency histograms split every power of two of nanoseconds into
+// LATENCY_SUB_BUCKETS linear buckets, so percentiles are within 1/8 (12.5%)
+#define LATENCY_SUB_BITS 3
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS (64 * LATENCY_SUB_BUCKETS)
+
+/**
+ * @brief Log-linear histogram of latencies in nanoseconds. Recording is
+ * constant time and constant memory, so it can run on every request.
+ */
+typedef struct {
+    unsigned long long count;
+    unsigned long long totalNanos;
+    unsigned long long maxNanos;
+    unsigned long long buckets[LATENCY_BUCKETS];
+} LatencyHistogram;
+
+double median(const double *values, int count);
+double mannWhitneyPValue(const double *a, int n1, const double *b, int n2);
+
+void initLatencyHistogram(LatencyHistogram *histogram);
+void recordLatency(LatencyHistogram *histogram, unsigned long long nanos);
+void mergeLatency(LatencyHistogram *into, const LatencyHistogram *from);
+unsigned long long latencyPercentile(const LatencyHistogram *histogram, double fraction);
+
+#endif /* statistics_h */
@@ -12,9 +12,25 @@
 #include <string.h>
 #include <dirent.h>
 #include <math.h>
+#include <time.h>
+#include <sys/stat.h>
 
 #include "constants.h"
 
+/**
+ * @brief Checks whether a file name has one of the supported instance extensions.
+ *
+ * @param name The file name.
+ * @return 1 for .dat, .stp and .bin files, 0 otherwise.
+ */
+int isInstanceFile(const char *name) {
+    const char *dot = strrchr(name, '.');
+    if (dot == NULL) {
+        return 0;
+    }
+    return strcmp(dot, ".dat") == 0 || strcmp(dot, ".stp") == 0 || strcmp(dot, BINARY_GRAPH_EXTENSION) == 0;
+}
+
 /**
  * @brief Selects a file from the given directory path.
  *
@@ -33,7 +49,7 @@ char* selectFileFromFileList(const char *path) {
 
     if ((dir = opendir(path)) != NULL) {
         while ((directory_entry = readdir(dir)) != NULL) {
-            if (strstr(directory_entry->d_name, ".dat") != NULL || strstr(directory_entry->d_name, ".stp") != NULL) {
+            if (isInstanceFile(directory_entry->d_name)) {
                 printf("%d. %s\n", fileNumber, directory_entry->d_name);
                 fileNumber++;
             }
@@ -48,7 +64,7 @@ char* selectFileFromFileList(const char *path) {
         fileNumber = 1;
 
         while ((directory_entry = readdir(dir)) != NULL) {
-            if (strstr(directory_entry->d_name, ".dat") != NULL || strstr(directory_entry->d_name, ".stp") != NULL) {
+            if (isInstanceFile(directory_entry->d_name)) {
                 if (fileNumber == choice) {
                     char* filePath = malloc(strlen(path) + strlen(directory_entry->d_name) + 2);
                     sprintf(filePath, "%s/%s", path, directory_entry->d_name);
@@ -71,7 +87,7 @@ char* selectFileFromFileList(const char *path) {
 /**
  * @brief Allows the user to choose a subdirectory and select a file from it.
  *
- * Displays a menu with options to choose a subdirectory containing files with .dat or .stp extensions.
+ * Displays a menu with options to choose a subdirectory containing files with .dat, .stp or .bin extensions.
  *
  * @return A dynamically allocated string representing the selected file's path.
  *         Returns NULL if an error occurs or if the user's choice is invalid.
@@ -80,12 +96,13 @@ char* chooseFile(void) {
     int option;
     const char *dirPath;
     
-    printf("There are 5 subdirectories with .dat or .stp files. Choose one of the subdirectories:\n");
+    printf("There are 6 subdirectories with .dat, .stp or .bin files. Choose one of the subdirectories:\n");
     printf("1. TEST_SET1\n");
     printf("2. TEST_SET2\n");
     printf("3. ALUE\n");
     printf("4. ALUT\n");
     printf("5. DMXA\n");
+    printf("6. SYNTHETIC\n");
     printf("Option: ");
     scanf("%d", &option);
 
@@ -105,6 +122,9 @@ char* chooseFile(void) {
         case 5:
             dirPath = DIR_PATH DMXA;
             break;
+        case 6:
+            dirPath = DIR_PATH SYNTHETIC;
+            break;
         default:
             printf("Invalid option!\n");
             return NULL;
@@ -147,8 +167,9 @@ void process_dat_file(FILE *input_file, FILE *output_file) {
 }
 
 /**
- * Processes a .stp file, reads the number of nodes, the number of edges, and the list of edges,
- * and writes the results to an output file.
+ * Processes a .stp file, reads the number of nodes, the number of edges, the list of edges
+ * and the terminals (if the file has a Terminals section), and writes the results to an
+ * output file.
  *
  * @param input_file Pointer to the input file (.stp) opened for reading.
  * @param output_file Pointer to the output file where the results will be written.
@@ -157,13 +178,14 @@ void process_stp_file(FILE *input_file, FILE *output_file) {
     char line[MAX_LINE_LENGTH];
     int nodes = 0;
     int edges = 0;
+    int edgesWritten = 0;
 
     while (fgets(line, sizeof(line), input_file)) {
         if (strncmp(line, "Nodes", 5) == 0) {
             sscanf(line, "Nodes %d", &nodes);
         } else if (strncmp(line, "Edges", 5) == 0) {
             sscanf(line, "Edges %d", &edges);
-        } else if (strncmp(line, "E ", 2) == 0) {
+        } else if (strncmp(line, "E ", 2) == 0 && !edgesWritten) {
             if (nodes != 0 && edges != 0) {
                 fprintf(output_file, "NODES %d\n", nodes);
                 fprintf(output_file, "EDGES %d\n", edges);
@@ -174,8 +196,19 @@ void process_stp_file(FILE *input_file, FILE *output_file) {
                     fprintf(output_file, "%d %d %d\n", v1 - 1, v2 - 1, cost);
                     fprintf(output_file, "%d %d %d\n", v2 - 1, v1 - 1, cost);
                 } while (fgets(line, sizeof(line), input_file) && strncmp(line, "End", 3) != 0);
-                break;
+                edgesWritten = 1;
             }
+        } else if (strncmp(line, "Terminals ", 10) == 0 && edgesWritten) {
+            int terminals = 0;
+            sscanf(line, "Terminals %d", &terminals);
+            fprintf(output_file, "TERMINALS %d\n", terminals);
+            while (fgets(line, sizeof(line), input_file) && strncmp(line, "End", 3) != 0) {
+                int t;
+                if (sscanf(line, "T %d", &t) == 1) {
+                    fprintf(output_file, "%d\n", t - 1);
+                }
+            }
+            break;
         }
     }
 }
@@ -241,6 +274,210 @@ char* process_file(const char *input_filename) {
     return output_filename;
 }
 
+/**
+ * @brief Compares two strings through pointers, for qsort.
+ */
+static int compareStrings(const void *a, const void *b) {
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/**
+ * @brief Lists the instance files (.dat, .stp or .bin) found at a path.
+ *
+ * If the path is a regular file, it is returned as the only element. If it is a
+ * directory, all the instance files inside it are returned in alphabetical order,
+ * so that runs are reproducible.
+ *
+ * @param path Path of a file or directory.
+ * @param count Output parameter with the number of files found.
+ * @return A dynamically allocated array of dynamically allocated paths, or NULL
+ *         if the path cannot be read.
+ */
+char** listInstanceFiles(const char *path, int *count) {
+    struct stat path_stat;
+    *count = 0;
+
+    if (stat(path, &path_stat) != 0) {
+        perror(path);
+        return NULL;
+    }
+
+    if (!S_ISDIR(path_stat.st_mode)) {
+        char **files = malloc(sizeof(char*));
+        files[0] = strdup(path);
+        *count = 1;
+        return files;
+    }
+
+    DIR *dir = opendir(path);
+    if (dir == NULL) {
+        perror(ERROR_MSG_DIRECTORY);
+        return NULL;
+    }
+
+    int capacity = 16;
+    char **files = malloc(capacity * sizeof(char*));
+    const char *separator = (path[0] != '\0' && path[strlen(path) - 1] == '/') ? "" : "/";
+    struct dirent *directory_entry;
+
+    while ((directory_entry = readdir(dir)) != NULL) {
+        if (!isInstanceFile(directory_entry->d_name)) {
+            continue;
+        }
+        if (*count == capacity) {
+            capacity *= 2;
+            files = realloc(files, capacity * sizeof(char*));
+        }
+        char *filePath = malloc(strlen(path) + strlen(directory_entry->d_name) + 2);
+        sprintf(filePath, "%s%s%s", path, separator, directory_entry->d_name);
+        files[(*count)++] = filePath;
+    }
+    closedir(dir);
+
+    qsort(files, *count, sizeof(char*), compareStrings);
+    return files;
+}
+
+/**
+ * Stores a 32-bit integer in little-endian byte order, the order of the binary
+ * graph files on every machine.
+ *
+ * @param bytes Buffer of 4 bytes that receives the value.
+ * @param value The value to store.
+ */
+void encodeInt32(unsigned char *bytes, int value) {
+    unsigned int bits = (unsigned int)value;
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (unsigned char)(bits >> (8 * i));
+    }
+}
+
+/**
+ * Reads a 32-bit integer stored by encodeInt32.
+ *
+ * @param bytes Buffer of 4 bytes.
+ * @return The stored value.
+ */
+int decodeInt32(const unsigned char *bytes) {
+    unsigned int bits = 0;
+    for (int i = 0; i < 4; i++) {
+        bits |= (unsigned int)bytes[i] << (8 * i);
+    }
+    return (int)bits;
+}
+
+/**
+ * Reads a graph stored in the binary format written by the generator: the magic
+ * string, the number of nodes and arcs and then one (source, destination,
+ * weight) triple per arc, all 32-bit little-endian integers.
+ *
+ * @param filename Path of the binary file.
+ * @return A pointer to the loaded graph, or NULL if the file cannot be read, is
+ * truncated or has an arc endpoint outside [0, number of nodes).
+ */
+Graph* readBinaryGraph(const char *filename) {
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL) {
+        perror(ERROR_MSG_INPUT_FILE);
+        return NULL;
+    }
+
+    char magic[sizeof(BINARY_GRAPH_MAGIC) - 1];
+    unsigned char bytes[12];
+    int numNodes = -1, numArcs = -1;
+    if (fread(magic, 1, sizeof(magic), fp) == sizeof(magic) &&
+        memcmp(magic, BINARY_GRAPH_MAGIC, sizeof(magic)) == 0 &&
+        fread(bytes, 1, 8, fp) == 8) {
+        numNodes = decodeInt32(bytes);
+        numArcs = decodeInt32(bytes + 4);
+    }
+    if (numNodes < 0 || numArcs < 0) {
+        fprintf(stderr, "Invalid binary graph file: %s\n", filename);
+        fclose(fp);
+        return NULL;
+    }
+
+    Graph* graph = createGraph(numNodes);
+    int numRead = 0;
+    while (numRead < numArcs && fread(bytes, 1, 12, fp) == 12) {
+        int u = decodeInt32(bytes), v = decodeInt32(bytes + 4);
+        // An endpoint outside the graph would index past its adjacency lists
+        if (u < 0 || u >= numNodes || v < 0 || v >= numNodes)
+            break;
+        addEdge(graph, u, v, decodeInt32(bytes + 8));
+        numRead++;
+    }
+
+    fclose(fp);
+    if (numRead < numArcs) {
+        fprintf(stderr, "Invalid binary graph file: %s\n", filename);
+        freeGraph(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+/**
+ * Loads a graph from an instance file. Text instances (.dat and .stp) go through
+ * the .temp edge list written by process_file; binary instances are read directly.
+ *
+ * @param filename Path of the instance file.
+ * @return A pointer to the loaded graph, or NULL if the file cannot be read.
+ */
+Graph* loadGraph(const char *filename) {
+    const char *dot = strrchr(filename, '.');
+    if (dot != NULL && strcmp(dot, BINARY_GRAPH_EXTENSION) == 0) {
+        return readBinaryGraph(filename);
+    }
+
+    char *temp_file = process_file(filename);
+    FILE *fp = fopen(temp_file, "r");
+    if (fp == NULL) {
+        perror("Failed to open the temp file");
+        free(temp_file);
+        return NULL;
+    }
+
+    int numNodes = 0, numEdges = 0;
+    fscanf(fp, "NODES %d\n", &numNodes);
+    fscanf(fp, "EDGES %d\n", &numEdges);
+    fscanf(fp, "EDGE_LIST\n");
+
+    Graph* graph = createGraph(numNodes);
+
+    int src, dest, weight;
+    while (fscanf(fp, "%d %d %d\n", &src, &dest, &weight) == 3) {
+        addEdge(graph, src, dest, weight);
+    }
+
+    // Terminals, written after the edges for .stp instances that define them
+    int numTerminals = 0;
+    if (fscanf(fp, "TERMINALS %d\n", &numTerminals) == 1 && numTerminals > 0) {
+        int *terminals = malloc(numTerminals * sizeof(int));
+        int count = 0;
+        while (count < numTerminals && fscanf(fp, "%d\n", &terminals[count]) == 1) {
+            count++;
+        }
+        setTerminals(graph, terminals, count);
+        free(terminals);
+    }
+
+    fclose(fp);
+    free(temp_file);
+    return graph;
+}
+
+/**
+ * @brief Returns a monotonic wall-clock time stamp.
+ *
+ * @return Time in seconds from an arbitrary starting point.
+ */
+double wallTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
 /**
  * @brief Calculate the theoretical complexity of Bellman-Ford algorithm.
  *
@@ -249,7 +486,7 @@ char* process_file(const char *input_filename) {
  * @return Double representing the theoretical complexity O(n * m).
  */
 double calculateBellmanFordComplexity(int n, int m) {
-    return n * m;
+    return (double)n * m;
 }
 
 /**
@@ -259,7 +496,7 @@ double calculateBellmanFordComplexity(int n, int m) {
  * @return Double representing the theoretical complexity O(n^2).
  */
 double calculateDijkstraV1Complexity(int n) {
-    return n * n;
+    return (double)n * n;
 }
 
 /**
@@ -9,9 +9,17 @@
 #define utils_h
 
 #include <stdio.h>
+#include "graph.h"
 
 char* chooseFile(void);
 char* process_file(const char *input_filename);
+int isInstanceFile(const char *name);
+char** listInstanceFiles(const char *path, int *count);
+void encodeInt32(unsigned char *bytes, int value);
+int decodeInt32(const unsigned char *bytes);
+Graph* readBinaryGraph(const char *filename);
+Graph* loadGraph(const char *filename);
+double wallTime(void);
 double calculateBellmanFordComplexity(int n, int m);
 double calculateDijkstraV1Complexity(int n);
 double calculateDijkstraV2Complexity(int n, int m);